@@ -4,5 +4,7 @@
 /* //////////////////////////////////////////////////////////////////////////////////////
  * includes
  */
+#include <stdio.h>
+#include <jpeglib.h>
 
 #endif
@@ -0,0 +1,89 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */ 
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tb_bool_t gb_demo_core_bitmap_clear_check(tb_size_t pixfmt, tb_size_t width, tb_size_t height, gb_color_t color)
+{
+    // the pixmap
+    gb_pixmap_ref_t pixmap = gb_pixmap(pixfmt, 0xff);
+    tb_assert_and_check_return_val(pixmap, tb_false);
+
+    // done
+    tb_bool_t       ok = tb_false;
+    gb_bitmap_ref_t bitmap = tb_null;
+    gb_canvas_ref_t canvas = tb_null;
+    do
+    {
+        // init bitmap, the rows of the owned pixels may be padded
+        bitmap = gb_bitmap_init(tb_null, pixfmt, width, height, 0, tb_false);
+        tb_assert_and_check_break(bitmap);
+
+        // init canvas
+        canvas = gb_canvas_init_from_bitmap(bitmap);
+        tb_assert_and_check_break(canvas);
+
+        // clear it
+        gb_canvas_draw_clear(canvas, color);
+
+        // all pixels must be same as the first pixel
+        tb_byte_t const*    data = (tb_byte_t const*)gb_bitmap_data(bitmap);
+        tb_size_t           row_bytes = gb_bitmap_row_bytes(bitmap);
+        tb_size_t           x;
+        tb_size_t           y;
+        for (y = 0; y < height; y++)
+        {
+            for (x = 0; x < width; x++)
+            {
+                if (tb_memcmp(data + y * row_bytes + x * pixmap->btp, data, pixmap->btp)) break;
+            }
+            if (x < width) break;
+        }
+
+        // the first pixel must be the exact pixel of the color, the clear never blends it
+        gb_pixel_t pixel = pixmap->pixel_get(data);
+
+        // ok?
+        ok = (y == height && pixel == pixmap->pixel(color));
+
+        // trace
+        tb_trace_i("pixfmt: %s, size: %lux%lu, row_bytes: %lu, pixel: %#x, clear: %s", pixmap->name, width, height, row_bytes, pixel, ok? "ok" : "failed");
+
+    } while (0);
+
+    // exit canvas
+    if (canvas) gb_canvas_exit(canvas);
+    canvas = tb_null;
+
+    // exit bitmap
+    if (bitmap) gb_bitmap_exit(bitmap);
+    bitmap = tb_null;
+
+    // ok?
+    return ok;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t gb_demo_core_bitmap_clear_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the pixfmts with the padded rows, the 24-bits rows are not padded by the whole pixels
+    tb_size_t pixfmts[] = {GB_PIXFMT_RGB888, GB_PIXFMT_RGB565, GB_PIXFMT_XRGB8888, GB_PIXFMT_ARGB8888};
+
+    // done
+    tb_size_t i = 0;
+    tb_size_t failed = 0;
+    for (i = 0; i < tb_arrayn(pixfmts); i++)
+    {
+        if (!gb_demo_core_bitmap_clear_check(pixfmts[i], 10, 4, GB_COLOR_RED)) failed++;
+        if (!gb_demo_core_bitmap_clear_check(pixfmts[i], 33, 7, GB_COLOR_RED)) failed++;
+        if (!gb_demo_core_bitmap_clear_check(pixfmts[i], 33, 7, GB_COLOR_WHITE)) failed++;
+    }
+
+    // ok?
+    return failed? -1 : 0;
+}
@@ -0,0 +1,118 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the guard rows above and below the bitmap
+#define GB_DEMO_CANVAS_ROTATE_GUARD     (2)
+
+// the guard byte
+#define GB_DEMO_CANVAS_ROTATE_MAGIC     (0x5a)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tb_bool_t gb_demo_core_canvas_rotate_check(tb_size_t size, tb_size_t degrees, tb_size_t quality)
+{
+    // done
+    tb_bool_t       ok = tb_false;
+    tb_byte_t*      data = tb_null;
+    gb_bitmap_ref_t bitmap = tb_null;
+    gb_canvas_ref_t canvas = tb_null;
+    do
+    {
+        // make the pixels with the guard rows
+        tb_size_t row_bytes = size << 2;
+        tb_size_t guard     = GB_DEMO_CANVAS_ROTATE_GUARD * row_bytes;
+        tb_size_t data_size = size * row_bytes + (guard << 1);
+        data = tb_malloc_bytes(data_size);
+        tb_assert_and_check_break(data);
+        tb_memset(data, GB_DEMO_CANVAS_ROTATE_MAGIC, data_size);
+
+        // init bitmap with the pixels between the guard rows
+        bitmap = gb_bitmap_init(data + guard, GB_PIXFMT_XRGB8888, size, size, row_bytes, tb_false);
+        tb_assert_and_check_break(bitmap);
+
+        // init canvas
+        canvas = gb_canvas_init_from_bitmap(bitmap);
+        tb_assert_and_check_break(canvas);
+
+        // draw the whole bitmap rect rotated about the center, the edges only graze the border of the bitmap
+        gb_quality_set(quality);
+        gb_canvas_draw_clear(canvas, GB_COLOR_BLACK);
+        gb_canvas_color_set(canvas, GB_COLOR_RED);
+        gb_canvas_rotatep(canvas, gb_long_to_float(degrees), gb_long_to_float(size) / 2, gb_long_to_float(size) / 2);
+        gb_canvas_draw_rect2i(canvas, 0, 0, size, size);
+
+        // the guard rows must not be touched
+        tb_size_t i = 0;
+        tb_byte_t const* tail = data + guard + size * row_bytes;
+        for (i = 0; i < guard; i++)
+        {
+            if (data[i] != GB_DEMO_CANVAS_ROTATE_MAGIC || tail[i] != GB_DEMO_CANVAS_ROTATE_MAGIC) break;
+        }
+
+        // the center pixel must be filled
+        gb_pixmap_ref_t pixmap = gb_pixmap(GB_PIXFMT_XRGB8888, 0xff);
+        tb_assert_and_check_break(pixmap);
+        gb_color_t color = pixmap->color_get(data + guard + (size >> 1) * row_bytes + ((size >> 1) << 2));
+
+        // ok?
+        ok = (i == guard && color.r > 0xf0 && color.g < 0x10 && color.b < 0x10);
+
+        // trace
+        if (!ok) tb_trace_i("size: %lu, degrees: %lu, quality: %lu, guard: %s, center: %s", size, degrees, quality, i == guard? "ok" : "overwritten", color.r > 0xf0? "ok" : "empty");
+
+    } while (0);
+
+    // exit canvas
+    if (canvas) gb_canvas_exit(canvas);
+    canvas = tb_null;
+
+    // exit bitmap
+    if (bitmap) gb_bitmap_exit(bitmap);
+    bitmap = tb_null;
+
+    // exit data
+    if (data) tb_free(data);
+    data = tb_null;
+
+    // ok?
+    return ok;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t gb_demo_core_canvas_rotate_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the quality
+    tb_size_t quality = gb_quality();
+
+    // done
+    tb_size_t size = 0;
+    tb_size_t degrees = 0;
+    tb_size_t failed = 0;
+    for (size = 40; size <= 41; size++)
+    {
+        for (degrees = 0; degrees < 360; degrees += 15)
+        {
+            // the anti-aliased and aliased fill
+            if (!gb_demo_core_canvas_rotate_check(size, degrees, GB_QUALITY_TOP)) failed++;
+            if (!gb_demo_core_canvas_rotate_check(size, degrees, GB_QUALITY_LOW)) failed++;
+        }
+    }
+
+    // restore the quality
+    gb_quality_set(quality);
+
+    // trace
+    tb_trace_i("rotated rects: %s", failed? "failed" : "ok");
+
+    // ok?
+    return failed? -1 : 0;
+}
@@ -0,0 +1,97 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */ 
+#include "../demo.h"
+#include "../../../gbox/core/impl/polygon_raster.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tb_void_t gb_demo_core_polygon_raster_func(tb_long_t lx, tb_long_t rx, tb_long_t yb, tb_long_t ye, tb_cpointer_t priv)
+{
+    // check
+    tb_size_t* pspans = (tb_size_t*)priv;
+    tb_assert(pspans);
+
+    // update the spans count
+    (*pspans)++;
+}
+static gb_point_ref_t gb_demo_core_polygon_raster_make_gear(tb_size_t count)
+{
+    // make points
+    gb_point_ref_t points = tb_nalloc_type(count + 1, gb_point_t);
+    tb_assert_and_check_return_val(points, tb_null);
+
+    // make a gear with the small teeth, only a few edges will be active at each scan line
+    tb_size_t i = 0;
+    for (i = 0; i < count; i++)
+    {
+        tb_float_t angle    = (tb_float_t)(2 * TB_PI * i / count);
+        tb_float_t radius   = (i & 1)? 399.0f : 400.0f;
+        gb_point_make(&points[i], tb_float_to_gb(512.0f + radius * tb_cosf(angle)), tb_float_to_gb(512.0f + radius * tb_sinf(angle)));
+    }
+
+    // close it
+    points[count] = points[0];
+
+    // ok
+    return points;
+}
+static tb_void_t gb_demo_core_polygon_raster_bench(gb_polygon_raster_ref_t raster, tb_size_t count, tb_size_t loop)
+{
+    // make points
+    gb_point_ref_t points = gb_demo_core_polygon_raster_make_gear(count);
+    tb_assert_and_check_return(points);
+
+    // init polygon
+    tb_uint32_t     counts[] = {count + 1, 0};
+    gb_polygon_t    polygon = {points, counts, tb_false};
+    gb_rect_t       bounds;
+    gb_rect_imake(&bounds, 112, 112, 800, 800);
+
+    // done
+    tb_size_t layout = GB_POLYGON_RASTER_LAYOUT_AUTO;
+    for (layout = GB_POLYGON_RASTER_LAYOUT_AUTO; layout <= GB_POLYGON_RASTER_LAYOUT_LARGE; layout++)
+    {
+        // set layout
+        gb_polygon_raster_layout_set(raster, layout);
+
+        // done raster
+        tb_size_t   spans = 0;
+        tb_size_t   n = loop;
+        tb_hong_t   dt = tb_mclock();
+        while (n--) gb_polygon_raster_done(raster, &polygon, &bounds, GB_POLYGON_RASTER_RULE_NONZERO, gb_demo_core_polygon_raster_func, &spans);
+        dt = tb_mclock() - dt;
+
+        // trace
+        tb_trace_i("edges: %lu, layout: %s, loop: %lu, spans: %lu, time: %lld ms"
+                   , count
+                   , (layout == GB_POLYGON_RASTER_LAYOUT_LARGE || count >= TB_MAXU16)? "large" : "compact"
+                   , loop
+                   , spans / loop
+                   , dt);
+    }
+
+    // exit points
+    tb_free(points);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t gb_demo_core_polygon_raster_main(tb_int_t argc, tb_char_t** argv)
+{
+    // init raster
+    gb_polygon_raster_ref_t raster = gb_polygon_raster_init();
+    if (raster)
+    {
+        // the compact and large layout for the small, medium and huge polygon
+        gb_demo_core_polygon_raster_bench(raster, 1000, 1000);
+        gb_demo_core_polygon_raster_bench(raster, 65536, 20);
+        gb_demo_core_polygon_raster_bench(raster, 1000000, 2);
+
+        // exit raster
+        gb_polygon_raster_exit(raster);
+    }
+    return 0;
+}
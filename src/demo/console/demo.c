@@ -35,7 +35,10 @@ static gb_demo_t g_demo[] =
     // core
     GB_DEMO_MAIN_ITEM(core_path)
 ,   GB_DEMO_MAIN_ITEM(core_bitmap)
+,   GB_DEMO_MAIN_ITEM(core_bitmap_clear)
+,   GB_DEMO_MAIN_ITEM(core_canvas_rotate)
 ,   GB_DEMO_MAIN_ITEM(core_vector)
+,   GB_DEMO_MAIN_ITEM(core_polygon_raster)
 
     // utils
 ,   GB_DEMO_MAIN_ITEM(utils_mesh)
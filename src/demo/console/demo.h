@@ -42,7 +42,10 @@
 // core
 GB_DEMO_MAIN_DECL(core_path);
 GB_DEMO_MAIN_DECL(core_bitmap);
+GB_DEMO_MAIN_DECL(core_bitmap_clear);
+GB_DEMO_MAIN_DECL(core_canvas_rotate);
 GB_DEMO_MAIN_DECL(core_vector);
+GB_DEMO_MAIN_DECL(core_polygon_raster);
 
 // utils
 GB_DEMO_MAIN_DECL(utils_mesh);
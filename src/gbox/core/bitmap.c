@@ -27,6 +27,17 @@
 #include "bitmap.h"
 #include "pixmap.h"
 #include "bitmap/decoder.h"
+#include "bitmap/decoder/prefix.h"
+#include "bitmap/encoder.h"
+#include "impl/pixmap_simd.h"
+#include "impl/bitmap_pool.h"
+#if defined(TB_CONFIG_OS_LINUX) || defined(TB_CONFIG_OS_ANDROID) || defined(TB_CONFIG_OS_MACOSX) || defined(TB_CONFIG_OS_IOS)
+#   include <fcntl.h>
+#   include <unistd.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   define GB_BITMAP_HAVE_MMAP
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
@@ -47,6 +58,21 @@ typedef struct __gb_bitmap_impl_t
 	// has alpha?
 	tb_uint8_t 			has_alpha   : 1;
 
+    // is the owned data from the bitmap pool?
+    tb_uint8_t          is_pooled   : 1;
+
+    // the capacity of the data, the data is reused if the resized bitmap is not larger than it
+    tb_size_t           capacity;
+
+    // the mapped file for the data, the data is the pixels of it
+    tb_pointer_t        map;
+
+    // the mapped file size
+    tb_size_t           map_size;
+
+    // the next mipmap level which is reduced from this bitmap, it is generated lazily
+    struct __gb_bitmap_impl_t* mipmap;
+
 	// the pixfmt
 	tb_uint16_t         pixfmt;
 
@@ -61,6 +87,251 @@ typedef struct __gb_bitmap_impl_t
 
 }gb_bitmap_impl_t;
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+#ifdef GB_BITMAP_HAVE_MMAP
+static gb_bitmap_ref_t gb_bitmap_init_from_mmap(tb_size_t pixfmt, tb_char_t const* url)
+{
+    // the local file path
+    if (!tb_strnicmp(url, "file://", 7)) url += 7;
+    else if (tb_strstr(url, "://")) return tb_null;
+
+    // done
+    tb_bool_t           ok = tb_false;
+    tb_int_t            fd = -1;
+    tb_pointer_t        map = MAP_FAILED;
+    tb_size_t           map_size = 0;
+    gb_bitmap_impl_t*   impl = tb_null;
+    do
+    {
+        // open the file
+        fd = open(url, O_RDONLY);
+        tb_check_break(fd >= 0);
+
+        // the file size
+        struct stat st;
+        tb_check_break(!fstat(fd, &st) && st.st_size > 0);
+        map_size = (tb_size_t)st.st_size;
+
+        /* map the file 
+         *
+         * the private mapping is copy-on-write, so we can draw to the bitmap and the file will not be modified
+         */
+        map = mmap(tb_null, map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        tb_check_break(map != MAP_FAILED);
+
+        // the pixels of the plain bmp file
+        tb_size_t width = 0;
+        tb_size_t height = 0;
+        tb_size_t offset = gb_bitmap_decoder_bmp_plain((tb_byte_t const*)map, map_size, pixfmt, &width, &height);
+        tb_check_break(offset);
+
+        /* init bitmap with the pixels
+         *
+         * the plain argb8888 bmp has the alpha mask, so it has alpha without scanning all the mapped pixels
+         */
+        impl = (gb_bitmap_impl_t*)gb_bitmap_init((tb_byte_t*)map + offset, pixfmt, width, height, width << 2, GB_PIXFMT_HAS_ALPHA(pixfmt));
+        tb_assert_and_check_break(impl);
+
+        // attach the mapped file
+        impl->map       = map;
+        impl->map_size  = map_size;
+
+        // trace
+        tb_trace_d("map: %s, %lux%lu", url, width, height);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // close the file, the mapping is still valid
+    if (fd >= 0) close(fd);
+    fd = -1;
+
+    // failed?
+    if (!ok)
+    {
+        // unmap it
+        if (map != MAP_FAILED) munmap(map, map_size);
+        map = MAP_FAILED;
+    }
+
+    // ok?
+    return (gb_bitmap_ref_t)impl;
+}
+#endif
+
+static tb_void_t gb_bitmap_data_exit(gb_bitmap_impl_t* impl)
+{
+    // exit the owned data
+    if (impl->is_owner && impl->data)
+    {
+        // free it to the bitmap pool for reusing it
+        if (impl->is_pooled) gb_bitmap_pool_free(impl->data, impl->capacity, impl->row_bytes);
+        else tb_free(impl->data);
+    }
+
+    // clear it
+    impl->data      = tb_null;
+    impl->capacity  = 0;
+    impl->is_pooled = 0;
+}
+static tb_void_t gb_bitmap_mipmap_reduce(tb_byte_t* d, tb_byte_t const* s0, tb_byte_t const* s1, tb_size_t width)
+{
+    // reduce the pairs of the opaque 32-bits pixels, each byte channel is averaged independently
+    tb_size_t i = 0;
+    tb_size_t n = width >> 1;
+    if (n && !gb_pixmap_simd_reduce2x2(d, s0, s1, n))
+    {
+        tb_byte_t*          p = d;
+        tb_byte_t*          e = d + (n << 2);
+        tb_byte_t const*    p0 = s0;
+        tb_byte_t const*    p1 = s1;
+        for (; p < e; p += 4, p0 += 8, p1 += 8)
+        {
+            for (i = 0; i < 4; i++) p[i] = (tb_byte_t)((p0[i] + p0[i + 4] + p1[i] + p1[i + 4] + 2) >> 2);
+        }
+    }
+
+    // the odd width? reduce the last column with itself
+    if (width & 1)
+    {
+        d += n << 2;
+        s0 += (width - 1) << 2;
+        s1 += (width - 1) << 2;
+        for (i = 0; i < 4; i++) d[i] = (tb_byte_t)((s0[i] + s1[i] + 1) >> 1);
+    }
+}
+static tb_void_t gb_bitmap_mipmap_reduce_alpha(tb_uint32_t* d, tb_uint32_t const* s0, tb_uint32_t const* s1, tb_size_t width)
+{
+    // reduce the argb8888 pixels with the alpha weights, the colors of the transparent pixels are ignored
+    tb_size_t   i = 0;
+    tb_size_t   k = 0;
+    tb_size_t   n = (width + 1) >> 1;
+    tb_uint32_t p[4];
+    for (i = 0; i < n; i++)
+    {
+        // the four pixels, the last column is reduced with itself for the odd width
+        tb_size_t x0 = i << 1;
+        tb_size_t x1 = tb_min(x0 + 1, width - 1);
+        p[0] = s0[x0];
+        p[1] = s0[x1];
+        p[2] = s1[x0];
+        p[3] = s1[x1];
+
+        // accumulate the premultiplied channels
+        tb_uint32_t a = 0;
+        tb_uint32_t r = 0;
+        tb_uint32_t g = 0;
+        tb_uint32_t b = 0;
+        for (k = 0; k < 4; k++)
+        {
+            tb_uint32_t pa = p[k] >> 24;
+            a += pa;
+            r += ((p[k] >> 16) & 0xff) * pa;
+            g += ((p[k] >> 8) & 0xff) * pa;
+            b += (p[k] & 0xff) * pa;
+        }
+
+        // make pixel
+        d[i] = a? ((((a + 2) >> 2) << 24) | (((r + (a >> 1)) / a) << 16) | (((g + (a >> 1)) / a) << 8) | ((b + (a >> 1)) / a)) : 0;
+    }
+}
+static gb_bitmap_impl_t* gb_bitmap_mipmap_make(gb_bitmap_impl_t* impl)
+{
+    // check
+    tb_assert_and_check_return_val(impl && impl->data, tb_null);
+
+    // the last level?
+    tb_check_return_val(impl->width > 1 || impl->height > 1, tb_null);
+
+    // the pixmap
+    gb_pixmap_ref_t pixmap = gb_pixmap(impl->pixfmt, 0xff);
+    tb_assert_and_check_return_val(pixmap, tb_null);
+
+    // done
+    tb_bool_t           ok = tb_false;
+    tb_byte_t*          buffer = tb_null;
+    gb_bitmap_impl_t*   mipmap = tb_null;
+    do
+    {
+        /* make the mipmap with the half size
+         *
+         * the odd size is rounded up, so the last row or column is not dropped and reduced with itself
+         */
+        tb_size_t width     = impl->width;
+        tb_size_t height    = impl->height;
+        mipmap = (gb_bitmap_impl_t*)gb_bitmap_init(tb_null, impl->pixfmt, (width + 1) >> 1, (height + 1) >> 1, 0, impl->has_alpha);
+        tb_assert_and_check_break(mipmap);
+
+        /* reduce the opaque 32-bits rows directly, 
+         * otherwise convert the rows to argb8888 or xrgb8888 and convert the reduced row back
+         */
+        tb_bool_t direct = !impl->has_alpha && pixmap->btp == 4;
+        tb_size_t work_fmt = impl->has_alpha? GB_PIXFMT_ARGB8888 : GB_PIXFMT_XRGB8888;
+        tb_byte_t* r0 = tb_null;
+        tb_byte_t* r1 = tb_null;
+        tb_byte_t* rd = tb_null;
+        if (!direct)
+        {
+            buffer = (tb_byte_t*)tb_malloc((width << 3) + (mipmap->width << 2));
+            tb_assert_and_check_break(buffer);
+            r0 = buffer;
+            r1 = r0 + (width << 2);
+            rd = r1 + (width << 2);
+        }
+
+        // reduce rows
+        tb_size_t           j = 0;
+        tb_byte_t*          d = (tb_byte_t*)mipmap->data;
+        for (j = 0; j < mipmap->height; j++, d += mipmap->row_bytes)
+        {
+            // the two source rows, the last row is reduced with itself for the odd height
+            tb_size_t           y0 = j << 1;
+            tb_size_t           y1 = tb_min(y0 + 1, height - 1);
+            tb_byte_t const*    s0 = (tb_byte_t const*)impl->data + y0 * impl->row_bytes;
+            tb_byte_t const*    s1 = (tb_byte_t const*)impl->data + y1 * impl->row_bytes;
+
+            // reduce it directly
+            if (direct) gb_bitmap_mipmap_reduce(d, s0, s1, width);
+            else
+            {
+                // convert the source rows
+                if (!gb_pixmap_convert(work_fmt, r0, impl->pixfmt, s0, width)) break;
+                if (!gb_pixmap_convert(work_fmt, r1, impl->pixfmt, s1, width)) break;
+
+                // reduce them
+                if (impl->has_alpha) gb_bitmap_mipmap_reduce_alpha((tb_uint32_t*)rd, (tb_uint32_t const*)r0, (tb_uint32_t const*)r1, width);
+                else gb_bitmap_mipmap_reduce(rd, r0, r1, width);
+
+                // convert the reduced row back
+                if (!gb_pixmap_convert(impl->pixfmt, d, work_fmt, rd, mipmap->width)) break;
+            }
+        }
+        tb_check_break(j == mipmap->height);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // exit the work rows
+    if (buffer) tb_free(buffer);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (mipmap) gb_bitmap_exit((gb_bitmap_ref_t)mipmap);
+        mipmap = tb_null;
+    }
+
+    // ok?
+    return mipmap;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -83,8 +354,8 @@ gb_bitmap_ref_t gb_bitmap_init(tb_pointer_t data, tb_size_t pixfmt, tb_size_t wi
         gb_pixmap_ref_t pixmap = gb_pixmap(pixfmt, 0xff);
         tb_assert_and_check_break(pixmap);
 
-        // the row bytes
-        if (!row_bytes) row_bytes = width * pixmap->btp;
+        // the row bytes, the rows of the owned data are aligned for the simd kernels
+        if (!row_bytes) row_bytes = data? width * pixmap->btp : tb_align(width * pixmap->btp, GB_BITMAP_POOL_ALIGN);
         tb_assert_and_check_break(row_bytes && row_bytes >= width * pixmap->btp);
 
         // init bitmap 
@@ -93,11 +364,16 @@ gb_bitmap_ref_t gb_bitmap_init(tb_pointer_t data, tb_size_t pixfmt, tb_size_t wi
         impl->height 	    = (tb_uint16_t)height;
         impl->row_bytes 	= (tb_uint16_t)row_bytes;
         impl->size 	        = row_bytes * height;
-        impl->data          = data? data : tb_malloc0(impl->size);
+        impl->capacity      = impl->size;
+        impl->data          = data? data : gb_bitmap_pool_malloc(impl->size, row_bytes, &impl->capacity);
         impl->has_alpha     = !!has_alpha;
         impl->is_owner      = !data;
+        impl->is_pooled     = !data;
         tb_assert_and_check_break(impl->data);
 
+        // clear the owned data
+        if (!data) tb_memset(impl->data, 0, impl->size);
+
         // ok
         ok = tb_true;
 
@@ -118,6 +394,12 @@ gb_bitmap_ref_t gb_bitmap_init_from_url(tb_size_t pixfmt, tb_char_t const* url)
 {
     // check
     tb_assert_and_check_return_val(GB_PIXFMT_OK(pixfmt) && url, tb_null);
+
+#ifdef GB_BITMAP_HAVE_MMAP
+    // map the plain bmp file directly and need not copy it
+    gb_bitmap_ref_t mapped = gb_bitmap_init_from_mmap(pixfmt, url);
+    if (mapped) return mapped;
+#endif
     
     // init stream
     tb_stream_ref_t stream = tb_stream_init_from_url(url);
@@ -134,6 +416,30 @@ gb_bitmap_ref_t gb_bitmap_init_from_url(tb_size_t pixfmt, tb_char_t const* url)
     return bitmap;
 }
 gb_bitmap_ref_t gb_bitmap_init_from_stream(tb_size_t pixfmt, tb_stream_ref_t stream)
+{
+    // init bitmap from stream with the original size
+    return gb_bitmap_init_from_stream_scaled(pixfmt, stream, 0, 0);
+}
+gb_bitmap_ref_t gb_bitmap_init_from_url_scaled(tb_size_t pixfmt, tb_char_t const* url, tb_size_t width, tb_size_t height)
+{
+    // check
+    tb_assert_and_check_return_val(GB_PIXFMT_OK(pixfmt) && url, tb_null);
+    
+    // init stream
+    tb_stream_ref_t stream = tb_stream_init_from_url(url);
+    tb_assert_and_check_return_val(stream, tb_null);
+
+    // init bitmap from stream
+    gb_bitmap_ref_t bitmap = tb_null;
+    if (tb_stream_open(stream)) bitmap = gb_bitmap_init_from_stream_scaled(pixfmt, stream, width, height);
+
+    // exit stream
+    tb_stream_exit(stream);
+
+    // ok?
+    return bitmap;
+}
+gb_bitmap_ref_t gb_bitmap_init_from_stream_scaled(tb_size_t pixfmt, tb_stream_ref_t stream, tb_size_t width, tb_size_t height)
 {
     // check
     tb_assert_and_check_return_val(GB_PIXFMT_OK(pixfmt) && stream, tb_null);
@@ -142,6 +448,9 @@ gb_bitmap_ref_t gb_bitmap_init_from_stream(tb_size_t pixfmt, tb_stream_ref_t str
     gb_bitmap_decoder_ref_t decoder = gb_bitmap_decoder_init(pixfmt, stream);
     tb_assert_and_check_return_val(decoder, tb_null);
 
+    // scale it for the smaller bitmap
+    if (width && height) gb_bitmap_decoder_scale(decoder, width, height);
+
     // done bitmap decoder
     gb_bitmap_ref_t bitmap = gb_bitmap_decoder_done(decoder);
     tb_assert(bitmap);
@@ -152,15 +461,118 @@ gb_bitmap_ref_t gb_bitmap_init_from_stream(tb_size_t pixfmt, tb_stream_ref_t str
     // ok?
     return bitmap;
 }
+tb_bool_t gb_bitmap_decode_from_url(gb_bitmap_ref_t bitmap, tb_char_t const* url)
+{
+    // check
+    tb_assert_and_check_return_val(bitmap && url, tb_false);
+    
+    // init stream
+    tb_stream_ref_t stream = tb_stream_init_from_url(url);
+    tb_assert_and_check_return_val(stream, tb_false);
+
+    // decode bitmap from stream
+    tb_bool_t ok = tb_false;
+    if (tb_stream_open(stream)) ok = gb_bitmap_decode_from_stream(bitmap, stream);
+
+    // exit stream
+    tb_stream_exit(stream);
+
+    // ok?
+    return ok;
+}
+tb_bool_t gb_bitmap_decode_from_stream(gb_bitmap_ref_t bitmap, tb_stream_ref_t stream)
+{
+    // check
+	gb_bitmap_impl_t* impl = (gb_bitmap_impl_t*)bitmap;
+    tb_assert_and_check_return_val(impl && impl->data && stream, tb_false);
+
+    // init bitmap decoder
+    gb_bitmap_decoder_ref_t decoder = gb_bitmap_decoder_init(impl->pixfmt, stream);
+    tb_assert_and_check_return_val(decoder, tb_false);
+
+    // done
+    tb_bool_t ok = tb_false;
+    do
+    {
+        // resize the own bitmap to the image, the data will be reused if it is large enough
+        if (impl->is_owner && !gb_bitmap_resize(bitmap, gb_bitmap_decoder_width(decoder), gb_bitmap_decoder_height(decoder))) break;
+
+        // the pixels will be changed
+        gb_bitmap_mipmap_clear(bitmap);
+
+        // decode it
+        if (!gb_bitmap_decoder_decode(decoder, bitmap)) break;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // exit bitmap decoder
+    gb_bitmap_decoder_exit(decoder);
+
+    // ok?
+    return ok;
+}
+tb_bool_t gb_bitmap_encode_to_url(gb_bitmap_ref_t bitmap, tb_size_t type, tb_char_t const* url)
+{
+    // check
+    tb_assert_and_check_return_val(bitmap && url, tb_false);
+    
+    // init stream
+    tb_stream_ref_t stream = tb_stream_init_from_url(url);
+    tb_assert_and_check_return_val(stream, tb_false);
+
+    // create or truncate the file
+    if (tb_stream_type(stream) == TB_STREAM_TYPE_FILE) 
+        tb_stream_ctrl(stream, TB_STREAM_CTRL_FILE_SET_MODE, TB_FILE_MODE_RW | TB_FILE_MODE_CREAT | TB_FILE_MODE_BINARY | TB_FILE_MODE_TRUNC);
+
+    // encode bitmap to stream
+    tb_bool_t ok = tb_false;
+    if (tb_stream_open(stream)) ok = gb_bitmap_encode_to_stream(bitmap, type, stream);
+
+    // exit stream
+    tb_stream_exit(stream);
+
+    // ok?
+    return ok;
+}
+tb_bool_t gb_bitmap_encode_to_stream(gb_bitmap_ref_t bitmap, tb_size_t type, tb_stream_ref_t stream)
+{
+    // check
+	gb_bitmap_impl_t* impl = (gb_bitmap_impl_t*)bitmap;
+    tb_assert_and_check_return_val(impl && impl->data && stream, tb_false);
+
+    // init bitmap encoder
+    gb_bitmap_encoder_ref_t encoder = gb_bitmap_encoder_init(type, stream);
+    tb_check_return_val(encoder, tb_false);
+
+    // encode it
+    tb_bool_t ok = gb_bitmap_encoder_done(encoder, bitmap);
+
+    // exit bitmap encoder
+    gb_bitmap_encoder_exit(encoder);
+
+    // ok?
+    return ok;
+}
 tb_void_t gb_bitmap_exit(gb_bitmap_ref_t bitmap)
 {
     // check
 	gb_bitmap_impl_t* impl = (gb_bitmap_impl_t*)bitmap;
     tb_assert_and_check_return(impl);
 
+    // exit the mipmaps
+    gb_bitmap_mipmap_clear(bitmap);
+
     // exit data
-    if (impl->is_owner && impl->data) tb_free(impl->data);
-    impl->data = tb_null;
+    gb_bitmap_data_exit(impl);
+
+#ifdef GB_BITMAP_HAVE_MMAP
+    // exit the mapped file
+    if (impl->map) munmap(impl->map, impl->map_size);
+    impl->map = tb_null;
+#endif
 
     // exit it
     tb_free(impl);
@@ -204,8 +616,17 @@ tb_bool_t gb_bitmap_data_set(gb_bitmap_ref_t bitmap, tb_pointer_t data, tb_size_
         if (!row_bytes) row_bytes = width * pixmap->btp;
         tb_assert_and_check_break(row_bytes && row_bytes >= width * pixmap->btp);
 
+        // exit the mipmaps of the old data
+        gb_bitmap_mipmap_clear(bitmap);
+
+#ifdef GB_BITMAP_HAVE_MMAP
+        // exit the mapped file
+        if (impl->map && impl->data != data) munmap(impl->map, impl->map_size);
+        if (impl->data != data) impl->map = tb_null;
+#endif
+
         // exit it first
-        if (impl->data && impl->data != data && impl->is_owner) tb_free(impl->data);
+        if (impl->data != data) gb_bitmap_data_exit(impl);
 
         // update bitmap 
         impl->pixfmt        = (tb_uint16_t)pixfmt;
@@ -216,6 +637,7 @@ tb_bool_t gb_bitmap_data_set(gb_bitmap_ref_t bitmap, tb_pointer_t data, tb_size_
         impl->row_bytes 	= (tb_uint16_t)row_bytes;
         impl->is_owner      = 1;
         impl->has_alpha     = !!has_alpha;
+        if (!impl->is_pooled) impl->capacity = impl->size;
 
         // ok
         ok = tb_true;
@@ -234,35 +656,45 @@ tb_bool_t gb_bitmap_resize(gb_bitmap_ref_t bitmap, tb_size_t width, tb_size_t he
 	// same?
 	tb_check_return_val(impl->width != width || impl->height != height, tb_true);
 
+    // exit the mipmaps of the old size
+    gb_bitmap_mipmap_clear(bitmap);
+
     // the pixmap, only using btp
     gb_pixmap_ref_t pixmap = gb_pixmap(impl->pixfmt, 0xff);
     tb_assert_and_check_return_val(pixmap, tb_false);
 
-    // space enough?
-    if (height * width * pixmap->btp <= impl->size)
-    {
-        // resize
-        impl->width     = (tb_uint16_t)width;
-        impl->height    = (tb_uint16_t)height;
-        if (impl->is_owner) impl->row_bytes = (tb_uint16_t)(width * pixmap->btp);
-        impl->size      = impl->row_bytes * height;
-    }
-    // grow?
-    else
+    // the row bytes, only the owned data can change it
+    tb_size_t row_bytes = impl->is_owner? tb_align(width * pixmap->btp, GB_BITMAP_POOL_ALIGN) : impl->row_bytes;
+    tb_check_return_val(row_bytes >= width * pixmap->btp, tb_false);
+
+    // space enough? keep the capacity and only change the used size, the shrinked data is not freed
+    tb_size_t size = row_bytes * height;
+    if (size > impl->capacity)
     {
         // must be owner
         tb_assert(impl->is_owner);
         tb_check_return_val(impl->is_owner, tb_false);
 
-		// resize 
-        impl->width     = (tb_uint16_t)width;
-        impl->height    = (tb_uint16_t)height;
-		impl->row_bytes = (tb_uint16_t)(width * pixmap->btp);
-        impl->size      = impl->row_bytes * height;
-        impl->data      = tb_ralloc(impl->data, impl->size);
-        tb_assert_and_check_return_val(impl->data, tb_false);
+        // make the larger data from the bitmap pool, the old pixels are discarded
+        tb_size_t       capacity = 0;
+        tb_pointer_t    data = gb_bitmap_pool_malloc(size, row_bytes, &capacity);
+        tb_assert_and_check_return_val(data, tb_false);
+
+        // exit the old data
+        gb_bitmap_data_exit(impl);
+
+        // use the new data
+        impl->data      = data;
+        impl->capacity  = capacity;
+        impl->is_pooled = 1;
     }
 
+    // resize
+    impl->width     = (tb_uint16_t)width;
+    impl->height    = (tb_uint16_t)height;
+    impl->row_bytes = (tb_uint16_t)row_bytes;
+    impl->size      = size;
+
 	// ok
 	return tb_true;
 }
@@ -308,8 +740,11 @@ tb_void_t gb_bitmap_set_alpha(gb_bitmap_ref_t bitmap, tb_bool_t has_alpha)
 	gb_bitmap_impl_t* impl = (gb_bitmap_impl_t*)bitmap;
 	tb_assert_and_check_return(impl);
 
+    // the mipmaps are reduced with the alpha or not
+    if (impl->has_alpha != !!has_alpha) gb_bitmap_mipmap_clear(bitmap);
+
     // done
-    impl->has_alpha = has_alpha;
+    impl->has_alpha = !!has_alpha;
 }
 tb_size_t gb_bitmap_row_bytes(gb_bitmap_ref_t bitmap)
 {
@@ -320,3 +755,100 @@ tb_size_t gb_bitmap_row_bytes(gb_bitmap_ref_t bitmap)
     // the row bytes
 	return impl->row_bytes;
 }
+tb_bool_t gb_bitmap_convert(gb_bitmap_ref_t bitmap, gb_bitmap_ref_t source)
+{
+    // check
+	gb_bitmap_impl_t* impl = (gb_bitmap_impl_t*)bitmap;
+	gb_bitmap_impl_t* source_impl = (gb_bitmap_impl_t*)source;
+	tb_assert_and_check_return_val(impl && impl->data && source_impl && source_impl->data && impl != source_impl, tb_false);
+
+    // the pixels will be changed
+    gb_bitmap_mipmap_clear(bitmap);
+
+    // the intersection
+    tb_size_t width = tb_min(impl->width, source_impl->width);
+    tb_size_t height = tb_min(impl->height, source_impl->height);
+
+    // the rows
+    tb_byte_t*          d = (tb_byte_t*)impl->data;
+    tb_byte_t const*    s = (tb_byte_t const*)source_impl->data;
+    tb_size_t           dst_row_bytes = impl->row_bytes;
+    tb_size_t           src_row_bytes = source_impl->row_bytes;
+
+    // the pixmaps
+    gb_pixmap_ref_t     dst_pixmap = gb_pixmap(impl->pixfmt, 0xff);
+    gb_pixmap_ref_t     src_pixmap = gb_pixmap(source_impl->pixfmt, 0xff);
+    tb_assert_and_check_return_val(dst_pixmap && src_pixmap, tb_false);
+
+    // dither the source for the palette
+    tb_size_t x;
+    tb_size_t y;
+    if (GB_PIXFMT(impl->pixfmt) == GB_PIXFMT(GB_PIXFMT_PAL8) && GB_PIXFMT(source_impl->pixfmt) != GB_PIXFMT(GB_PIXFMT_PAL8))
+    {
+        // no palette?
+        tb_check_return_val(gb_pixmap_palette(tb_null), tb_false);
+
+        // dither the rows
+        for (y = 0; y < height; y++, d += dst_row_bytes, s += src_row_bytes)
+        {
+            for (x = 0; x < width; x++) d[x] = (tb_byte_t)gb_pixmap_palette_dither(src_pixmap->color_get(s + x * src_pixmap->btp), x, y);
+        }
+
+        // the palette has no alpha
+        impl->has_alpha = 0;
+
+        // ok
+        return tb_true;
+    }
+
+    // the rows are contiguous? convert all pixels at once
+    if (dst_row_bytes == width * dst_pixmap->btp && src_row_bytes == width * src_pixmap->btp)
+    {
+        width *= height;
+        height = 1;
+    }
+
+    // convert the rows
+    for (y = 0; y < height; y++, d += dst_row_bytes, s += src_row_bytes)
+    {
+        if (!gb_pixmap_convert(impl->pixfmt, d, source_impl->pixfmt, s, width)) return tb_false;
+    }
+
+    // update the alpha
+    impl->has_alpha = (source_impl->has_alpha && GB_PIXFMT_HAS_ALPHA(impl->pixfmt))? 1 : 0;
+
+    // ok
+    return tb_true;
+}
+gb_bitmap_ref_t gb_bitmap_mipmap(gb_bitmap_ref_t bitmap, tb_size_t level)
+{
+    // check
+	gb_bitmap_impl_t* impl = (gb_bitmap_impl_t*)bitmap;
+	tb_assert_and_check_return_val(impl && impl->data, tb_null);
+
+    // walk to the given level and make the missing levels
+    for (; level; level--)
+    {
+        // make the next level
+        if (!impl->mipmap) impl->mipmap = gb_bitmap_mipmap_make(impl);
+
+        // the last level or failed? use this level
+        tb_check_break(impl->mipmap);
+
+        // the next level
+        impl = impl->mipmap;
+    }
+
+    // ok
+    return (gb_bitmap_ref_t)impl;
+}
+tb_void_t gb_bitmap_mipmap_clear(gb_bitmap_ref_t bitmap)
+{
+    // check
+	gb_bitmap_impl_t* impl = (gb_bitmap_impl_t*)bitmap;
+	tb_assert_and_check_return(impl);
+
+    // exit the next levels
+    if (impl->mipmap) gb_bitmap_exit((gb_bitmap_ref_t)impl->mipmap);
+    impl->mipmap = tb_null;
+}
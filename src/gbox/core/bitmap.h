@@ -39,6 +39,9 @@ __tb_extern_c_enter__
  */
 
 /*! init bitmap 
+ *
+ * the auto made data is cleared and reused from the bitmap pool, its rows are aligned by 64 bytes
+ * if the row bytes is zero, so the rows may be padded.
  *
  * @param data      the data, will auto make data if be null
  * @param pixfmt    the pixfmt 
@@ -52,6 +55,10 @@ __tb_extern_c_enter__
 gb_bitmap_ref_t     gb_bitmap_init(tb_pointer_t data, tb_size_t pixfmt, tb_size_t width, tb_size_t height, tb_size_t row_bytes, tb_bool_t has_alpha);
 
 /*! init bitmap from url
+ *
+ * the plain uncompressed top-down 32-bits bmp file will be mapped to the memory directly 
+ * if the pixfmt is same and the pixels are aligned by four bytes, e.g. the bmp file encoded by gb_bitmap_encode_to_url,
+ * and the argb8888 bmp file must have the alpha mask of the bitfields
  *
  * @param pixfmt    the pixfmt 
  * @param url       the bitmap url
@@ -69,6 +76,73 @@ gb_bitmap_ref_t     gb_bitmap_init_from_url(tb_size_t pixfmt, tb_char_t const* u
  */
 gb_bitmap_ref_t     gb_bitmap_init_from_stream(tb_size_t pixfmt, tb_stream_ref_t stream);
 
+/*! init the scaled bitmap from url
+ *
+ * the image will be decoded with the smallest native scale which is not smaller than the given size,
+ * e.g. the jpg image is decoded with the 1/2, 1/4 or 1/8 dct scaling for the thumbnail and need not decode the full image.
+ * the other images are decoded with the original size
+ *
+ * @param pixfmt    the pixfmt 
+ * @param url       the bitmap url
+ * @param width     the requested width
+ * @param height    the requested height
+ *
+ * @return          the bitmap
+ */
+gb_bitmap_ref_t     gb_bitmap_init_from_url_scaled(tb_size_t pixfmt, tb_char_t const* url, tb_size_t width, tb_size_t height);
+
+/*! init the scaled bitmap from stream
+ *
+ * @param pixfmt    the pixfmt 
+ * @param stream    the bitmap stream
+ * @param width     the requested width
+ * @param height    the requested height
+ *
+ * @return          the bitmap
+ */
+gb_bitmap_ref_t     gb_bitmap_init_from_stream_scaled(tb_size_t pixfmt, tb_stream_ref_t stream, tb_size_t width, tb_size_t height);
+
+/*! decode the bitmap from url
+ *
+ * the image will be decoded into the data of the bitmap and converted to its pixfmt,
+ * the bitmap will be resized to the image if it is the owner of the data, otherwise the image will be clipped
+ *
+ * @param bitmap    the bitmap
+ * @param url       the bitmap url
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           gb_bitmap_decode_from_url(gb_bitmap_ref_t bitmap, tb_char_t const* url);
+
+/*! decode the bitmap from stream
+ *
+ * @param bitmap    the bitmap
+ * @param stream    the bitmap stream
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           gb_bitmap_decode_from_stream(gb_bitmap_ref_t bitmap, tb_stream_ref_t stream);
+
+/*! encode the bitmap to url
+ *
+ * @param bitmap    the bitmap
+ * @param type      the bitmap type, e.g. GB_BITMAP_TYPE_PPM, GB_BITMAP_TYPE_BMP and GB_BITMAP_TYPE_PNG
+ * @param url       the bitmap url, the file will be created or truncated
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           gb_bitmap_encode_to_url(gb_bitmap_ref_t bitmap, tb_size_t type, tb_char_t const* url);
+
+/*! encode the bitmap to stream
+ *
+ * @param bitmap    the bitmap
+ * @param type      the bitmap type
+ * @param stream    the opened stream for writing
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           gb_bitmap_encode_to_stream(gb_bitmap_ref_t bitmap, tb_size_t type, tb_stream_ref_t stream);
+
 /*! exit bitmap 
  *
  * @param bitmap    the bitmap
@@ -106,6 +180,10 @@ tb_pointer_t        gb_bitmap_data(gb_bitmap_ref_t bitmap);
 tb_bool_t           gb_bitmap_data_set(gb_bitmap_ref_t bitmap, tb_pointer_t data, tb_size_t pixfmt, tb_size_t width, tb_size_t height, tb_size_t row_bytes, tb_bool_t has_alpha);
 
 /*! resize the bitmap
+ *
+ * the data capacity is kept and the data is not freed if the bitmap is shrinked,
+ * the larger data is made from the bitmap pool only if the capacity is not enough, 
+ * and the pixels are not kept after resizing.
  *
  * @param bitmap    the bitmap
  * @param width     the width 
@@ -162,6 +240,40 @@ tb_void_t           gb_bitmap_set_alpha(gb_bitmap_ref_t bitmap, tb_bool_t has_al
  */
 tb_size_t           gb_bitmap_row_bytes(gb_bitmap_ref_t bitmap);
 
+/*! convert the pixels of the source bitmap to the bitmap
+ *
+ * the pixels are converted to the pixfmt of the bitmap at the top-left corner,
+ * only the intersection of the two bitmaps will be converted
+ *
+ * @param bitmap    the bitmap
+ * @param source    the source bitmap
+ *
+ * @return          tb_true or tb_false if the pixfmts are not supported
+ */
+tb_bool_t           gb_bitmap_convert(gb_bitmap_ref_t bitmap, gb_bitmap_ref_t source);
+
+/*! the mipmap level of the bitmap
+ *
+ * the level n is reduced from the level n - 1 with the 2x2 box filter and has the half size rounded up,
+ * the last row or column of the odd size is reduced with itself.
+ * it is generated at the first time and cached on the bitmap until the pixels are changed.
+ *
+ * the cache is cleared by gb_bitmap_data_set(), gb_bitmap_resize(), gb_bitmap_convert(), the decoding
+ * and drawing to it with the bitmap device, please call gb_bitmap_mipmap_clear() if the pixels are modified directly.
+ *
+ * @param bitmap    the bitmap
+ * @param level     the level, the level 0 is the bitmap self and it will be clamped to the last 1x1 level
+ *
+ * @return          the bitmap of this level
+ */
+gb_bitmap_ref_t     gb_bitmap_mipmap(gb_bitmap_ref_t bitmap, tb_size_t level);
+
+/*! clear the cached mipmap levels of the bitmap
+ *
+ * @param bitmap    the bitmap
+ */
+tb_void_t           gb_bitmap_mipmap_clear(gb_bitmap_ref_t bitmap);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
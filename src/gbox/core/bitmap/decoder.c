@@ -41,6 +41,12 @@ gb_bitmap_decoder_ref_t gb_bitmap_decoder_init(tb_size_t pixfmt, tb_stream_ref_t
     {
         tb_null
     ,   gb_bitmap_decoder_bmp_probe
+#ifdef GB_CONFIG_PACKAGE_HAVE_ZLIB
+    ,   gb_bitmap_decoder_png_probe
+#endif
+#ifdef GB_CONFIG_PACKAGE_HAVE_JPEG
+    ,   gb_bitmap_decoder_jpg_probe
+#endif
     };
 
     // the bitmap decoder init list
@@ -48,6 +54,12 @@ gb_bitmap_decoder_ref_t gb_bitmap_decoder_init(tb_size_t pixfmt, tb_stream_ref_t
     {
         tb_null
     ,   gb_bitmap_decoder_bmp_init
+#ifdef GB_CONFIG_PACKAGE_HAVE_ZLIB
+    ,   gb_bitmap_decoder_png_init
+#endif
+#ifdef GB_CONFIG_PACKAGE_HAVE_JPEG
+    ,   gb_bitmap_decoder_jpg_init
+#endif
     };
     tb_assert_static(tb_arrayn(probe) == tb_arrayn(init));
 
@@ -83,12 +95,60 @@ tb_void_t gb_bitmap_decoder_exit(gb_bitmap_decoder_ref_t decoder)
     // exit it
     tb_free(decoder);
 }
+tb_size_t gb_bitmap_decoder_width(gb_bitmap_decoder_ref_t decoder)
+{
+    // check
+    gb_bitmap_decoder_impl_t* impl = (gb_bitmap_decoder_impl_t*)decoder;
+    tb_assert_and_check_return_val(impl, 0);
+
+    // the width
+    return impl->width;
+}
+tb_size_t gb_bitmap_decoder_height(gb_bitmap_decoder_ref_t decoder)
+{
+    // check
+    gb_bitmap_decoder_impl_t* impl = (gb_bitmap_decoder_impl_t*)decoder;
+    tb_assert_and_check_return_val(impl, 0);
+
+    // the height
+    return impl->height;
+}
+tb_void_t gb_bitmap_decoder_scale(gb_bitmap_decoder_ref_t decoder, tb_size_t width, tb_size_t height)
+{
+    // check
+    gb_bitmap_decoder_impl_t* impl = (gb_bitmap_decoder_impl_t*)decoder;
+    tb_assert_and_check_return(impl && width && height);
+
+    // scale it if the decoder supports it
+    if (impl->scale && (width < impl->width || height < impl->height)) impl->scale(impl, width, height);
+}
+tb_bool_t gb_bitmap_decoder_decode(gb_bitmap_decoder_ref_t decoder, gb_bitmap_ref_t bitmap)
+{
+    // check
+    gb_bitmap_decoder_impl_t* impl = (gb_bitmap_decoder_impl_t*)decoder;
+    tb_assert_and_check_return_val(impl && impl->decode && bitmap && gb_bitmap_data(bitmap), tb_false);
+
+    // decode it
+    return impl->decode(impl, bitmap);
+}
 gb_bitmap_ref_t gb_bitmap_decoder_done(gb_bitmap_decoder_ref_t decoder)
 {
     // check
     gb_bitmap_decoder_impl_t* impl = (gb_bitmap_decoder_impl_t*)decoder;
-    tb_assert_and_check_return_val(impl && impl->done, tb_null);
+    tb_assert_and_check_return_val(impl && impl->decode, tb_null);
+
+    // init bitmap, default: no alpha
+    gb_bitmap_ref_t bitmap = gb_bitmap_init(tb_null, impl->pixfmt, impl->width, impl->height, 0, tb_false);
+    tb_assert_and_check_return_val(bitmap, tb_null);
+
+    // decode it
+    if (!impl->decode(impl, bitmap))
+    {
+        // exit it
+        gb_bitmap_exit(bitmap);
+        bitmap = tb_null;
+    }
 
-    // done
-    return impl->done(impl);
+    // ok?
+    return bitmap;
 }
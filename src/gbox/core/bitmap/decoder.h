@@ -60,6 +60,46 @@ gb_bitmap_decoder_ref_t  gb_bitmap_decoder_init(tb_size_t pixfmt, tb_stream_ref_
  */
 tb_void_t               gb_bitmap_decoder_exit(gb_bitmap_decoder_ref_t decoder);
 
+/*! the image width of the bitmap decoder
+ *
+ * @param decoder       decoder 
+ *
+ * @return              the width
+ */
+tb_size_t               gb_bitmap_decoder_width(gb_bitmap_decoder_ref_t decoder);
+
+/*! the image height of the bitmap decoder
+ *
+ * @param decoder       decoder 
+ *
+ * @return              the height
+ */
+tb_size_t               gb_bitmap_decoder_height(gb_bitmap_decoder_ref_t decoder);
+
+/*! scale the image for decoding the smaller bitmap
+ *
+ * the decoder will decode the image with the smallest native scale which is not smaller than the given size,
+ * e.g. the jpg decoder decodes it with the 1/2, 1/4 or 1/8 dct scaling and the others ignore it.
+ * the scaled size can be got by gb_bitmap_decoder_width() and gb_bitmap_decoder_height()
+ *
+ * @param decoder       decoder 
+ * @param width         the requested width
+ * @param height        the requested height
+ */
+tb_void_t               gb_bitmap_decoder_scale(gb_bitmap_decoder_ref_t decoder, tb_size_t width, tb_size_t height);
+
+/*! decode the image into the given bitmap
+ *
+ * the rows are converted to the pixfmt of the bitmap while decoding them,
+ * and the image will be clipped if the bitmap is smaller than it
+ *
+ * @param decoder       decoder 
+ * @param bitmap        the bitmap
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               gb_bitmap_decoder_decode(gb_bitmap_decoder_ref_t decoder, gb_bitmap_ref_t bitmap);
+
 /*! done bitmap decoder 
  *
  * @param decoder       decoder 
@@ -45,6 +45,19 @@
 // the palette offset
 #define GB_BMP_OFFSET_PALETTE           (54)
 
+// the alpha mask offset of the bitfields, only for the info header with the alpha mask
+#define GB_BMP_OFFSET_ALPHA_MASK        (66)
+
+// the minimum info header size with the alpha mask, e.g. BITMAPV3INFOHEADER, BITMAPV4HEADER
+#define GB_BMP_INFO_SIZE_ALPHA          (56)
+
+/* the alignment of the plain bmp pixels for using them directly
+ *
+ * the pixels are often placed at the unaligned offset 54 of the file, 
+ * these files are decoded by copying the rows instead of accessing the unaligned pixels
+ */
+#define GB_BMP_PLAIN_ALIGN              (4)
+
 // the bmp compression flag
 #define GB_BMP_RGB                      (0)
 #define GB_BMP_RLE8                     (1)
@@ -107,30 +120,49 @@
  * @endcode
  */
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the bmp bitmap decoder type
+typedef struct __gb_bitmap_decoder_bmp_t
+{
+    // the base
+    gb_bitmap_decoder_impl_t    base;
+
+    // the rows are stored from top to bottom?
+    tb_bool_t                   top_down;
+
+    // the info header size
+    tb_size_t                   info_size;
+
+}gb_bitmap_decoder_bmp_t;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
-static gb_bitmap_ref_t gb_bitmap_decoder_bmp_done(gb_bitmap_decoder_impl_t* decoder)
+static tb_bool_t gb_bitmap_decoder_bmp_decode(gb_bitmap_decoder_impl_t* decoder, gb_bitmap_ref_t bitmap)
 {
     // check
-    tb_assert_and_check_return_val(decoder && decoder->type == GB_BITMAP_TYPE_BMP, tb_null);
+    gb_bitmap_decoder_bmp_t* impl = (gb_bitmap_decoder_bmp_t*)decoder;
+    tb_assert_and_check_return_val(impl && impl->base.type == GB_BITMAP_TYPE_BMP && bitmap, tb_false);
 
     // done
     tb_bool_t       ok = tb_false;
-    gb_bitmap_ref_t bitmap = tb_null;
+    tb_byte_t*      row_buffer = tb_null;
     do
     {
-        // the pixfmt
-        tb_size_t pixfmt    = decoder->pixfmt;
+        // the pixfmt of the bitmap
+        tb_size_t pixfmt    = gb_bitmap_pixfmt(bitmap);
         tb_assert_and_check_break(GB_PIXFMT_OK(pixfmt));
 
         // the width and height
-        tb_size_t width     = decoder->width;
-        tb_size_t height    = decoder->height;
+        tb_size_t width     = impl->base.width;
+        tb_size_t height    = impl->base.height;
         tb_assert_and_check_break(width && height);
 
         // the stream
-        tb_stream_ref_t stream = decoder->stream;
+        tb_stream_ref_t stream = impl->base.stream;
         tb_assert_and_check_break(stream);
 
         // the file size
@@ -152,7 +184,7 @@ static gb_bitmap_ref_t gb_bitmap_decoder_bmp_done(gb_bitmap_decoder_impl_t* deco
         tb_assert_and_check_break(bc != GB_BMP_RLE4 && bc != GB_BMP_RLE8);
 
         // the data size
-        tb_size_t linesize = (width * bpp) >> 3;
+        tb_size_t linesize = (width * bpp + 7) >> 3;
         tb_size_t datasize = tb_stream_bread_u32_le(stream);
         if (!datasize) datasize = tb_align4(linesize) * height;
         tb_assert_and_check_break(datasize && datasize < filesize);
@@ -191,8 +223,7 @@ static gb_bitmap_ref_t gb_bitmap_decoder_bmp_done(gb_bitmap_decoder_impl_t* deco
         }
 
         // bitfields?
-        gb_pixmap_ref_t sp = tb_null;
-        gb_pixmap_ref_t dp = gb_pixmap(pixfmt, 0xff);
+        tb_size_t sf = GB_PIXFMT_NONE;
         if (bc == GB_BMP_BITFIELDS)
         {
             // seek to the color mask position
@@ -203,22 +234,28 @@ static gb_bitmap_ref_t gb_bitmap_decoder_bmp_done(gb_bitmap_decoder_impl_t* deco
             tb_size_t gm = tb_stream_bread_u32_le(stream);
             tb_size_t bm = tb_stream_bread_u32_le(stream);
 
+            // read the alpha mask if the info header has it
+            tb_size_t am = impl->info_size >= GB_BMP_INFO_SIZE_ALPHA? tb_stream_bread_u32_le(stream) : 0;
+
             // 16-bits?
             if (bpp == 16)
             {
                 // rgb565?
                 if (rm == 0xf800 && gm == 0x07e0 && bm == 0x001f)
-                    sp = gb_pixmap(GB_PIXFMT_RGB565, 0xff);
+                    sf = GB_PIXFMT_RGB565;
                 // xrgb1555?
                 else if (rm == 0x7c00 && gm == 0x03e0 && bm == 0x001f)
-                    sp = gb_pixmap(GB_PIXFMT_XRGB1555, 0xff);
+                    sf = GB_PIXFMT_XRGB1555;
             }
             // 32-bits?
             else if (bpp == 32)
             {
                 // rgbx8888?
                 if (rm == 0xff000000 && gm == 0xff0000 && bm == 0xff00)
-                    sp = gb_pixmap(GB_PIXFMT_RGBX8888, 0xff);
+                    sf = GB_PIXFMT_RGBX8888;
+                // argb8888 or xrgb8888?
+                else if (rm == 0xff0000 && gm == 0xff00 && bm == 0xff)
+                    sf = am == 0xff000000? GB_PIXFMT_ARGB8888 : GB_PIXFMT_XRGB8888;
             }
         }
         // rgb?
@@ -228,21 +265,21 @@ static gb_bitmap_ref_t gb_bitmap_decoder_bmp_done(gb_bitmap_decoder_impl_t* deco
             {
             case 32:
                 // argb8888
-                sp = gb_pixmap(GB_PIXFMT_ARGB8888, 0xff);
+                sf = GB_PIXFMT_ARGB8888;
                 break;
             case 24:
                 // rgb888
-                sp = gb_pixmap(GB_PIXFMT_RGB888, 0xff);
+                sf = GB_PIXFMT_RGB888;
                 break;
             case 16:
                 // xrgb1555
-                sp = gb_pixmap(GB_PIXFMT_XRGB1555, 0xff);
+                sf = GB_PIXFMT_XRGB1555;
                 break;
             case 8:
             case 4:
             case 1:
                 // pal8
-                sp = gb_pixmap(GB_PIXFMT_PAL8, 0xff);
+                sf = GB_PIXFMT_PAL8;
                 break;
             default:
                 // trace
@@ -252,134 +289,125 @@ static gb_bitmap_ref_t gb_bitmap_decoder_bmp_done(gb_bitmap_decoder_impl_t* deco
         }
 
         // check
-        tb_assert_and_check_break(sp && dp);
+        gb_pixmap_ref_t dp = gb_pixmap(pixfmt, 0xff);
+        tb_assert_and_check_break(GB_PIXFMT_OK(sf) && dp);
 
         // trace
-        tb_trace_d("pixfmt: %s => %s", sp->name, dp->name);
+        tb_trace_d("pixfmt: %s => %s", gb_pixmap(sf, 0xff)->name, dp->name);
 
         // seek to the bmp data position
         if (!tb_stream_seek(stream, filesize - datasize)) break;
 
-        // init bitmap, default: no alpha
-        bitmap = gb_bitmap_init(tb_null, pixfmt, width, height, 0, tb_false);
-        tb_assert_and_check_break(bitmap);
-
         // the bitmap data
         tb_byte_t*  data = (tb_byte_t*)gb_bitmap_data(bitmap);
         tb_assert_and_check_break(data);
-        
-        // done
-        gb_color_t  c;
-        tb_byte_t   row_data[8192];
-        tb_size_t   btp_dst = dp->btp;
-        tb_size_t   btp_src = sp->btp;
-        tb_size_t   has_alpha = 0;
+
+        // clip the image to the bitmap
+        tb_size_t   clip_width = tb_min(width, gb_bitmap_width(bitmap));
+        tb_size_t   clip_height = gb_bitmap_height(bitmap);
         tb_size_t   row_bytes = gb_bitmap_row_bytes(bitmap);
         tb_size_t   row_bytes_align4 = tb_align4(linesize);
-        tb_byte_t*  p = data + (height - 1) * row_bytes;
-        tb_assert_and_check_break(row_bytes_align4 <= sizeof(row_data));
-        if (bpp > 8)
-        {
-            while (height--)
-            {
-                // read line
-                if (!tb_stream_bread(stream, row_data, row_bytes_align4)) break;
-                
-                // save bitmap data
-                tb_byte_t*  d = p;
-                tb_size_t   i = 0;
-                for (i = 0; i < linesize; i += btp_src, d += btp_dst)
-                {
-                    // load color
-                    c = sp->color_get(row_data + i);
+        tb_size_t   btp_dst = dp->btp;
 
-                    // save color
-                    dp->color_set(d, c);
+        // read the rows into the bitmap directly if the pixfmt is same
+        tb_bool_t   direct = bpp > 8 && sf == pixfmt;
+        tb_size_t   direct_size = clip_width * btp_dst;
 
-                    // has alpha?
-                    if (!has_alpha) has_alpha = c.a <= GB_ALPHA_MAXN;
-                }
-
-                // next line
-                p -= row_bytes;
-            }
-        }
-        else if (bpp == 8)
+        // init the row data, only allocate it for the large row
+        tb_byte_t   row_data[8192];
+        tb_byte_t*  row = row_data;
+        if (!direct && row_bytes_align4 > sizeof(row_data))
         {
-            while (height--)
-            {
-                // read line
-                if (!tb_stream_bread(stream, row_data, row_bytes_align4)) break;
-                
-                // save bitmap data
-                tb_byte_t*  d = p;
-                tb_size_t   i = 0;
-                for (i = 0; i < linesize; i++, d += btp_dst)
-                {
-                    // load color
-                    c = pals[row_data[i]];
+            row_buffer = (tb_byte_t*)tb_malloc(row_bytes_align4);
+            tb_assert_and_check_break(row_buffer);
+            row = row_buffer;
+        }
 
-                    // save color
-                    dp->color_set(d, c);
+        // the pixels of the palette, convert the palette once
+        gb_pixel_t  pixels[256];
+        if (bpp <= 8)
+        {
+            tb_size_t i = 0;
+            for (i = 0; i < paln; i++) pixels[i] = dp->pixel(pals[i]);
+        }
 
-                    // has alpha?
-                    if (!has_alpha) has_alpha = c.a <= GB_ALPHA_MAXN;
-                }
+        // scan the alpha of the source?
+        tb_bool_t   scan_alpha = GB_PIXFMT_HAS_ALPHA(pixfmt) && GB_PIXFMT_HAS_ALPHA(sf) && bpp == 32;
 
-                // next line
-                p -= row_bytes;
-            }
-        }
-        // bpp < 8?
-        else
+        // done
+        tb_size_t   i = 0;
+        tb_size_t   n = 0;
+        tb_size_t   y = 0;
+        tb_size_t   has_alpha = 0;
+        tb_byte_t*  d = tb_null;
+        tb_byte_t*  p = tb_null;
+        for (n = 0; n < height; n++)
         {
-            while (height--)
+            // the row of the bitmap
+            y = impl->top_down? n : height - n - 1;
+
+            // clipped? skip it
+            if (y >= clip_height)
             {
-                // read line
-                if (!tb_stream_bread(stream, row_data, row_bytes_align4)) break;
-                
-                // save bitmap data
-                tb_byte_t*  d = p;
-                tb_size_t   i = 0;
-                tb_size_t   m = linesize << 3;
-                for (i = 0; i < m; i += bpp, d += btp_dst)
-                {
-                    // load color
-                    c = pals[tb_bits_get_ubits32(&row_data[i / 8], i & 7, bpp)];
+                if (!tb_stream_skip(stream, row_bytes_align4)) break;
+                continue;
+            }
+            d = data + y * row_bytes;
 
-                    // save color
-                    dp->color_set(d, c);
+            // read the row to the bitmap directly
+            if (direct)
+            {
+                if (!tb_stream_bread(stream, d, direct_size)) break;
+                if (direct_size < row_bytes_align4 && !tb_stream_skip(stream, row_bytes_align4 - direct_size)) break;
+                p = d;
+            }
+            // read the row and convert it
+            else
+            {
+                if (!tb_stream_bread(stream, row, row_bytes_align4)) break;
+                p = row;
 
-                    // has alpha?
-                    if (!has_alpha) has_alpha = c.a <= GB_ALPHA_MAXN;
+                // convert the row
+                if (bpp > 8)
+                {
+                    if (!gb_pixmap_convert(pixfmt, d, sf, row, clip_width)) break;
+                }
+                else if (bpp == 8)
+                {
+                    for (i = 0; i < clip_width; i++, d += btp_dst) dp->pixel_set(d, pixels[row[i]], 0xff);
                 }
+                // bpp < 8?
+                else
+                {
+                    for (i = 0; i < clip_width; i++, d += btp_dst) dp->pixel_set(d, pixels[tb_bits_get_ubits32(&row[(i * bpp) >> 3], (i * bpp) & 7, bpp)], 0xff);
+                }
+            }
 
-                // next line
-                p -= row_bytes;
+            // has alpha?
+            if (scan_alpha && !has_alpha)
+            {
+                for (i = 0; i < clip_width && p[(i << 2) + 3] == 0xff; i++) ;
+                has_alpha = i < clip_width;
             }
         }
 
         // check
-        tb_assert_and_check_break(!(height + 1));
+        tb_assert_and_check_break(n == height);
 
         // set alpha
-        gb_bitmap_set_alpha(bitmap, (has_alpha && GB_PIXFMT_HAS_ALPHA(pixfmt))? tb_true : tb_false);
+        gb_bitmap_set_alpha(bitmap, has_alpha? tb_true : tb_false);
 
         // ok
         ok = tb_true;
 
     } while (0);
 
-    // failed?
-    if (!ok)
-    {
-        // exit it
-        if (bitmap) gb_bitmap_exit(bitmap);
-        bitmap = tb_null;
-    }
+    // exit the row buffer
+    if (row_buffer) tb_free(row_buffer);
+    row_buffer = tb_null;
 
     // ok?
-    return bitmap;
+    return ok;
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -405,28 +433,35 @@ gb_bitmap_decoder_ref_t gb_bitmap_decoder_bmp_init(tb_size_t pixfmt, tb_stream_r
 
     // done
     tb_bool_t                   ok = tb_false;
-    gb_bitmap_decoder_impl_t*    impl = tb_null;
+    gb_bitmap_decoder_bmp_t*    impl = tb_null;
     do
     {
-        // seek to the width and height position
-        if (!tb_stream_skip(stream, 18)) break;
+        // seek to the info header position
+        if (!tb_stream_skip(stream, 14)) break;
+
+        // read the info header size
+        tb_size_t info_size = tb_stream_bread_u32_le(stream);
 
-        // read width and height
-        tb_size_t width     = tb_stream_bread_u32_le(stream);
-        tb_size_t height    = tb_stream_bread_u32_le(stream);
-        tb_assert_and_check_break(width && height && width <= GB_WIDTH_MAXN && height <= GB_HEIGHT_MAXN);
+        // read width and height, the rows are stored from top to bottom if the height is negative
+        tb_long_t width     = (tb_int32_t)tb_stream_bread_u32_le(stream);
+        tb_long_t height    = (tb_int32_t)tb_stream_bread_u32_le(stream);
+        tb_bool_t top_down  = height < 0;
+        height              = tb_abs(height);
+        tb_assert_and_check_break(width > 0 && height > 0 && width <= GB_WIDTH_MAXN && height <= GB_HEIGHT_MAXN);
 
         // make decoder
-        impl = tb_malloc0_type(gb_bitmap_decoder_impl_t);
+        impl = tb_malloc0_type(gb_bitmap_decoder_bmp_t);
         tb_assert_and_check_break(impl);
 
         // init decoder
-        impl->type          = GB_BITMAP_TYPE_BMP;
-        impl->stream        = stream;
-        impl->pixfmt        = (tb_uint16_t)pixfmt;
-        impl->width         = (tb_uint16_t)width;
-        impl->height        = (tb_uint16_t)height;
-        impl->done          = gb_bitmap_decoder_bmp_done;
+        impl->base.type     = GB_BITMAP_TYPE_BMP;
+        impl->base.stream   = stream;
+        impl->base.pixfmt   = (tb_uint16_t)pixfmt;
+        impl->base.width    = (tb_uint16_t)width;
+        impl->base.height   = (tb_uint16_t)height;
+        impl->base.decode   = gb_bitmap_decoder_bmp_decode;
+        impl->top_down      = top_down;
+        impl->info_size     = info_size;
 
         // ok
         ok = tb_true;
@@ -444,3 +479,51 @@ gb_bitmap_decoder_ref_t gb_bitmap_decoder_bmp_init(tb_size_t pixfmt, tb_stream_r
     // ok?
     return (gb_bitmap_decoder_ref_t)impl;
 }
+tb_size_t gb_bitmap_decoder_bmp_plain(tb_byte_t const* data, tb_size_t size, tb_size_t pixfmt, tb_size_t* pwidth, tb_size_t* pheight)
+{
+    // check
+    tb_assert_and_check_return_val(data && pwidth && pheight, 0);
+
+    // the bmp file with the info header?
+    tb_check_return_val(size > GB_BMP_OFFSET_PALETTE && data[0] == 'B' && data[1] == 'M', 0);
+
+    // only the little-endian argb8888 or xrgb8888 can use the bmp pixels directly
+    tb_check_return_val(pixfmt == GB_PIXFMT_ARGB8888 || pixfmt == GB_PIXFMT_XRGB8888, 0);
+
+    // the uncompressed 32-bits rows? the xrgb8888 masks of the bitfields are placed after the info header 
+    tb_size_t bc = tb_bits_get_u32_le(data + GB_BMP_OFFSET_BPP + 2);
+    tb_check_return_val(tb_bits_get_u16_le(data + GB_BMP_OFFSET_BPP) == 32, 0);
+    tb_check_return_val(    bc == GB_BMP_RGB
+                        ||  (   bc == GB_BMP_BITFIELDS
+                            &&  size > GB_BMP_OFFSET_PALETTE + 12
+                            &&  tb_bits_get_u32_le(data + GB_BMP_OFFSET_PALETTE) == 0xff0000
+                            &&  tb_bits_get_u32_le(data + GB_BMP_OFFSET_PALETTE + 4) == 0xff00
+                            &&  tb_bits_get_u32_le(data + GB_BMP_OFFSET_PALETTE + 8) == 0xff), 0);
+
+    /* the argb8888 pixels need the alpha mask of the info header
+     *
+     * the pixels of the other 32-bits bmp may have no alpha, 
+     * so they are decoded for scanning the alpha instead of reading all the mapped pixels here
+     */
+    if (pixfmt == GB_PIXFMT_ARGB8888)
+    {
+        tb_check_return_val(    bc == GB_BMP_BITFIELDS
+                            &&  size > GB_BMP_OFFSET_ALPHA_MASK + 4
+                            &&  tb_bits_get_u32_le(data + 14) >= GB_BMP_INFO_SIZE_ALPHA
+                            &&  tb_bits_get_u32_le(data + GB_BMP_OFFSET_ALPHA_MASK) == 0xff000000, 0);
+    }
+
+    // the rows must be stored from top to bottom for the positive row bytes
+    tb_long_t width     = (tb_int32_t)tb_bits_get_u32_le(data + 18);
+    tb_long_t height    = (tb_int32_t)tb_bits_get_u32_le(data + 22);
+    tb_check_return_val(width > 0 && width <= GB_WIDTH_MAXN && height < 0 && -height <= GB_HEIGHT_MAXN, 0);
+
+    // the pixels
+    tb_size_t offset = tb_bits_get_u32_le(data + 10);
+    tb_check_return_val(offset >= GB_BMP_OFFSET_PALETTE && !(offset & (GB_BMP_PLAIN_ALIGN - 1)) && offset + (width << 2) * -height <= size, 0);
+
+    // ok
+    *pwidth     = width;
+    *pheight    = -height;
+    return offset;
+}
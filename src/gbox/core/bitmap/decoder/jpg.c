@@ -0,0 +1,374 @@
+/*!The Graphic Box Library
+ *
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox;
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ *
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        jpg.c
+ * @ingroup     core
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "jpg_decoder"
+#define TB_TRACE_MODULE_DEBUG           (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "jpeg/jpeg.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the input buffer size of the compressed data
+#ifdef __gb_small__
+#   define GB_JPG_INPUT_MAXN            (4096)
+#else
+#   define GB_JPG_INPUT_MAXN            (16384)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the jpg bitmap decoder type
+typedef struct __gb_bitmap_decoder_jpg_t
+{
+    // the base
+    gb_bitmap_decoder_impl_t        base;
+
+    // the decompress info
+    struct jpeg_decompress_struct   info;
+
+    // the error manager
+    struct jpeg_error_mgr           error;
+
+    // the source manager
+    struct jpeg_source_mgr          source;
+
+    // the jump buffer for the error
+    tb_jmpbuf_t                     jmpbuf;
+
+    // the decompress info has been created?
+    tb_bool_t                       created;
+
+    // the scanline of the decompressed pixels
+    tb_byte_t*                      row;
+
+    // the input data of the source
+    tb_byte_t                       input[GB_JPG_INPUT_MAXN];
+
+}gb_bitmap_decoder_jpg_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_void_t gb_bitmap_decoder_jpg_error_exit(j_common_ptr info)
+{
+    // the decoder
+    gb_bitmap_decoder_jpg_t* impl = (gb_bitmap_decoder_jpg_t*)info->client_data;
+
+    // trace
+#ifdef __gb_debug__
+    tb_char_t message[JMSG_LENGTH_MAX];
+    info->err->format_message(info, message);
+    tb_trace_e("%s", message);
+#endif
+
+    // jump to the caller
+    tb_longjmp(impl->jmpbuf, 1);
+}
+static tb_void_t gb_bitmap_decoder_jpg_output_message(j_common_ptr info)
+{
+    // no output
+}
+static tb_void_t gb_bitmap_decoder_jpg_source_init(j_decompress_ptr info)
+{
+}
+static boolean gb_bitmap_decoder_jpg_source_fill(j_decompress_ptr info)
+{
+    // the decoder
+    gb_bitmap_decoder_jpg_t* impl = (gb_bitmap_decoder_jpg_t*)info->client_data;
+
+    // read the compressed data
+    tb_size_t size = (tb_size_t)tb_min(tb_stream_left(impl->base.stream), (tb_hize_t)sizeof(impl->input));
+    if (!size || !tb_stream_bread(impl->base.stream, impl->input, size))
+    {
+        // insert the fake eoi marker for the truncated data
+        impl->input[0] = 0xff;
+        impl->input[1] = JPEG_EOI;
+        size = 2;
+    }
+
+    // fill it
+    impl->source.next_input_byte    = impl->input;
+    impl->source.bytes_in_buffer    = size;
+
+    // ok
+    return TRUE;
+}
+static tb_void_t gb_bitmap_decoder_jpg_source_skip(j_decompress_ptr info, long size)
+{
+    // the decoder
+    gb_bitmap_decoder_jpg_t* impl = (gb_bitmap_decoder_jpg_t*)info->client_data;
+    tb_check_return(size > 0);
+
+    // skip the buffered data
+    if ((tb_size_t)size <= impl->source.bytes_in_buffer)
+    {
+        impl->source.next_input_byte    += size;
+        impl->source.bytes_in_buffer    -= size;
+    }
+    // skip the stream
+    else
+    {
+        tb_stream_skip(impl->base.stream, size - impl->source.bytes_in_buffer);
+        impl->source.next_input_byte    = impl->input;
+        impl->source.bytes_in_buffer    = 0;
+    }
+}
+static tb_void_t gb_bitmap_decoder_jpg_source_term(j_decompress_ptr info)
+{
+}
+static tb_void_t gb_bitmap_decoder_jpg_gray(tb_byte_t* data, tb_size_t count)
+{
+    // expand the gray to rgb in place from the tail
+    tb_byte_t*          d = data + count * 3;
+    tb_byte_t const*    s = data + count;
+    while (s > data)
+    {
+        d -= 3;
+        d[0] = d[1] = d[2] = *--s;
+    }
+}
+static tb_void_t gb_bitmap_decoder_jpg_cmyk(tb_byte_t* d, tb_byte_t const* s, tb_size_t count)
+{
+    // the adobe cmyk is inverted: r = c * k / 255
+    tb_size_t i = 0;
+    for (i = 0; i < count; i++, d += 3, s += 4)
+    {
+        d[0] = (tb_byte_t)((s[0] * s[3] + 127) / 255);
+        d[1] = (tb_byte_t)((s[1] * s[3] + 127) / 255);
+        d[2] = (tb_byte_t)((s[2] * s[3] + 127) / 255);
+    }
+}
+static tb_void_t gb_bitmap_decoder_jpg_scale(gb_bitmap_decoder_impl_t* decoder, tb_size_t width, tb_size_t height)
+{
+    // check
+    gb_bitmap_decoder_jpg_t* impl = (gb_bitmap_decoder_jpg_t*)decoder;
+    tb_assert_and_check_return(impl && impl->created && width && height);
+
+    // the image size
+    tb_size_t image_width   = impl->info.image_width;
+    tb_size_t image_height  = impl->info.image_height;
+
+    /* the smallest dct scale which is not smaller than the given size
+     *
+     * the 8x8 blocks are decoded to the 4x4, 2x2 or 1x1 pixels directly,
+     * so the full image is never decoded for the thumbnail
+     */
+    tb_size_t denom = 8;
+    while (denom > 1 && (((image_width + denom - 1) / denom) < width || ((image_height + denom - 1) / denom) < height)) denom >>= 1;
+
+    // done
+    if (tb_setjmp(impl->jmpbuf)) return ;
+    impl->info.scale_num    = 1;
+    impl->info.scale_denom  = (tb_uint_t)denom;
+    jpeg_calc_output_dimensions(&impl->info);
+
+    // update the size
+    impl->base.width        = (tb_uint16_t)impl->info.output_width;
+    impl->base.height       = (tb_uint16_t)impl->info.output_height;
+
+    // trace
+    tb_trace_d("scale: 1/%lu, %lux%lu => %lux%lu", denom, image_width, image_height, (tb_size_t)impl->info.output_width, (tb_size_t)impl->info.output_height);
+}
+static tb_bool_t gb_bitmap_decoder_jpg_decode(gb_bitmap_decoder_impl_t* decoder, gb_bitmap_ref_t bitmap)
+{
+    // check
+    gb_bitmap_decoder_jpg_t* impl = (gb_bitmap_decoder_jpg_t*)decoder;
+    tb_assert_and_check_return_val(impl && impl->base.type == GB_BITMAP_TYPE_JPG && impl->created && bitmap, tb_false);
+
+    // failed?
+    if (tb_setjmp(impl->jmpbuf))
+    {
+        jpeg_abort_decompress(&impl->info);
+        return tb_false;
+    }
+
+    // the pixfmt of the bitmap
+    tb_size_t pixfmt = gb_bitmap_pixfmt(bitmap);
+
+    // the bitmap data
+    tb_byte_t* data = (tb_byte_t*)gb_bitmap_data(bitmap);
+    tb_assert_and_check_return_val(data, tb_false);
+
+    // start to decompress it
+    jpeg_start_decompress(&impl->info);
+
+    // the width and height
+    tb_size_t width         = impl->info.output_width;
+    tb_size_t height        = impl->info.output_height;
+    tb_size_t components    = impl->info.output_components;
+    tb_assert_and_check_return_val(components == 1 || components == 3 || components == 4, tb_false);
+
+    // clip the image to the bitmap
+    tb_size_t clip_width    = tb_min(width, gb_bitmap_width(bitmap));
+    tb_size_t clip_height   = tb_min(height, gb_bitmap_height(bitmap));
+    tb_size_t row_bytes     = gb_bitmap_row_bytes(bitmap);
+
+    // init the scanline, the gray and cmyk row will be converted to the rgb888 row in place
+    if (!impl->row) impl->row = (tb_byte_t*)tb_malloc(width * tb_max(components, 3));
+    tb_assert_and_check_return_val(impl->row, tb_false);
+
+    // read the visible scanlines only, the others need not be decoded
+    JSAMPROW    rows[1];
+    tb_size_t   y = 0;
+    for (y = 0; y < clip_height; y++)
+    {
+        // read it
+        rows[0] = impl->row;
+        if (jpeg_read_scanlines(&impl->info, rows, 1) != 1) break;
+
+        // the gray or cmyk row? convert it to the rgb888 row
+        if (components == 1) gb_bitmap_decoder_jpg_gray(impl->row, clip_width);
+        else if (components == 4) gb_bitmap_decoder_jpg_cmyk(impl->row, impl->row, clip_width);
+
+        // convert it
+        if (!gb_pixmap_convert(pixfmt, data + y * row_bytes, GB_PIXFMT_RGB888 | GB_PIXFMT_BENDIAN, impl->row, clip_width)) break;
+    }
+
+    // finish it
+    if (y == height) jpeg_finish_decompress(&impl->info);
+    else jpeg_abort_decompress(&impl->info);
+
+    // no alpha
+    gb_bitmap_set_alpha(bitmap, tb_false);
+
+    // ok?
+    return y == clip_height;
+}
+static tb_void_t gb_bitmap_decoder_jpg_exit(gb_bitmap_decoder_impl_t* decoder)
+{
+    // check
+    gb_bitmap_decoder_jpg_t* impl = (gb_bitmap_decoder_jpg_t*)decoder;
+    tb_assert_and_check_return(impl);
+
+    // exit the decompress info
+    if (impl->created) jpeg_destroy_decompress(&impl->info);
+    impl->created = tb_false;
+
+    // exit the scanline
+    if (impl->row) tb_free(impl->row);
+    impl->row = tb_null;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_size_t gb_bitmap_decoder_jpg_probe(tb_stream_ref_t stream)
+{
+    // check
+    tb_assert_and_check_return_val(stream, 0);
+
+    // need
+    tb_byte_t* p = tb_null;
+    if (!tb_stream_need(stream, &p, 3)) return 0;
+    tb_assert_and_check_return_val(p, 0);
+
+    // ok?
+    return (p[0] == 0xff && p[1] == 0xd8 && p[2] == 0xff)? 100 : 0;
+}
+gb_bitmap_decoder_ref_t gb_bitmap_decoder_jpg_init(tb_size_t pixfmt, tb_stream_ref_t stream)
+{
+    // check
+    tb_assert_and_check_return_val(GB_PIXFMT_OK(pixfmt) && stream, tb_null);
+
+    // make decoder
+    gb_bitmap_decoder_jpg_t* impl = tb_malloc0_type(gb_bitmap_decoder_jpg_t);
+    tb_assert_and_check_return_val(impl, tb_null);
+
+    // init decoder
+    impl->base.type     = GB_BITMAP_TYPE_JPG;
+    impl->base.stream   = stream;
+    impl->base.pixfmt   = (tb_uint16_t)pixfmt;
+    impl->base.decode   = gb_bitmap_decoder_jpg_decode;
+    impl->base.scale    = gb_bitmap_decoder_jpg_scale;
+    impl->base.exit     = gb_bitmap_decoder_jpg_exit;
+
+    // failed?
+    if (tb_setjmp(impl->jmpbuf))
+    {
+        gb_bitmap_decoder_exit((gb_bitmap_decoder_ref_t)impl);
+        return tb_null;
+    }
+
+    // init the error manager
+    impl->info.err                  = jpeg_std_error(&impl->error);
+    impl->error.error_exit          = gb_bitmap_decoder_jpg_error_exit;
+    impl->error.output_message      = gb_bitmap_decoder_jpg_output_message;
+    impl->info.client_data          = impl;
+
+    // init the decompress info
+    jpeg_create_decompress(&impl->info);
+    impl->created = tb_true;
+
+    // init the source manager
+    impl->source.init_source        = gb_bitmap_decoder_jpg_source_init;
+    impl->source.fill_input_buffer  = gb_bitmap_decoder_jpg_source_fill;
+    impl->source.skip_input_data    = gb_bitmap_decoder_jpg_source_skip;
+    impl->source.resync_to_restart  = jpeg_resync_to_restart;
+    impl->source.term_source        = gb_bitmap_decoder_jpg_source_term;
+    impl->info.src                  = &impl->source;
+
+    // read the header
+    jpeg_read_header(&impl->info, TRUE);
+    if (impl->info.image_width > GB_WIDTH_MAXN || impl->info.image_height > GB_HEIGHT_MAXN)
+    {
+        gb_bitmap_decoder_exit((gb_bitmap_decoder_ref_t)impl);
+        return tb_null;
+    }
+
+    // decode the gray and cmyk pixels and convert them manually, libjpeg converts the others to rgb
+    switch (impl->info.jpeg_color_space)
+    {
+    case JCS_GRAYSCALE:
+        impl->info.out_color_space = JCS_GRAYSCALE;
+        break;
+    case JCS_CMYK:
+    case JCS_YCCK:
+        impl->info.out_color_space = JCS_CMYK;
+        break;
+    default:
+        impl->info.out_color_space = JCS_RGB;
+        break;
+    }
+
+    // the output size
+    jpeg_calc_output_dimensions(&impl->info);
+    impl->base.width    = (tb_uint16_t)impl->info.output_width;
+    impl->base.height   = (tb_uint16_t)impl->info.output_height;
+
+    // trace
+    tb_trace_d("size: %lux%lu, components: %d", (tb_size_t)impl->base.width, (tb_size_t)impl->base.height, impl->info.num_components);
+
+    // ok
+    return (gb_bitmap_decoder_ref_t)impl;
+}
@@ -0,0 +1,774 @@
+/*!The Graphic Box Library
+ *
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox;
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ *
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        png.c
+ * @ingroup     core
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "png_decoder"
+#define TB_TRACE_MODULE_DEBUG           (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "zlib/zlib.h"
+#if defined(TB_COMPILER_IS_GCC) && TB_COMPILER_VERSION_BE(4, 9) && (defined(TB_ARCH_x86) || defined(TB_ARCH_x64))
+#   define GB_PNG_HAVE_SSE2
+#   include <emmintrin.h>
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the chunk types
+#define GB_PNG_CHUNK_IHDR               (0x49484452)
+#define GB_PNG_CHUNK_PLTE               (0x504c5445)
+#define GB_PNG_CHUNK_IDAT               (0x49444154)
+#define GB_PNG_CHUNK_IEND               (0x49454e44)
+#define GB_PNG_CHUNK_TRNS               (0x74524e53)
+
+// the color types
+#define GB_PNG_COLOR_GRAY               (0)
+#define GB_PNG_COLOR_RGB                (2)
+#define GB_PNG_COLOR_PALETTE            (3)
+#define GB_PNG_COLOR_GRAY_ALPHA         (4)
+#define GB_PNG_COLOR_RGBA               (6)
+
+// the filter types
+#define GB_PNG_FILTER_NONE              (0)
+#define GB_PNG_FILTER_SUB               (1)
+#define GB_PNG_FILTER_UP                (2)
+#define GB_PNG_FILTER_AVG               (3)
+#define GB_PNG_FILTER_PAETH             (4)
+
+// the input buffer size of the compressed data, only this part of the idat chunks is read at once
+#ifdef __gb_small__
+#   define GB_PNG_INPUT_MAXN            (4096)
+#else
+#   define GB_PNG_INPUT_MAXN            (16384)
+#endif
+
+// enable the instruction set for the given function and we need not any compile flags
+#ifdef GB_PNG_HAVE_SSE2
+#   define GB_PNG_TARGET(isa)           __attribute__((target(isa)))
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the png bitmap decoder type
+typedef struct __gb_bitmap_decoder_png_t
+{
+    // the base
+    gb_bitmap_decoder_impl_t    base;
+
+    // the bit depth of the sample
+    tb_uint8_t                  depth;
+
+    // the color type
+    tb_uint8_t                  color;
+
+    // is interlaced with adam7?
+    tb_uint8_t                  interlace;
+
+    // has the transparent color key?
+    tb_uint8_t                  has_key;
+
+    // has the alpha channel or the transparent palette?
+    tb_uint8_t                  has_alpha;
+
+    // the transparent color key of the gray or rgb samples
+    tb_uint16_t                 key[3];
+
+    // the palette with the rgba8888 bytes
+    tb_byte_t                   palette[256 << 2];
+
+    // the left size of the current idat chunk
+    tb_size_t                   idat_left;
+
+    // the inflate stream
+    z_stream                    zstream;
+
+    // the input data of the inflate stream
+    tb_byte_t                   input[GB_PNG_INPUT_MAXN];
+
+}gb_bitmap_decoder_png_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the adam7 passes: x0, y0, dx, dy
+static tb_byte_t const g_png_adam7[7][4] =
+{
+    {0, 0, 8, 8}
+,   {4, 0, 8, 8}
+,   {0, 4, 4, 8}
+,   {2, 0, 4, 4}
+,   {0, 2, 2, 4}
+,   {1, 0, 2, 2}
+,   {0, 1, 1, 2}
+};
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_size_t gb_bitmap_decoder_png_channels(tb_size_t color)
+{
+    switch (color)
+    {
+    case GB_PNG_COLOR_RGB:          return 3;
+    case GB_PNG_COLOR_GRAY_ALPHA:   return 2;
+    case GB_PNG_COLOR_RGBA:         return 4;
+    default:                        return 1;
+    }
+}
+static tb_bool_t gb_bitmap_decoder_png_fill(gb_bitmap_decoder_png_t* impl)
+{
+    // the stream
+    tb_stream_ref_t stream = impl->base.stream;
+
+    // the current idat chunk is finished? switch to the next idat chunk
+    while (!impl->idat_left)
+    {
+        // skip the crc of the current chunk
+        if (!tb_stream_skip(stream, 4)) return tb_false;
+
+        // the next chunk must be idat
+        tb_size_t size = tb_stream_bread_u32_be(stream);
+        tb_size_t type = tb_stream_bread_u32_be(stream);
+        tb_check_return_val(type == GB_PNG_CHUNK_IDAT, tb_false);
+
+        // update the left size
+        impl->idat_left = size;
+    }
+
+    // read the compressed data
+    tb_size_t size = tb_min(impl->idat_left, sizeof(impl->input));
+    if (!tb_stream_bread(stream, impl->input, size)) return tb_false;
+    impl->idat_left -= size;
+
+    // fill the inflate stream
+    impl->zstream.next_in   = impl->input;
+    impl->zstream.avail_in  = (uInt)size;
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t gb_bitmap_decoder_png_inflate(gb_bitmap_decoder_png_t* impl, tb_byte_t* data, tb_size_t size)
+{
+    // inflate the data of one row
+    z_stream* zstream = &impl->zstream;
+    zstream->next_out   = data;
+    zstream->avail_out  = (uInt)size;
+    while (zstream->avail_out)
+    {
+        // fill the compressed data
+        if (!zstream->avail_in && !gb_bitmap_decoder_png_fill(impl)) return tb_false;
+
+        // inflate it
+        tb_int_t ok = inflate(zstream, Z_NO_FLUSH);
+        if (ok == Z_STREAM_END) break;
+        tb_check_return_val(ok == Z_OK || ok == Z_BUF_ERROR, tb_false);
+    }
+
+    // ok?
+    return !zstream->avail_out;
+}
+static tb_void_t gb_bitmap_decoder_png_unfilter(tb_size_t filter, tb_byte_t* row, tb_byte_t const* prev, tb_size_t size, tb_size_t bpp)
+{
+    // done
+    tb_size_t i = 0;
+    switch (filter)
+    {
+    case GB_PNG_FILTER_SUB:
+        for (i = bpp; i < size; i++) row[i] += row[i - bpp];
+        break;
+    case GB_PNG_FILTER_UP:
+        for (i = 0; i < size; i++) row[i] += prev[i];
+        break;
+    case GB_PNG_FILTER_AVG:
+        for (i = 0; i < bpp; i++) row[i] += prev[i] >> 1;
+        for (; i < size; i++) row[i] += (row[i - bpp] + prev[i]) >> 1;
+        break;
+    case GB_PNG_FILTER_PAETH:
+        for (i = 0; i < bpp; i++) row[i] += prev[i];
+        for (; i < size; i++)
+        {
+            // the neighbours: a (left), b (up), c (upper left)
+            tb_long_t a     = row[i - bpp];
+            tb_long_t b     = prev[i];
+            tb_long_t c     = prev[i - bpp];
+            tb_long_t pa    = tb_abs(b - c);
+            tb_long_t pb    = tb_abs(a - c);
+            tb_long_t pc    = tb_abs(a + b - c - c);
+            row[i] += (pa <= pb && pa <= pc)? a : (pb <= pc? b : c);
+        }
+        break;
+    default:
+        break;
+    }
+}
+#ifdef GB_PNG_HAVE_SSE2
+static __tb_inline__ __m128i gb_bitmap_decoder_png_load(tb_byte_t const* p, tb_size_t bpp)
+{
+    // load the pixel of 3 or 4 bytes
+    tb_uint32_t v = 0;
+    tb_memcpy(&v, p, bpp);
+    return _mm_cvtsi32_si128((tb_int_t)v);
+}
+static __tb_inline__ tb_void_t gb_bitmap_decoder_png_save(tb_byte_t* p, __m128i v, tb_size_t bpp)
+{
+    // save the pixel of 3 or 4 bytes
+    tb_uint32_t u = (tb_uint32_t)_mm_cvtsi128_si32(v);
+    tb_memcpy(p, &u, bpp);
+}
+static __tb_inline__ __m128i gb_bitmap_decoder_png_if(__m128i c, __m128i t, __m128i e)
+{
+    return _mm_or_si128(_mm_and_si128(c, t), _mm_andnot_si128(c, e));
+}
+static __tb_inline__ __m128i gb_bitmap_decoder_png_abs(__m128i x)
+{
+    return _mm_max_epi16(x, _mm_sub_epi16(_mm_setzero_si128(), x));
+}
+GB_PNG_TARGET("sse2") static tb_void_t gb_bitmap_decoder_png_unfilter_sse2(tb_size_t filter, tb_byte_t* row, tb_byte_t const* prev, tb_size_t size, tb_size_t bpp)
+{
+    /* the rows of the rgb888 and rgba8888 pixels, one pixel is computed at once for sub, avg and paeth,
+     * because the left pixel must be decoded first
+     */
+    __m128i     a = _mm_setzero_si128();
+    __m128i     b;
+    __m128i     c = _mm_setzero_si128();
+    __m128i     d;
+    __m128i     z = _mm_setzero_si128();
+    tb_size_t   i = 0;
+    switch (filter)
+    {
+    case GB_PNG_FILTER_SUB:
+        for (i = 0; i < size; i += bpp)
+        {
+            a = _mm_add_epi8(a, gb_bitmap_decoder_png_load(row + i, bpp));
+            gb_bitmap_decoder_png_save(row + i, a, bpp);
+        }
+        break;
+    case GB_PNG_FILTER_UP:
+        for (; i + 16 <= size; i += 16)
+            _mm_storeu_si128((__m128i*)(row + i), _mm_add_epi8(_mm_loadu_si128((__m128i const*)(row + i)), _mm_loadu_si128((__m128i const*)(prev + i))));
+        for (; i < size; i++) row[i] += prev[i];
+        break;
+    case GB_PNG_FILTER_AVG:
+        for (i = 0; i < size; i += bpp)
+        {
+            // floor((a + b) / 2) = avg(a, b) - ((a ^ b) & 1)
+            b = gb_bitmap_decoder_png_load(prev + i, bpp);
+            d = _mm_sub_epi8(_mm_avg_epu8(a, b), _mm_and_si128(_mm_xor_si128(a, b), _mm_set1_epi8(1)));
+            a = _mm_add_epi8(d, gb_bitmap_decoder_png_load(row + i, bpp));
+            gb_bitmap_decoder_png_save(row + i, a, bpp);
+        }
+        break;
+    case GB_PNG_FILTER_PAETH:
+        for (i = 0; i < size; i += bpp)
+        {
+            // the neighbours with the 16-bits lanes
+            __m128i aw = _mm_unpacklo_epi8(a, z);
+            __m128i bw = _mm_unpacklo_epi8(b = gb_bitmap_decoder_png_load(prev + i, bpp), z);
+            __m128i cw = _mm_unpacklo_epi8(c, z);
+
+            // pa = |b - c|, pb = |a - c|, pc = |a + b - 2c|
+            __m128i pa = _mm_sub_epi16(bw, cw);
+            __m128i pb = _mm_sub_epi16(aw, cw);
+            __m128i pc = gb_bitmap_decoder_png_abs(_mm_add_epi16(pa, pb));
+            pa = gb_bitmap_decoder_png_abs(pa);
+            pb = gb_bitmap_decoder_png_abs(pb);
+
+            // select the nearest neighbour, a first, b second
+            __m128i m = _mm_min_epi16(pc, _mm_min_epi16(pa, pb));
+            d = gb_bitmap_decoder_png_if(_mm_cmpeq_epi16(m, pa), aw, gb_bitmap_decoder_png_if(_mm_cmpeq_epi16(m, pb), bw, cw));
+
+            // decode it
+            a = _mm_add_epi8(_mm_packus_epi16(d, d), gb_bitmap_decoder_png_load(row + i, bpp));
+            gb_bitmap_decoder_png_save(row + i, a, bpp);
+            c = b;
+        }
+        break;
+    default:
+        break;
+    }
+}
+#endif
+static tb_bool_t gb_bitmap_decoder_png_unfilter_row(tb_byte_t* row, tb_byte_t const* prev, tb_size_t size, tb_size_t bpp)
+{
+    // the filter type
+    tb_size_t filter = row[0];
+    tb_check_return_val(filter <= GB_PNG_FILTER_PAETH, tb_false);
+
+    // unfilter it
+#ifdef GB_PNG_HAVE_SSE2
+    static tb_long_t s_sse2 = -1;
+    if (s_sse2 < 0)
+    {
+        __builtin_cpu_init();
+        s_sse2 = __builtin_cpu_supports("sse2")? 1 : 0;
+    }
+    if (s_sse2 && (bpp == 3 || bpp == 4 || filter == GB_PNG_FILTER_UP))
+    {
+        gb_bitmap_decoder_png_unfilter_sse2(filter, row + 1, prev + 1, size, bpp);
+        return tb_true;
+    }
+#endif
+    gb_bitmap_decoder_png_unfilter(filter, row + 1, prev + 1, size, bpp);
+
+    // ok
+    return tb_true;
+}
+static tb_void_t gb_bitmap_decoder_png_expand(gb_bitmap_decoder_png_t* impl, tb_byte_t* d, tb_byte_t const* s, tb_size_t count)
+{
+    // the depth
+    tb_size_t   depth = impl->depth;
+    tb_size_t   i = 0;
+    tb_uint16_t v = 0;
+    switch (impl->color)
+    {
+    case GB_PNG_COLOR_GRAY:
+        {
+            // the scale of the gray for the low bit depth: 255 / (2^depth - 1)
+            tb_size_t scale = depth == 1? 0xff : (depth == 2? 0x55 : (depth == 4? 0x11 : 1));
+            for (i = 0; i < count; i++, d += 4)
+            {
+                if (depth == 16) v = (tb_uint16_t)((s[i << 1] << 8) | s[(i << 1) + 1]);
+                else if (depth == 8) v = s[i];
+                else v = (tb_uint16_t)tb_bits_get_ubits32(s + ((i * depth) >> 3), (i * depth) & 7, depth);
+                d[0] = d[1] = d[2] = (tb_byte_t)(depth == 16? (v >> 8) : v * scale);
+                d[3] = (impl->has_key && v == impl->key[0])? 0 : 0xff;
+            }
+        }
+        break;
+    case GB_PNG_COLOR_RGB:
+        for (i = 0; i < count; i++, d += 4)
+        {
+            if (depth == 16)
+            {
+                tb_byte_t const* p = s + i * 6;
+                d[0] = p[0]; d[1] = p[2]; d[2] = p[4];
+                d[3] = (    impl->has_key
+                        &&  ((p[0] << 8) | p[1]) == impl->key[0]
+                        &&  ((p[2] << 8) | p[3]) == impl->key[1]
+                        &&  ((p[4] << 8) | p[5]) == impl->key[2])? 0 : 0xff;
+            }
+            else
+            {
+                tb_byte_t const* p = s + i * 3;
+                d[0] = p[0]; d[1] = p[1]; d[2] = p[2];
+                d[3] = (impl->has_key && p[0] == impl->key[0] && p[1] == impl->key[1] && p[2] == impl->key[2])? 0 : 0xff;
+            }
+        }
+        break;
+    case GB_PNG_COLOR_PALETTE:
+        for (i = 0; i < count; i++, d += 4)
+        {
+            v = depth == 8? s[i] : (tb_uint16_t)tb_bits_get_ubits32(s + ((i * depth) >> 3), (i * depth) & 7, depth);
+            tb_memcpy(d, impl->palette + (v << 2), 4);
+        }
+        break;
+    case GB_PNG_COLOR_GRAY_ALPHA:
+        for (i = 0; i < count; i++, d += 4)
+        {
+            d[0] = d[1] = d[2] = s[depth == 16? (i << 2) : (i << 1)];
+            d[3] = s[depth == 16? (i << 2) + 2 : (i << 1) + 1];
+        }
+        break;
+    case GB_PNG_COLOR_RGBA:
+        for (i = 0; i < count; i++, d += 4, s += 8)
+        {
+            d[0] = s[0]; d[1] = s[2]; d[2] = s[4]; d[3] = s[6];
+        }
+        break;
+    default:
+        break;
+    }
+}
+static tb_bool_t gb_bitmap_decoder_png_convert(gb_bitmap_decoder_png_t* impl, tb_size_t pixfmt, tb_pointer_t data, tb_byte_t const* row, tb_byte_t* rgba, tb_size_t count, tb_size_t* has_alpha)
+{
+    // the rgb888 row? convert it directly
+    if (impl->color == GB_PNG_COLOR_RGB && impl->depth == 8 && !impl->has_key)
+        return gb_pixmap_convert(pixfmt, data, GB_PIXFMT_RGB888 | GB_PIXFMT_BENDIAN, row, count);
+
+    // expand the other rows to the rgba8888 pixels
+    tb_byte_t const* pixels = row;
+    if (impl->color != GB_PNG_COLOR_RGBA || impl->depth != 8)
+    {
+        gb_bitmap_decoder_png_expand(impl, rgba, row, count);
+        pixels = rgba;
+    }
+
+    // has alpha?
+    if (impl->has_alpha && !*has_alpha)
+    {
+        tb_size_t i = 0;
+        for (i = 0; i < count && pixels[(i << 2) + 3] == 0xff; i++) ;
+        *has_alpha = i < count;
+    }
+
+    // convert it
+    return gb_pixmap_convert(pixfmt, data, GB_PIXFMT_RGBA8888 | GB_PIXFMT_BENDIAN, pixels, count);
+}
+static tb_bool_t gb_bitmap_decoder_png_chunks(gb_bitmap_decoder_png_t* impl)
+{
+    // the stream
+    tb_stream_ref_t stream = impl->base.stream;
+
+    // read the chunks before the first idat chunk
+    while (1)
+    {
+        // the chunk
+        tb_size_t size = tb_stream_bread_u32_be(stream);
+        tb_size_t type = tb_stream_bread_u32_be(stream);
+
+        // idat? start to decode the pixels
+        if (type == GB_PNG_CHUNK_IDAT)
+        {
+            impl->idat_left = size;
+            break;
+        }
+        // plte?
+        else if (type == GB_PNG_CHUNK_PLTE)
+        {
+            tb_assert_and_check_return_val(size <= 768 && !(size % 3), tb_false);
+            tb_size_t i = 0;
+            tb_size_t n = size / 3;
+            for (i = 0; i < n; i++)
+            {
+                impl->palette[(i << 2)]     = tb_stream_bread_u8(stream);
+                impl->palette[(i << 2) + 1] = tb_stream_bread_u8(stream);
+                impl->palette[(i << 2) + 2] = tb_stream_bread_u8(stream);
+            }
+            size = 0;
+        }
+        // trns?
+        else if (type == GB_PNG_CHUNK_TRNS)
+        {
+            if (impl->color == GB_PNG_COLOR_PALETTE)
+            {
+                tb_assert_and_check_return_val(size <= 256, tb_false);
+                tb_size_t i = 0;
+                for (i = 0; i < size; i++) impl->palette[(i << 2) + 3] = tb_stream_bread_u8(stream);
+                impl->has_alpha = 1;
+                size = 0;
+            }
+            else if (impl->color == GB_PNG_COLOR_GRAY && size == 2)
+            {
+                impl->key[0]    = tb_stream_bread_u16_be(stream);
+                impl->has_key   = 1;
+                impl->has_alpha = 1;
+                size = 0;
+            }
+            else if (impl->color == GB_PNG_COLOR_RGB && size == 6)
+            {
+                impl->key[0]    = tb_stream_bread_u16_be(stream);
+                impl->key[1]    = tb_stream_bread_u16_be(stream);
+                impl->key[2]    = tb_stream_bread_u16_be(stream);
+                impl->has_key   = 1;
+                impl->has_alpha = 1;
+                size = 0;
+            }
+        }
+        // iend? no pixels
+        else if (type == GB_PNG_CHUNK_IEND) return tb_false;
+
+        // skip the left data and the crc
+        if (!tb_stream_skip(stream, size + 4)) return tb_false;
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t gb_bitmap_decoder_png_decode(gb_bitmap_decoder_impl_t* decoder, gb_bitmap_ref_t bitmap)
+{
+    // check
+    gb_bitmap_decoder_png_t* impl = (gb_bitmap_decoder_png_t*)decoder;
+    tb_assert_and_check_return_val(impl && impl->base.type == GB_BITMAP_TYPE_PNG && bitmap, tb_false);
+
+    // done
+    tb_bool_t   ok = tb_false;
+    tb_bool_t   inited = tb_false;
+    tb_byte_t*  buffer = tb_null;
+    do
+    {
+        // the pixfmt of the bitmap
+        tb_size_t pixfmt = gb_bitmap_pixfmt(bitmap);
+        gb_pixmap_ref_t dp = gb_pixmap(pixfmt, 0xff);
+        tb_assert_and_check_break(dp);
+
+        // the bitmap data
+        tb_byte_t* data = (tb_byte_t*)gb_bitmap_data(bitmap);
+        tb_assert_and_check_break(data);
+
+        // read the palette and the transparency
+        if (!gb_bitmap_decoder_png_chunks(impl)) break;
+
+        // the alpha channel?
+        if (impl->color == GB_PNG_COLOR_GRAY_ALPHA || impl->color == GB_PNG_COLOR_RGBA) impl->has_alpha = 1;
+
+        // init the inflate stream
+        tb_memset(&impl->zstream, 0, sizeof(z_stream));
+        if (inflateInit(&impl->zstream) != Z_OK) break;
+        inited = tb_true;
+
+        // the width and height
+        tb_size_t width         = impl->base.width;
+        tb_size_t height        = impl->base.height;
+
+        // the bits and bytes per pixel, the bytes is 1 at least for the filters
+        tb_size_t bits          = gb_bitmap_decoder_png_channels(impl->color) * impl->depth;
+        tb_size_t bpp           = tb_max(bits >> 3, 1);
+
+        // clip the image to the bitmap
+        tb_size_t clip_width    = tb_min(width, gb_bitmap_width(bitmap));
+        tb_size_t clip_height   = gb_bitmap_height(bitmap);
+        tb_size_t row_bytes     = gb_bitmap_row_bytes(bitmap);
+        tb_size_t btp           = dp->btp;
+
+        /* init the buffer
+         *
+         * - the current and previous rows with the filter byte
+         * - the rgba8888 pixels of one row
+         * - the converted pixels of one interlaced row
+         */
+        tb_size_t size  = ((width * bits + 7) >> 3) + 1;
+        buffer = (tb_byte_t*)tb_malloc((size << 1) + (width << 2) + (impl->interlace? width * btp : 0));
+        tb_assert_and_check_break(buffer);
+
+        // the rows
+        tb_byte_t*  row     = buffer;
+        tb_byte_t*  prev    = buffer + size;
+        tb_byte_t*  rgba    = prev + size;
+        tb_byte_t*  pixels  = rgba + (width << 2);
+
+        // done the passes
+        tb_size_t   has_alpha = 0;
+        tb_size_t   i = 0;
+        tb_size_t   j = 0;
+        tb_size_t   n = 0;
+        tb_size_t   x0 = 0;
+        tb_size_t   y0 = 0;
+        tb_size_t   dx = 1;
+        tb_size_t   dy = 1;
+        tb_size_t   passes = impl->interlace? 7 : 1;
+        tb_size_t   pass = 0;
+        tb_bool_t   failed = tb_false;
+        for (pass = 0; pass < passes && !failed; pass++)
+        {
+            // the pass
+            if (impl->interlace)
+            {
+                x0 = g_png_adam7[pass][0];
+                y0 = g_png_adam7[pass][1];
+                dx = g_png_adam7[pass][2];
+                dy = g_png_adam7[pass][3];
+            }
+
+            // the size of this pass
+            tb_size_t pw = width > x0? (width - x0 + dx - 1) / dx : 0;
+            tb_size_t ph = height > y0? (height - y0 + dy - 1) / dy : 0;
+            tb_check_continue(pw && ph);
+
+            // the visible pixels of this pass
+            tb_size_t count = clip_width > x0? (clip_width - x0 + dx - 1) / dx : 0;
+
+            // the row bytes of this pass
+            tb_size_t pass_bytes = (pw * bits + 7) >> 3;
+
+            // clear the previous row for the first row
+            tb_memset(prev, 0, pass_bytes + 1);
+
+            // done the rows
+            for (j = 0; j < ph; j++)
+            {
+                // inflate and unfilter it
+                if (    !gb_bitmap_decoder_png_inflate(impl, row, pass_bytes + 1)
+                    ||  !gb_bitmap_decoder_png_unfilter_row(row, prev, pass_bytes, bpp))
+                {
+                    failed = tb_true;
+                    break;
+                }
+
+                // the row of the bitmap
+                tb_size_t y = y0 + j * dy;
+                if (y < clip_height && count)
+                {
+                    // convert to the bitmap row directly
+                    tb_byte_t* d = data + y * row_bytes;
+                    if (dx == 1)
+                    {
+                        if (!gb_bitmap_decoder_png_convert(impl, pixfmt, d, row + 1, rgba, count, &has_alpha))
+                        {
+                            failed = tb_true;
+                            break;
+                        }
+                    }
+                    // convert and scatter the interlaced pixels
+                    else
+                    {
+                        if (!gb_bitmap_decoder_png_convert(impl, pixfmt, pixels, row + 1, rgba, count, &has_alpha))
+                        {
+                            failed = tb_true;
+                            break;
+                        }
+                        for (i = 0, n = x0 * btp; i < count; i++, n += dx * btp) tb_memcpy(d + n, pixels + i * btp, btp);
+                    }
+                }
+
+                // swap the rows
+                tb_swap(tb_byte_t*, row, prev);
+            }
+        }
+        tb_check_break(!failed);
+
+        // set alpha
+        gb_bitmap_set_alpha(bitmap, (has_alpha && GB_PIXFMT_HAS_ALPHA(pixfmt))? tb_true : tb_false);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // exit the inflate stream
+    if (inited) inflateEnd(&impl->zstream);
+
+    // exit the buffer
+    if (buffer) tb_free(buffer);
+    buffer = tb_null;
+
+    // ok?
+    return ok;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_size_t gb_bitmap_decoder_png_probe(tb_stream_ref_t stream)
+{
+    // check
+    tb_assert_and_check_return_val(stream, 0);
+
+    // need
+    tb_byte_t* p = tb_null;
+    if (!tb_stream_need(stream, &p, 8)) return 0;
+    tb_assert_and_check_return_val(p, 0);
+
+    // ok?
+    return (    p[0] == 0x89 && p[1] == 'P' && p[2] == 'N' && p[3] == 'G'
+            &&  p[4] == '\r' && p[5] == '\n' && p[6] == 0x1a && p[7] == '\n')? 100 : 0;
+}
+gb_bitmap_decoder_ref_t gb_bitmap_decoder_png_init(tb_size_t pixfmt, tb_stream_ref_t stream)
+{
+    // check
+    tb_assert_and_check_return_val(GB_PIXFMT_OK(pixfmt) && stream, tb_null);
+
+    // done
+    tb_bool_t                   ok = tb_false;
+    gb_bitmap_decoder_png_t*    impl = tb_null;
+    do
+    {
+        // skip the signature
+        if (!tb_stream_skip(stream, 8)) break;
+
+        // the ihdr chunk
+        tb_size_t size = tb_stream_bread_u32_be(stream);
+        tb_size_t type = tb_stream_bread_u32_be(stream);
+        tb_assert_and_check_break(size == 13 && type == GB_PNG_CHUNK_IHDR);
+
+        // read the header
+        tb_size_t width         = tb_stream_bread_u32_be(stream);
+        tb_size_t height        = tb_stream_bread_u32_be(stream);
+        tb_size_t depth         = tb_stream_bread_u8(stream);
+        tb_size_t color         = tb_stream_bread_u8(stream);
+        tb_size_t compression   = tb_stream_bread_u8(stream);
+        tb_size_t filter        = tb_stream_bread_u8(stream);
+        tb_size_t interlace     = tb_stream_bread_u8(stream);
+        tb_assert_and_check_break(width && height && width <= GB_WIDTH_MAXN && height <= GB_HEIGHT_MAXN);
+        tb_assert_and_check_break(!compression && !filter && interlace <= 1);
+
+        // check the bit depth of the color type
+        switch (color)
+        {
+        case GB_PNG_COLOR_GRAY:
+            tb_assert_and_check_break(depth == 1 || depth == 2 || depth == 4 || depth == 8 || depth == 16);
+            break;
+        case GB_PNG_COLOR_PALETTE:
+            tb_assert_and_check_break(depth == 1 || depth == 2 || depth == 4 || depth == 8);
+            break;
+        case GB_PNG_COLOR_RGB:
+        case GB_PNG_COLOR_GRAY_ALPHA:
+        case GB_PNG_COLOR_RGBA:
+            tb_assert_and_check_break(depth == 8 || depth == 16);
+            break;
+        default:
+            depth = 0;
+            break;
+        }
+        tb_assert_and_check_break(depth);
+
+        // skip the crc
+        if (!tb_stream_skip(stream, 4)) break;
+
+        // trace
+        tb_trace_d("size: %lux%lu, depth: %lu, color: %lu, interlace: %lu", width, height, depth, color, interlace);
+
+        // make decoder
+        impl = tb_malloc0_type(gb_bitmap_decoder_png_t);
+        tb_assert_and_check_break(impl);
+
+        // init decoder
+        impl->base.type     = GB_BITMAP_TYPE_PNG;
+        impl->base.stream   = stream;
+        impl->base.pixfmt   = (tb_uint16_t)pixfmt;
+        impl->base.width    = (tb_uint16_t)width;
+        impl->base.height   = (tb_uint16_t)height;
+        impl->base.decode   = gb_bitmap_decoder_png_decode;
+        impl->depth         = (tb_uint8_t)depth;
+        impl->color         = (tb_uint8_t)color;
+        impl->interlace     = (tb_uint8_t)interlace;
+
+        // init the palette, the missing entries are opaque black
+        tb_size_t i = 0;
+        for (i = 0; i < 256; i++) impl->palette[(i << 2) + 3] = 0xff;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (impl) gb_bitmap_decoder_exit((gb_bitmap_decoder_ref_t)impl);
+        impl = tb_null;
+    }
+
+    // ok?
+    return (gb_bitmap_decoder_ref_t)impl;
+}
@@ -57,8 +57,17 @@ typedef struct __gb_bitmap_decoder_impl_t
     // the stream
     tb_stream_ref_t stream;
 
-    // done
-    gb_bitmap_ref_t (*done)(struct __gb_bitmap_decoder_impl_t* decoder);
+    /* decode the image into the bitmap
+     *
+     * the image will be converted to the pixfmt of the bitmap and clipped to its size
+     */
+    tb_bool_t       (*decode)(struct __gb_bitmap_decoder_impl_t* decoder, gb_bitmap_ref_t bitmap);
+
+    /* scale the image to the smallest native size which is not smaller than the given size, optional
+     *
+     * the width and height of the decoder will be updated to the scaled size
+     */
+    tb_void_t       (*scale)(struct __gb_bitmap_decoder_impl_t* decoder, tb_size_t width, tb_size_t height);
 
     // free
     tb_void_t       (*exit)(struct __gb_bitmap_decoder_impl_t* decoder);
@@ -85,6 +94,59 @@ tb_size_t               gb_bitmap_decoder_bmp_probe(tb_stream_ref_t stream);
  */
 gb_bitmap_decoder_ref_t  gb_bitmap_decoder_bmp_init(tb_size_t pixfmt, tb_stream_ref_t stream);
 
+#ifdef GB_CONFIG_PACKAGE_HAVE_ZLIB
+/* probe png bitmap foramt
+ *
+ * @param stream        the stream
+ *
+ * @return              the score: [0, 100]
+ */
+tb_size_t               gb_bitmap_decoder_png_probe(tb_stream_ref_t stream);
+
+/* init png bitmap decoder
+ *
+ * @param pixfmt        the pixfmt
+ * @param stream        the stream
+ *
+ * @return              the decoder
+ */
+gb_bitmap_decoder_ref_t  gb_bitmap_decoder_png_init(tb_size_t pixfmt, tb_stream_ref_t stream);
+#endif
+
+#ifdef GB_CONFIG_PACKAGE_HAVE_JPEG
+/* probe jpg bitmap foramt
+ *
+ * @param stream        the stream
+ *
+ * @return              the score: [0, 100]
+ */
+tb_size_t               gb_bitmap_decoder_jpg_probe(tb_stream_ref_t stream);
+
+/* init jpg bitmap decoder
+ *
+ * @param pixfmt        the pixfmt
+ * @param stream        the stream
+ *
+ * @return              the decoder
+ */
+gb_bitmap_decoder_ref_t  gb_bitmap_decoder_jpg_init(tb_size_t pixfmt, tb_stream_ref_t stream);
+#endif
+
+/* the plain bmp data which can be used as the bitmap data directly
+ *
+ * only the uncompressed top-down 32-bits bmp with the same pixfmt and the pixels aligned by four bytes can be used,
+ * and the argb8888 bmp must have the alpha mask, so the bitmap has alpha if the pixfmt has alpha
+ *
+ * @param data          the bmp file data
+ * @param size          the bmp file size
+ * @param pixfmt        the pixfmt
+ * @param pwidth        the width
+ * @param pheight       the height
+ *
+ * @return              the offset of the pixels, return 0 if not be plain
+ */
+tb_size_t               gb_bitmap_decoder_bmp_plain(tb_byte_t const* data, tb_size_t size, tb_size_t pixfmt, tb_size_t* pwidth, tb_size_t* pheight);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
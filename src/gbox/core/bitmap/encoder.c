@@ -0,0 +1,90 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        encoder.c
+ * @ingroup     core
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "encoder.h"
+#include "encoder/prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+gb_bitmap_encoder_ref_t gb_bitmap_encoder_init(tb_size_t type, tb_stream_ref_t stream)
+{
+    // check
+    tb_assert_and_check_return_val(stream, tb_null);
+
+    // init it
+    gb_bitmap_encoder_ref_t encoder = tb_null;
+    switch (type)
+    {
+    case GB_BITMAP_TYPE_PPM:
+        encoder = gb_bitmap_encoder_ppm_init(stream);
+        break;
+    case GB_BITMAP_TYPE_BMP:
+        encoder = gb_bitmap_encoder_bmp_init(stream);
+        break;
+#ifdef GB_CONFIG_PACKAGE_HAVE_ZLIB
+    case GB_BITMAP_TYPE_PNG:
+        encoder = gb_bitmap_encoder_png_init(stream);
+        break;
+#endif
+    default:
+        tb_trace_e("the bitmap type: %lu is not supported for encoding", type);
+        break;
+    }
+
+    // ok?
+    return encoder;
+}
+tb_void_t gb_bitmap_encoder_exit(gb_bitmap_encoder_ref_t encoder)
+{
+    // check
+    gb_bitmap_encoder_impl_t* impl = (gb_bitmap_encoder_impl_t*)encoder;
+    tb_assert_and_check_return(impl);
+
+    // exit encoder
+    if (impl->exit) impl->exit(impl);
+
+    // exit it
+    tb_free(encoder);
+}
+tb_void_t gb_bitmap_encoder_pool_set(gb_bitmap_encoder_ref_t encoder, tb_thread_pool_ref_t pool)
+{
+    // check
+    gb_bitmap_encoder_impl_t* impl = (gb_bitmap_encoder_impl_t*)encoder;
+    tb_assert_and_check_return(impl);
+
+    // set the thread pool
+    impl->pool = pool;
+}
+tb_bool_t gb_bitmap_encoder_done(gb_bitmap_encoder_ref_t encoder, gb_bitmap_ref_t bitmap)
+{
+    // check
+    gb_bitmap_encoder_impl_t* impl = (gb_bitmap_encoder_impl_t*)encoder;
+    tb_assert_and_check_return_val(impl && impl->done && bitmap && gb_bitmap_data(bitmap), tb_false);
+
+    // encode it and flush the cached data of the stream
+    return impl->done(impl, bitmap) && tb_stream_sync(impl->stream, tb_false);
+}
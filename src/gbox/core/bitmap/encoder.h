@@ -0,0 +1,91 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        encoder.h
+ * @ingroup     core
+ *
+ */
+#ifndef GB_CORE_BITMAP_ENCODER_H
+#define GB_CORE_BITMAP_ENCODER_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the bitmap encoder ref type
+typedef struct{}*       gb_bitmap_encoder_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init bitmap encoder
+ *
+ * @param type          the bitmap type, e.g. GB_BITMAP_TYPE_PPM, GB_BITMAP_TYPE_BMP and GB_BITMAP_TYPE_PNG
+ * @param stream        the opened stream for writing
+ *
+ * @return              the encoder, return tb_null if this type is not supported
+ */
+gb_bitmap_encoder_ref_t  gb_bitmap_encoder_init(tb_size_t type, tb_stream_ref_t stream);
+
+/*! exit bitmap encoder
+ *
+ * @param encoder       encoder
+ */
+tb_void_t               gb_bitmap_encoder_exit(gb_bitmap_encoder_ref_t encoder);
+
+/*! set the thread pool for encoding the bitmap concurrently
+ *
+ * the png encoder will split the large image into the row groups and deflate them on this pool,
+ * the others ignore it.
+ *
+ * @param encoder       encoder
+ * @param pool          the thread pool, uses the serial encoding if be null
+ */
+tb_void_t               gb_bitmap_encoder_pool_set(gb_bitmap_encoder_ref_t encoder, tb_thread_pool_ref_t pool);
+
+/*! encode the bitmap to the stream
+ *
+ * the rows are converted from the pixfmt of the bitmap while encoding them,
+ * and the alpha is kept only if the bitmap has alpha and the format supports it
+ *
+ * @param encoder       encoder
+ * @param bitmap        the bitmap
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               gb_bitmap_encoder_done(gb_bitmap_encoder_ref_t encoder, gb_bitmap_ref_t bitmap);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+#endif
+
+
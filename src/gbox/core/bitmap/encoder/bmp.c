@@ -0,0 +1,205 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        bmp.c
+ * @ingroup     core
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "bmp_encoder"
+#define TB_TRACE_MODULE_DEBUG           (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the size of the file header and the info header
+#define GB_BMP_HEADER_SIZE              (54)
+
+// the size of the file header and the v4 info header with the bitfields masks for the 32-bits pixels
+#define GB_BMP_HEADER_SIZE_V4           (122)
+
+// the bitfields compression for the 32-bits pixels
+#define GB_BMP_BITFIELDS                (3)
+
+/* the offset of the 32-bits pixels
+ *
+ * the pixels are aligned by 4 bytes, so the file can be mapped as the bitmap data directly on all arches
+ */
+#define GB_BMP_OFFSET_PIXELS32          (124)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_bool_t gb_bitmap_encoder_bmp_done(gb_bitmap_encoder_impl_t* encoder, gb_bitmap_ref_t bitmap)
+{
+    // check
+    tb_assert_and_check_return_val(encoder && encoder->type == GB_BITMAP_TYPE_BMP && encoder->stream && bitmap, tb_false);
+
+    // the bitmap info
+    tb_size_t       width       = gb_bitmap_width(bitmap);
+    tb_size_t       height      = gb_bitmap_height(bitmap);
+    tb_size_t       pixfmt      = gb_bitmap_pixfmt(bitmap);
+    tb_size_t       row_bytes   = gb_bitmap_row_bytes(bitmap);
+    tb_byte_t const* data       = (tb_byte_t const*)gb_bitmap_data(bitmap);
+    tb_assert_and_check_return_val(width && height && data, tb_false);
+
+    /* the pixfmt of the bmp rows
+     *
+     * write the 32-bits rows if the bitmap has alpha or it is already xrgb8888 or argb8888,
+     * otherwise write the 24-bits rows which are padded to 4 bytes
+     */
+    tb_size_t       bmp_fmt     = 0;
+    tb_size_t       bmp_bpp     = 0;
+    tb_size_t       bmp_offset  = 0;
+    tb_size_t       bmp_header  = GB_BMP_HEADER_SIZE;
+    if (gb_bitmap_has_alpha(bitmap) || pixfmt == GB_PIXFMT_XRGB8888 || pixfmt == GB_PIXFMT_ARGB8888)
+    {
+        bmp_fmt     = gb_bitmap_has_alpha(bitmap)? GB_PIXFMT_ARGB8888 : GB_PIXFMT_XRGB8888;
+        bmp_bpp     = 32;
+        bmp_offset  = GB_BMP_OFFSET_PIXELS32;
+        bmp_header  = GB_BMP_HEADER_SIZE_V4;
+    }
+    else
+    {
+        bmp_fmt     = GB_PIXFMT_RGB888;
+        bmp_bpp     = 24;
+        bmp_offset  = GB_BMP_HEADER_SIZE;
+    }
+    tb_size_t       bmp_row_bytes = tb_align4(width * (bmp_bpp >> 3));
+    tb_size_t       bmp_size    = bmp_row_bytes * height;
+
+    // done
+    tb_bool_t       ok = tb_false;
+    tb_byte_t*      row = tb_null;
+    tb_stream_ref_t stream = encoder->stream;
+    do
+    {
+        // write the file header
+        if (!tb_stream_bwrit(stream, (tb_byte_t const*)"BM", 2)) break;
+        if (!tb_stream_bwrit_u32_le(stream, (tb_uint32_t)(bmp_offset + bmp_size))) break;
+        if (!tb_stream_bwrit_u32_le(stream, 0)) break;
+        if (!tb_stream_bwrit_u32_le(stream, (tb_uint32_t)bmp_offset)) break;
+
+        // write the info header, the rows are stored from top to bottom with the negative height
+        if (!tb_stream_bwrit_u32_le(stream, (tb_uint32_t)(bmp_header - 14))) break;
+        if (!tb_stream_bwrit_u32_le(stream, (tb_uint32_t)width)) break;
+        if (!tb_stream_bwrit_u32_le(stream, (tb_uint32_t)-(tb_int32_t)height)) break;
+        if (!tb_stream_bwrit_u16_le(stream, 1)) break;
+        if (!tb_stream_bwrit_u16_le(stream, (tb_uint16_t)bmp_bpp)) break;
+        if (!tb_stream_bwrit_u32_le(stream, bmp_bpp == 32? GB_BMP_BITFIELDS : 0)) break;
+        if (!tb_stream_bwrit_u32_le(stream, (tb_uint32_t)bmp_size)) break;
+        if (!tb_stream_bwrit_u32_le(stream, 2835)) break;
+        if (!tb_stream_bwrit_u32_le(stream, 2835)) break;
+        if (!tb_stream_bwrit_u32_le(stream, 0)) break;
+        if (!tb_stream_bwrit_u32_le(stream, 0)) break;
+
+        /* write the rest of the v4 info header for the 32-bits pixels
+         *
+         * the alpha mask tells the decoder whether the pixels have alpha without scanning them
+         */
+        if (bmp_bpp == 32)
+        {
+            // write the r, g, b and alpha masks
+            if (!tb_stream_bwrit_u32_le(stream, 0xff0000)) break;
+            if (!tb_stream_bwrit_u32_le(stream, 0xff00)) break;
+            if (!tb_stream_bwrit_u32_le(stream, 0xff)) break;
+            if (!tb_stream_bwrit_u32_le(stream, bmp_fmt == GB_PIXFMT_ARGB8888? 0xff000000 : 0)) break;
+
+            // write the color space: "sRGB", the endpoints and gamma are ignored
+            if (!tb_stream_bwrit_u32_le(stream, 0x73524742)) break;
+            tb_size_t i = 0;
+            for (i = 0; i < 12; i++)
+            {
+                if (!tb_stream_bwrit_u32_le(stream, 0)) break;
+            }
+            tb_check_break(i == 12);
+        }
+
+        // write the padding before the pixels
+        if (bmp_offset > bmp_header && !tb_stream_bwrit(stream, (tb_byte_t const*)"\0\0\0\0", bmp_offset - bmp_header)) break;
+
+        // write the bitmap rows directly if the pixfmt is the same, otherwise convert them
+        tb_bool_t same = (pixfmt == bmp_fmt && bmp_row_bytes == width * (bmp_bpp >> 3));
+        if (!same)
+        {
+            // make the row buffer with the zero padding
+            row = (tb_byte_t*)tb_malloc0(bmp_row_bytes);
+            tb_assert_and_check_break(row);
+        }
+
+        // write rows
+        tb_size_t j = 0;
+        for (j = 0; j < height; j++, data += row_bytes)
+        {
+            // write it
+            if (same)
+            {
+                if (!tb_stream_bwrit(stream, data, bmp_row_bytes)) break;
+            }
+            else
+            {
+                // convert this row
+                if (!gb_pixmap_convert(bmp_fmt, row, pixfmt, data, width)) break;
+
+                // write it
+                if (!tb_stream_bwrit(stream, row, bmp_row_bytes)) break;
+            }
+        }
+        tb_check_break(j == height);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // exit the row buffer
+    if (row) tb_free(row);
+
+    // ok?
+    return ok;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+gb_bitmap_encoder_ref_t gb_bitmap_encoder_bmp_init(tb_stream_ref_t stream)
+{
+    // check
+    tb_assert_and_check_return_val(stream, tb_null);
+
+    // make encoder
+    gb_bitmap_encoder_impl_t* impl = tb_malloc0_type(gb_bitmap_encoder_impl_t);
+    tb_assert_and_check_return_val(impl, tb_null);
+
+    // init encoder
+    impl->type      = GB_BITMAP_TYPE_BMP;
+    impl->stream    = stream;
+    impl->done      = gb_bitmap_encoder_bmp_done;
+
+    // ok
+    return (gb_bitmap_encoder_ref_t)impl;
+}
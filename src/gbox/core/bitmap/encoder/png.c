@@ -0,0 +1,546 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        png.c
+ * @ingroup     core
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "png_encoder"
+#define TB_TRACE_MODULE_DEBUG           (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "zlib/zlib.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the chunk types
+#define GB_PNG_CHUNK_IHDR               (0x49484452)
+#define GB_PNG_CHUNK_IDAT               (0x49444154)
+#define GB_PNG_CHUNK_IEND               (0x49454e44)
+
+// the color types
+#define GB_PNG_COLOR_RGB                (2)
+#define GB_PNG_COLOR_RGBA               (6)
+
+// the filter types
+#define GB_PNG_FILTER_NONE              (0)
+#define GB_PNG_FILTER_SUB               (1)
+#define GB_PNG_FILTER_UP                (2)
+#define GB_PNG_FILTER_AVG               (3)
+#define GB_PNG_FILTER_PAETH             (4)
+
+// the compression level
+#define GB_PNG_LEVEL                    (Z_DEFAULT_COMPRESSION)
+
+// the window size of the deflate stream, the previous group is used as the dictionary of this size
+#define GB_PNG_WINDOW                   (32768)
+
+// the output buffer size of the serial encoding, an idat chunk is written when it is full
+#ifdef __gb_small__
+#   define GB_PNG_OUTPUT_MAXN           (4096)
+#else
+#   define GB_PNG_OUTPUT_MAXN           (16384)
+#endif
+
+// the minimum filtered bytes of the row group for encoding concurrently
+#define GB_PNG_GROUP_SIZE_MINN          (131072)
+
+// the maximum count of the row groups
+#define GB_PNG_GROUPS_MAXN              (16)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the png bitmap encoder group type
+typedef struct __gb_bitmap_encoder_png_group_t
+{
+    // the encoder
+    struct __gb_bitmap_encoder_png_t*   encoder;
+
+    // the task
+    tb_thread_pool_task_ref_t           task;
+
+    // the top row
+    tb_size_t                           top;
+
+    // the bottom row
+    tb_size_t                           bottom;
+
+    // the compressed data
+    tb_byte_t*                          data;
+
+    // the compressed size
+    tb_size_t                           size;
+
+    // the compressed maxn
+    tb_size_t                           maxn;
+
+    // the adler32 of the filtered rows
+    tb_uint32_t                         adler;
+
+    // ok?
+    tb_bool_t                           ok;
+
+}gb_bitmap_encoder_png_group_t;
+
+// the png bitmap encoder type
+typedef struct __gb_bitmap_encoder_png_t
+{
+    // the base
+    gb_bitmap_encoder_impl_t            base;
+
+    // the bitmap
+    gb_bitmap_ref_t                     bitmap;
+
+    // the pixfmt of the png samples
+    tb_size_t                           pixfmt;
+
+    // the bytes per pixel of the png samples
+    tb_size_t                           btp;
+
+    // the bytes of the png row without the filter type
+    tb_size_t                           stride;
+
+    // the groups count
+    tb_size_t                           count;
+
+    // the row groups
+    gb_bitmap_encoder_png_group_t       groups[GB_PNG_GROUPS_MAXN];
+
+}gb_bitmap_encoder_png_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_byte_t gb_bitmap_encoder_png_paeth(tb_byte_t a, tb_byte_t b, tb_byte_t c)
+{
+    // the predictor
+    tb_long_t p = (tb_long_t)a + b - c;
+    tb_long_t pa = tb_abs(p - a);
+    tb_long_t pb = tb_abs(p - b);
+    tb_long_t pc = tb_abs(p - c);
+    return (pa <= pb && pa <= pc)? a : (pb <= pc? b : c);
+}
+static tb_size_t gb_bitmap_encoder_png_filter(tb_byte_t* out, tb_size_t filter, tb_byte_t const* cur, tb_byte_t const* prev, tb_size_t size, tb_size_t btp)
+{
+    // filter it and compute the sum of the absolute signed bytes
+    tb_size_t   i = 0;
+    tb_size_t   sum = 0;
+    tb_byte_t   b = 0;
+    out[0] = (tb_byte_t)filter;
+    out++;
+    switch (filter)
+    {
+    case GB_PNG_FILTER_NONE:
+        for (i = 0; i < size; i++) { b = cur[i]; out[i] = b; sum += tb_abs((tb_sint8_t)b); }
+        break;
+    case GB_PNG_FILTER_SUB:
+        for (i = 0; i < btp; i++) { b = cur[i]; out[i] = b; sum += tb_abs((tb_sint8_t)b); }
+        for (; i < size; i++) { b = (tb_byte_t)(cur[i] - cur[i - btp]); out[i] = b; sum += tb_abs((tb_sint8_t)b); }
+        break;
+    case GB_PNG_FILTER_UP:
+        for (i = 0; i < size; i++) { b = (tb_byte_t)(cur[i] - prev[i]); out[i] = b; sum += tb_abs((tb_sint8_t)b); }
+        break;
+    case GB_PNG_FILTER_AVG:
+        for (i = 0; i < btp; i++) { b = (tb_byte_t)(cur[i] - (prev[i] >> 1)); out[i] = b; sum += tb_abs((tb_sint8_t)b); }
+        for (; i < size; i++) { b = (tb_byte_t)(cur[i] - ((cur[i - btp] + prev[i]) >> 1)); out[i] = b; sum += tb_abs((tb_sint8_t)b); }
+        break;
+    case GB_PNG_FILTER_PAETH:
+        for (i = 0; i < btp; i++) { b = (tb_byte_t)(cur[i] - prev[i]); out[i] = b; sum += tb_abs((tb_sint8_t)b); }
+        for (; i < size; i++) { b = (tb_byte_t)(cur[i] - gb_bitmap_encoder_png_paeth(cur[i - btp], prev[i], prev[i - btp])); out[i] = b; sum += tb_abs((tb_sint8_t)b); }
+        break;
+    default:
+        tb_assert(0);
+        break;
+    }
+
+    // the sum
+    return sum;
+}
+static tb_bool_t gb_bitmap_encoder_png_row(gb_bitmap_encoder_png_t* impl, tb_size_t j, tb_byte_t* out, tb_byte_t* test, tb_byte_t* cur, tb_byte_t const* prev)
+{
+    // check
+    tb_assert(impl && impl->bitmap && out && test && cur && prev);
+
+    // convert this row to the png samples
+    gb_bitmap_ref_t     bitmap = impl->bitmap;
+    tb_byte_t const*    data = (tb_byte_t const*)gb_bitmap_data(bitmap) + j * gb_bitmap_row_bytes(bitmap);
+    if (!gb_pixmap_convert(impl->pixfmt, cur, gb_bitmap_pixfmt(bitmap), data, gb_bitmap_width(bitmap))) return tb_false;
+
+    /* filter it with the minimum sum of the absolute differences
+     *
+     * the choice only depends on this row and the previous row,
+     * so the row groups can refilter the tail of the previous group as the same dictionary
+     */
+    tb_size_t filter = GB_PNG_FILTER_NONE;
+    tb_size_t best = gb_bitmap_encoder_png_filter(out, filter, cur, prev, impl->stride, impl->btp);
+    for (filter = GB_PNG_FILTER_SUB; filter <= GB_PNG_FILTER_PAETH && best; filter++)
+    {
+        tb_size_t sum = gb_bitmap_encoder_png_filter(test, filter, cur, prev, impl->stride, impl->btp);
+        if (sum < best)
+        {
+            best = sum;
+            tb_memcpy(out, test, impl->stride + 1);
+        }
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t gb_bitmap_encoder_png_chunk(tb_stream_ref_t stream, tb_uint32_t type, tb_byte_t const* data, tb_size_t size)
+{
+    // the crc of the type and data
+    tb_byte_t   head[4];
+    tb_bits_set_u32_be(head, type);
+    uLong       crc = crc32(crc32(0, tb_null, 0), head, 4);
+    if (size) crc = crc32(crc, data, (uInt)size);
+
+    // write it
+    return      tb_stream_bwrit_u32_be(stream, (tb_uint32_t)size)
+            &&  tb_stream_bwrit(stream, head, 4)
+            &&  (!size || tb_stream_bwrit(stream, data, size))
+            &&  tb_stream_bwrit_u32_be(stream, (tb_uint32_t)crc);
+}
+static tb_bool_t gb_bitmap_encoder_png_group_deflate(gb_bitmap_encoder_png_group_t* group, z_stream* zstream, tb_byte_t const* data, tb_size_t size, tb_int_t flush)
+{
+    // check
+    tb_assert(group && group->encoder && zstream);
+
+    // deflate it
+    zstream->next_in    = (Bytef*)data;
+    zstream->avail_in   = (uInt)size;
+    do
+    {
+        // the output buffer is full?
+        if (group->size == group->maxn)
+        {
+            // write an idat chunk directly for the serial encoding
+            if (group->encoder->count == 1)
+            {
+                if (!gb_bitmap_encoder_png_chunk(group->encoder->base.stream, GB_PNG_CHUNK_IDAT, group->data, group->size)) return tb_false;
+                group->size = 0;
+            }
+            // grow it
+            else
+            {
+                group->maxn <<= 1;
+                group->data = (tb_byte_t*)tb_ralloc(group->data, group->maxn);
+                tb_assert_and_check_return_val(group->data, tb_false);
+            }
+        }
+
+        // deflate the data to the free space
+        zstream->next_out   = group->data + group->size;
+        zstream->avail_out  = (uInt)(group->maxn - group->size);
+        tb_int_t r = deflate(zstream, flush);
+        tb_assert_and_check_return_val(r == Z_OK || r == Z_STREAM_END || r == Z_BUF_ERROR, tb_false);
+        group->size = group->maxn - zstream->avail_out;
+
+    } while (zstream->avail_in || !zstream->avail_out);
+
+    // ok
+    return tb_true;
+}
+static tb_void_t gb_bitmap_encoder_png_group_done(gb_bitmap_encoder_png_group_t* group)
+{
+    // check
+    tb_assert(group && group->encoder);
+
+    // the encoder
+    gb_bitmap_encoder_png_t*    impl = group->encoder;
+    tb_size_t                   stride = impl->stride;
+
+    // done
+    tb_bool_t   zinit = tb_false;
+    tb_byte_t*  buffer = tb_null;
+    tb_byte_t*  dictionary = tb_null;
+    z_stream    zstream;
+    do
+    {
+        // make the row buffers: out, test, cur, prev
+        buffer = (tb_byte_t*)tb_malloc0(((stride + 1) << 1) + (stride << 1));
+        tb_assert_and_check_break(buffer);
+        tb_byte_t* out  = buffer;
+        tb_byte_t* test = out + stride + 1;
+        tb_byte_t* cur  = test + stride + 1;
+        tb_byte_t* prev = cur + stride;
+        tb_byte_t* temp = tb_null;
+
+        // init the raw deflate stream, the zlib header and adler32 are written by the encoder
+        tb_memset(&zstream, 0, sizeof(z_stream));
+        if (deflateInit2(&zstream, GB_PNG_LEVEL, Z_DEFLATED, -15, 8, Z_FILTERED) != Z_OK) break;
+        zinit = tb_true;
+
+        /* use the filtered tail of the previous group as the dictionary
+         *
+         * it is refiltered here for encoding the groups independently,
+         * so the concatenated deflate stream is the same as the serial one at the group boundaries
+         */
+        tb_size_t j = group->top;
+        if (j)
+        {
+            // the rows of the dictionary
+            tb_size_t n = tb_min((GB_PNG_WINDOW + stride) / (stride + 1), j);
+            tb_size_t s = n * (stride + 1);
+            dictionary = (tb_byte_t*)tb_malloc(s);
+            tb_assert_and_check_break(dictionary);
+
+            // the previous row of the first dictionary row
+            tb_size_t k = j - n;
+            if (k && !gb_pixmap_convert(impl->pixfmt, prev, gb_bitmap_pixfmt(impl->bitmap), (tb_byte_t const*)gb_bitmap_data(impl->bitmap) + (k - 1) * gb_bitmap_row_bytes(impl->bitmap), gb_bitmap_width(impl->bitmap))) break;
+
+            // filter the dictionary rows
+            for (; k < j; k++)
+            {
+                if (!gb_bitmap_encoder_png_row(impl, k, dictionary + (k + n - j) * (stride + 1), test, cur, prev)) break;
+                temp = prev; prev = cur; cur = temp;
+            }
+            tb_check_break(k == j);
+
+            // set it
+            if (s > GB_PNG_WINDOW)
+            {
+                if (deflateSetDictionary(&zstream, dictionary + s - GB_PNG_WINDOW, GB_PNG_WINDOW) != Z_OK) break;
+            }
+            else if (deflateSetDictionary(&zstream, dictionary, (uInt)s) != Z_OK) break;
+        }
+
+        // make the output buffer, the first group will write the zlib header to it
+        group->maxn = impl->count == 1? GB_PNG_OUTPUT_MAXN : (tb_size_t)deflateBound(&zstream, (group->bottom - group->top) * (stride + 1)) + 16;
+        group->data = (tb_byte_t*)tb_malloc(group->maxn);
+        tb_assert_and_check_break(group->data);
+        if (!j)
+        {
+            group->data[0] = 0x78;
+            group->data[1] = 0x9c;
+            group->size = 2;
+        }
+
+        // deflate the filtered rows
+        group->adler = (tb_uint32_t)adler32(0, tb_null, 0);
+        for (; j < group->bottom; j++)
+        {
+            // filter this row
+            if (!gb_bitmap_encoder_png_row(impl, j, out, test, cur, prev)) break;
+            temp = prev; prev = cur; cur = temp;
+
+            // deflate it
+            group->adler = (tb_uint32_t)adler32(group->adler, out, (uInt)(stride + 1));
+            if (!gb_bitmap_encoder_png_group_deflate(group, &zstream, out, stride + 1, Z_NO_FLUSH)) break;
+        }
+        tb_check_break(j == group->bottom);
+
+        // finish the last group, the others are flushed to the byte boundary for concatenating them
+        if (!gb_bitmap_encoder_png_group_deflate(group, &zstream, tb_null, 0, group->bottom == gb_bitmap_height(impl->bitmap)? Z_FINISH : Z_SYNC_FLUSH)) break;
+
+        // ok
+        group->ok = tb_true;
+
+    } while (0);
+
+    // exit the deflate stream
+    if (zinit) deflateEnd(&zstream);
+
+    // exit the buffers
+    if (dictionary) tb_free(dictionary);
+    if (buffer) tb_free(buffer);
+}
+static tb_void_t gb_bitmap_encoder_png_group_task(tb_thread_pool_worker_ref_t worker, tb_cpointer_t priv)
+{
+    // encode this group
+    gb_bitmap_encoder_png_group_done((gb_bitmap_encoder_png_group_t*)priv);
+}
+static tb_void_t gb_bitmap_encoder_png_groups_exit(gb_bitmap_encoder_png_t* impl)
+{
+    // check
+    tb_assert(impl);
+
+    // exit the compressed data of the groups
+    tb_size_t i = 0;
+    for (i = 0; i < GB_PNG_GROUPS_MAXN; i++)
+    {
+        gb_bitmap_encoder_png_group_t* group = &impl->groups[i];
+        if (group->data) tb_free(group->data);
+        group->data = tb_null;
+    }
+}
+static tb_bool_t gb_bitmap_encoder_png_done(gb_bitmap_encoder_impl_t* encoder, gb_bitmap_ref_t bitmap)
+{
+    // check
+    gb_bitmap_encoder_png_t* impl = (gb_bitmap_encoder_png_t*)encoder;
+    tb_assert_and_check_return_val(impl && impl->base.type == GB_BITMAP_TYPE_PNG && impl->base.stream && bitmap, tb_false);
+
+    // the bitmap info
+    tb_size_t width     = gb_bitmap_width(bitmap);
+    tb_size_t height    = gb_bitmap_height(bitmap);
+    tb_assert_and_check_return_val(width && height && gb_bitmap_data(bitmap), tb_false);
+
+    // init the png samples, keep the alpha channel only if the bitmap has alpha
+    tb_bool_t has_alpha = gb_bitmap_has_alpha(bitmap);
+    impl->bitmap        = bitmap;
+    impl->pixfmt        = has_alpha? (GB_PIXFMT_RGBA8888 | GB_PIXFMT_BENDIAN) : (GB_PIXFMT_RGB888 | GB_PIXFMT_BENDIAN);
+    impl->btp           = has_alpha? 4 : 3;
+    impl->stride        = width * impl->btp;
+
+    // compute the groups count
+    tb_size_t count = 1;
+    if (impl->base.pool)
+    {
+        count = height / tb_max(GB_PNG_GROUP_SIZE_MINN / (impl->stride + 1), 1);
+        count = tb_min(count, tb_processor_count());
+        count = tb_min(count, GB_PNG_GROUPS_MAXN);
+        if (!count) count = 1;
+    }
+    impl->count = count;
+
+    // done
+    tb_bool_t       ok = tb_false;
+    tb_stream_ref_t stream = impl->base.stream;
+    do
+    {
+        // write the signature
+        if (!tb_stream_bwrit(stream, (tb_byte_t const*)"\x89PNG\r\n\x1a\n", 8)) break;
+
+        // write the header chunk: width, height, depth, color, compression, filter, interlace
+        tb_byte_t ihdr[13];
+        tb_bits_set_u32_be(ihdr, (tb_uint32_t)width);
+        tb_bits_set_u32_be(ihdr + 4, (tb_uint32_t)height);
+        ihdr[8]  = 8;
+        ihdr[9]  = has_alpha? GB_PNG_COLOR_RGBA : GB_PNG_COLOR_RGB;
+        ihdr[10] = 0;
+        ihdr[11] = 0;
+        ihdr[12] = 0;
+        if (!gb_bitmap_encoder_png_chunk(stream, GB_PNG_CHUNK_IHDR, ihdr, sizeof(ihdr))) break;
+
+        // init the groups
+        tb_size_t                       i = 0;
+        gb_bitmap_encoder_png_group_t*  group = tb_null;
+        for (i = 0; i < count; i++)
+        {
+            group = &impl->groups[i];
+            group->encoder  = impl;
+            group->task     = tb_null;
+            group->top      = height * i / count;
+            group->bottom   = height * (i + 1) / count;
+            group->data     = tb_null;
+            group->size     = 0;
+            group->maxn     = 0;
+            group->ok       = tb_false;
+        }
+
+        // post the other groups to the thread pool
+        for (i = 1; i < count; i++)
+        {
+            group = &impl->groups[i];
+            group->task = tb_thread_pool_task_init(impl->base.pool, "png_group", gb_bitmap_encoder_png_group_task, tb_null, group, tb_false);
+        }
+
+        // encode the first group in the current thread
+        gb_bitmap_encoder_png_group_done(&impl->groups[0]);
+
+        // wait the other groups
+        for (i = 1; i < count; i++)
+        {
+            group = &impl->groups[i];
+            if (group->task)
+            {
+                // wait it
+                tb_thread_pool_task_wait(impl->base.pool, group->task, -1);
+
+                // exit it
+                tb_thread_pool_task_exit(impl->base.pool, group->task);
+                group->task = tb_null;
+            }
+            // post failed? encode it in the current thread
+            else gb_bitmap_encoder_png_group_done(group);
+        }
+
+        // all ok? combine the adler32 of the groups
+        tb_uint32_t adler = impl->groups[0].adler;
+        for (i = 0; i < count && impl->groups[i].ok; i++)
+        {
+            group = &impl->groups[i];
+            if (i) adler = (tb_uint32_t)adler32_combine(adler, group->adler, (z_off_t)((group->bottom - group->top) * (impl->stride + 1)));
+        }
+        tb_check_break(i == count);
+
+        // append the adler32 to the last group
+        group = &impl->groups[count - 1];
+        if (group->size + 4 > group->maxn)
+        {
+            group->maxn = group->size + 4;
+            group->data = (tb_byte_t*)tb_ralloc(group->data, group->maxn);
+            tb_assert_and_check_break(group->data);
+        }
+        tb_bits_set_u32_be(group->data + group->size, adler);
+        group->size += 4;
+
+        // write the compressed data of the groups
+        for (i = 0; i < count; i++)
+        {
+            group = &impl->groups[i];
+            if (group->size && !gb_bitmap_encoder_png_chunk(stream, GB_PNG_CHUNK_IDAT, group->data, group->size)) break;
+        }
+        tb_check_break(i == count);
+
+        // write the end chunk
+        if (!gb_bitmap_encoder_png_chunk(stream, GB_PNG_CHUNK_IEND, tb_null, 0)) break;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // exit the groups
+    gb_bitmap_encoder_png_groups_exit(impl);
+    impl->bitmap = tb_null;
+
+    // ok?
+    return ok;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+gb_bitmap_encoder_ref_t gb_bitmap_encoder_png_init(tb_stream_ref_t stream)
+{
+    // check
+    tb_assert_and_check_return_val(stream, tb_null);
+
+    // make encoder
+    gb_bitmap_encoder_png_t* impl = tb_malloc0_type(gb_bitmap_encoder_png_t);
+    tb_assert_and_check_return_val(impl, tb_null);
+
+    // init encoder
+    impl->base.type     = GB_BITMAP_TYPE_PNG;
+    impl->base.stream   = stream;
+    impl->base.done     = gb_bitmap_encoder_png_done;
+
+    // ok
+    return (gb_bitmap_encoder_ref_t)impl;
+}
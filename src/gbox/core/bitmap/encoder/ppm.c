@@ -0,0 +1,107 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        ppm.c
+ * @ingroup     core
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "ppm_encoder"
+#define TB_TRACE_MODULE_DEBUG           (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_bool_t gb_bitmap_encoder_ppm_done(gb_bitmap_encoder_impl_t* encoder, gb_bitmap_ref_t bitmap)
+{
+    // check
+    tb_assert_and_check_return_val(encoder && encoder->type == GB_BITMAP_TYPE_PPM && encoder->stream && bitmap, tb_false);
+
+    // the bitmap info
+    tb_size_t       width       = gb_bitmap_width(bitmap);
+    tb_size_t       height      = gb_bitmap_height(bitmap);
+    tb_size_t       pixfmt      = gb_bitmap_pixfmt(bitmap);
+    tb_size_t       row_bytes   = gb_bitmap_row_bytes(bitmap);
+    tb_byte_t const* data       = (tb_byte_t const*)gb_bitmap_data(bitmap);
+    tb_assert_and_check_return_val(width && height && data, tb_false);
+
+    // done
+    tb_bool_t       ok = tb_false;
+    tb_byte_t*      row = tb_null;
+    tb_stream_ref_t stream = encoder->stream;
+    do
+    {
+        // write the header of the binary ppm
+        if (tb_stream_printf(stream, "P6\n%lu %lu\n255\n", width, height) < 0) break;
+
+        // make the row buffer of the rgb bytes
+        row = (tb_byte_t*)tb_malloc(width * 3);
+        tb_assert_and_check_break(row);
+
+        // write rows
+        tb_size_t j = 0;
+        for (j = 0; j < height; j++, data += row_bytes)
+        {
+            // convert this row to the rgb bytes
+            if (!gb_pixmap_convert(GB_PIXFMT_RGB888 | GB_PIXFMT_BENDIAN, row, pixfmt, data, width)) break;
+
+            // write it
+            if (!tb_stream_bwrit(stream, row, width * 3)) break;
+        }
+        tb_check_break(j == height);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // exit the row buffer
+    if (row) tb_free(row);
+
+    // ok?
+    return ok;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+gb_bitmap_encoder_ref_t gb_bitmap_encoder_ppm_init(tb_stream_ref_t stream)
+{
+    // check
+    tb_assert_and_check_return_val(stream, tb_null);
+
+    // make encoder
+    gb_bitmap_encoder_impl_t* impl = tb_malloc0_type(gb_bitmap_encoder_impl_t);
+    tb_assert_and_check_return_val(impl, tb_null);
+
+    // init encoder
+    impl->type      = GB_BITMAP_TYPE_PPM;
+    impl->stream    = stream;
+    impl->done      = gb_bitmap_encoder_ppm_done;
+
+    // ok
+    return (gb_bitmap_encoder_ref_t)impl;
+}
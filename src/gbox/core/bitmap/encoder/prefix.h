@@ -0,0 +1,98 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        prefix.h
+ * @ingroup     core
+ *
+ */
+#ifndef GB_CORE_BITMAP_ENCODER_PREFIX_H
+#define GB_CORE_BITMAP_ENCODER_PREFIX_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../prefix.h"
+#include "../encoder.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the bitmap encoder impl type
+typedef struct __gb_bitmap_encoder_impl_t
+{
+    // the bitmap type
+    tb_uint8_t              type;
+
+    // the stream
+    tb_stream_ref_t         stream;
+
+    // the thread pool, maybe null
+    tb_thread_pool_ref_t    pool;
+
+    // encode the bitmap to the stream
+    tb_bool_t               (*done)(struct __gb_bitmap_encoder_impl_t* encoder, gb_bitmap_ref_t bitmap);
+
+    // free
+    tb_void_t               (*exit)(struct __gb_bitmap_encoder_impl_t* encoder);
+
+}gb_bitmap_encoder_impl_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* init ppm bitmap encoder
+ *
+ * @param stream        the stream
+ *
+ * @return              the encoder
+ */
+gb_bitmap_encoder_ref_t  gb_bitmap_encoder_ppm_init(tb_stream_ref_t stream);
+
+/* init bmp bitmap encoder
+ *
+ * @param stream        the stream
+ *
+ * @return              the encoder
+ */
+gb_bitmap_encoder_ref_t  gb_bitmap_encoder_bmp_init(tb_stream_ref_t stream);
+
+#ifdef GB_CONFIG_PACKAGE_HAVE_ZLIB
+/* init png bitmap encoder
+ *
+ * @param stream        the stream
+ *
+ * @return              the encoder
+ */
+gb_bitmap_encoder_ref_t  gb_bitmap_encoder_png_init(tb_stream_ref_t stream);
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+#endif
+
+
@@ -43,6 +43,7 @@ typedef enum __gb_bitmap_type_t
 ,   GB_BITMAP_TYPE_GIF   = 2
 ,   GB_BITMAP_TYPE_JPG   = 3
 ,   GB_BITMAP_TYPE_PNG   = 4
+,   GB_BITMAP_TYPE_PPM   = 5
 
 }gb_bitmap_type_t;
 
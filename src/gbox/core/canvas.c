@@ -35,6 +35,7 @@
 #include "device.h"
 #include "path.h"
 #include "paint.h"
+#include "bitmap.h"
 #include "clipper.h"
 #include "impl/bounds.h"
 #include "impl/cache_stack.h"
@@ -950,7 +951,7 @@ tb_void_t gb_canvas_draw_triangle(gb_canvas_ref_t canvas, gb_triangle_ref_t tria
 
     // init polygon
     gb_point_t      points[] = {triangle->p0, triangle->p1, triangle->p2, triangle->p0};
-    tb_uint16_t     counts[] = {4, 0};
+    tb_uint32_t     counts[] = {4, 0};
     gb_polygon_t    polygon = {points, counts, tb_true};
 
     // init hint
@@ -991,7 +992,7 @@ tb_void_t gb_canvas_draw_rect(gb_canvas_ref_t canvas, gb_rect_ref_t rect)
 
     // init polygon
     gb_point_t      points[5];
-    tb_uint16_t     counts[] = {5, 0};
+    tb_uint32_t     counts[] = {5, 0};
     gb_polygon_t    polygon = {points, counts, tb_true};
 
     // init points
@@ -1191,3 +1192,34 @@ tb_void_t gb_canvas_draw_points(gb_canvas_ref_t canvas, gb_point_ref_t points, t
     // draw points
     gb_device_draw_points(impl->device, points, count, tb_null);
 }
+tb_void_t gb_canvas_draw_bitmap(gb_canvas_ref_t canvas, gb_bitmap_ref_t bitmap, gb_rect_ref_t src_rect, gb_rect_ref_t dst_rect)
+{
+    // check
+    gb_canvas_impl_t* impl = (gb_canvas_impl_t*)canvas;
+    tb_assert_and_check_return(impl && impl->device && bitmap);
+
+    // the source rect
+    gb_rect_t src;
+    if (src_rect) src = *src_rect;
+    else gb_rect_imake(&src, 0, 0, gb_bitmap_width(bitmap), gb_bitmap_height(bitmap));
+
+    // the destination rect
+    gb_rect_t dst;
+    if (dst_rect) dst = *dst_rect;
+    else gb_rect_make(&dst, 0, 0, src.w, src.h);
+
+    // draw bitmap
+    gb_device_draw_bitmap(impl->device, bitmap, &src, &dst);
+}
+tb_void_t gb_canvas_draw_bitmap2i(gb_canvas_ref_t canvas, gb_bitmap_ref_t bitmap, tb_long_t x, tb_long_t y)
+{
+    // check
+    tb_assert_and_check_return(bitmap);
+
+    // make rect
+    gb_rect_t rect;
+    gb_rect_imake(&rect, x, y, gb_bitmap_width(bitmap), gb_bitmap_height(bitmap));
+
+    // draw bitmap
+    gb_canvas_draw_bitmap(canvas, bitmap, tb_null, &rect);
+}
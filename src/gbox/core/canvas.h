@@ -1112,6 +1112,27 @@ tb_void_t           gb_canvas_draw_lines(gb_canvas_ref_t canvas, gb_point_ref_t
  */
 tb_void_t           gb_canvas_draw_points(gb_canvas_ref_t canvas, gb_point_ref_t points, tb_size_t count);
 
+/*! draw bitmap
+ *
+ * the source rect will be scaled to the destination rect and transformed by the matrix,
+ * the rows will be copied or converted directly if the opaque bitmap is only translated by the integer offset
+ *
+ * @param canvas    the canvas
+ * @param bitmap    the bitmap
+ * @param src_rect  the source rect in the bitmap, draw the whole bitmap if be null
+ * @param dst_rect  the destination rect, use the size of the source rect at (0, 0) if be null
+ */
+tb_void_t           gb_canvas_draw_bitmap(gb_canvas_ref_t canvas, gb_bitmap_ref_t bitmap, gb_rect_ref_t src_rect, gb_rect_ref_t dst_rect);
+
+/*! draw bitmap at the integer point(x, y)
+ *
+ * @param canvas    the canvas
+ * @param bitmap    the bitmap
+ * @param x         the x-coordinate
+ * @param y         the y-coordinate
+ */
+tb_void_t           gb_canvas_draw_bitmap2i(gb_canvas_ref_t canvas, gb_bitmap_ref_t bitmap, tb_long_t x, tb_long_t y);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
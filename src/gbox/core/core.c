@@ -25,6 +25,7 @@
  * includes
  */
 #include "core.h"
+#include "impl/bitmap_pool.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
@@ -39,6 +40,9 @@ tb_bool_t gb_core_init()
 }
 tb_void_t gb_core_exit()
 {
+    // free the cached data of the bitmap pool
+    gb_bitmap_pool_clear();
+
     // exit prefix
     gb_prefix_exit();
 }
@@ -218,7 +218,7 @@ tb_void_t gb_device_draw_path(gb_device_ref_t device, gb_path_ref_t path)
          *
          * @note the quality of drawing curve may be not higher and faster for stroking with the width > 1
          */
-        gb_device_draw_polygon(device, gb_path_polygon(path), gb_path_hint(path), gb_path_bounds(path));
+        gb_device_draw_polygon(device, gb_path_polygon_for_matrix(path, impl->matrix), gb_path_hint(path), gb_path_bounds(path));
     }
 }
 tb_void_t gb_device_draw_lines(gb_device_ref_t device, gb_point_ref_t points, tb_size_t count, gb_rect_ref_t bounds)
@@ -248,4 +248,70 @@ tb_void_t gb_device_draw_polygon(gb_device_ref_t device, gb_polygon_ref_t polygo
     // draw polygon
     impl->draw_polygon(impl, polygon, hint, bounds);
 }
+tb_void_t gb_device_draw_bitmap(gb_device_ref_t device, gb_bitmap_ref_t bitmap, gb_rect_ref_t src_rect, gb_rect_ref_t dst_rect)
+{
+    // check
+    gb_device_impl_t* impl = (gb_device_impl_t*)device;
+    tb_assert_and_check_return(impl && impl->paint && bitmap && src_rect && dst_rect);
+
+    // empty?
+    tb_check_return(src_rect->w > 0 && src_rect->h > 0 && dst_rect->w > 0 && dst_rect->h > 0);
+
+    // draw it directly?
+    if (impl->draw_bitmap && impl->draw_bitmap(impl, bitmap, src_rect, dst_rect)) return ;
+
+    // init the bitmap shader
+    tb_assert_and_check_return(impl->shader_bitmap);
+    gb_shader_ref_t shader = impl->shader_bitmap(impl, GB_SHADER_MODE_BORDER, bitmap);
+    tb_assert_and_check_return(shader);
+
+    // map the source rect to the destination rect
+    gb_matrix_t matrix;
+    gb_float_t  sx = gb_div(dst_rect->w, src_rect->w);
+    gb_float_t  sy = gb_div(dst_rect->h, src_rect->h);
+    gb_matrix_init(&matrix, sx, 0, 0, sy, dst_rect->x - gb_mul(src_rect->x, sx), dst_rect->y - gb_mul(src_rect->y, sy));
+    gb_shader_matrix_set(shader, &matrix);
+
+    // save the shader and mode of the paint
+    gb_paint_ref_t  paint = impl->paint;
+    gb_shader_ref_t shader_saved = gb_paint_shader(paint);
+    tb_size_t       mode_saved = gb_paint_mode(paint);
+    if (shader_saved) gb_shader_inc(shader_saved);
 
+    // fill the destination rect with the bitmap shader
+    gb_paint_shader_set(paint, shader);
+    gb_paint_mode_set(paint, GB_PAINT_MODE_FILL);
+    {
+        // init polygon
+        gb_point_t      points[5];
+        tb_uint32_t     counts[] = {5, 0};
+        gb_polygon_t    polygon = {points, counts, tb_true};
+
+        // init points
+        points[0].x = dst_rect->x;
+        points[0].y = dst_rect->y;
+        points[1].x = dst_rect->x + dst_rect->w;
+        points[1].y = dst_rect->y;
+        points[2].x = dst_rect->x + dst_rect->w;
+        points[2].y = dst_rect->y + dst_rect->h;
+        points[3].x = dst_rect->x;
+        points[3].y = dst_rect->y + dst_rect->h;
+        points[4] = points[0];
+
+        // init hint
+        gb_shape_t      hint;
+        hint.type       = GB_SHAPE_TYPE_RECT;
+        hint.u.rect     = *dst_rect;
+
+        // draw it
+        gb_device_draw_polygon(device, &polygon, &hint, dst_rect);
+    }
+
+    // restore the shader and mode of the paint
+    gb_paint_mode_set(paint, mode_saved);
+    gb_paint_shader_set(paint, shader_saved);
+    if (shader_saved) gb_shader_dec(shader_saved);
+
+    // exit the bitmap shader
+    gb_shader_exit(shader);
+}
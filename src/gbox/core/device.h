@@ -79,6 +79,19 @@ gb_device_ref_t     gb_device_init_skia(gb_bitmap_ref_t bitmap);
  * @return          the device
  */
 gb_device_ref_t     gb_device_init_bitmap(gb_bitmap_ref_t bitmap);
+
+/*! init bitmap device with the parallel rasterization
+ *
+ * the large polygons will be split into the horizontal bands, 
+ * and the bands will be rasterized and blitted concurrently on the thread pool.
+ * the output is the same as the serial bitmap device.
+ *
+ * @param bitmap    the bitmap
+ * @param pool      the thread pool, uses the serial rasterization if be null
+ *
+ * @return          the device
+ */
+gb_device_ref_t     gb_device_init_bitmap_parallel(gb_bitmap_ref_t bitmap, tb_thread_pool_ref_t pool);
 #endif
 
 /*! exit device 
@@ -189,6 +202,15 @@ tb_void_t           gb_device_draw_points(gb_device_ref_t device, gb_point_ref_t
  */
 tb_void_t           gb_device_draw_polygon(gb_device_ref_t device, gb_polygon_ref_t polygon, gb_shape_ref_t hint, gb_rect_ref_t bounds);
 
+/*! draw bitmap
+ *
+ * @param device    the device
+ * @param bitmap    the bitmap
+ * @param src_rect  the source rect in the bitmap
+ * @param dst_rect  the destination rect
+ */
+tb_void_t           gb_device_draw_bitmap(gb_device_ref_t device, gb_bitmap_ref_t bitmap, gb_rect_ref_t src_rect, gb_rect_ref_t dst_rect);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -33,6 +33,7 @@
  */
 #include "prefix.h"
 #include "bitmap/bitmap.h"
+#include "../clipper.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
@@ -48,6 +49,10 @@
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
+static __tb_inline__ tb_bool_t gb_device_bitmap_is_integer(gb_float_t x)
+{
+    return gb_long_to_float(gb_float_to_long(x)) == x;
+}
 static tb_void_t gb_device_bitmap_resize(gb_device_impl_t* device, tb_size_t width, tb_size_t height)
 {
     // check
@@ -57,6 +62,31 @@ static tb_void_t gb_device_bitmap_resize(gb_device_impl_t* device, tb_size_t wid
     // resize
     gb_bitmap_resize(impl->bitmap, width, height);
 }
+static tb_void_t gb_device_bitmap_clear_fill(gb_pixmap_ref_t pixmap, tb_pointer_t data, gb_pixel_t pixel, tb_size_t count)
+{
+    /* store the pixel directly, the pixels_fill of the device pixmap blends it at the top quality
+     * because GB_ALPHA_MAXN is 0xff and gb_pixmap(pixfmt, 0xff) returns the alpha pixmap
+     */
+    tb_bool_t bendian = GB_PIXFMT_BE(pixmap->pixfmt)? tb_true : tb_false;
+    switch (pixmap->btp)
+    {
+    case 1:
+        tb_memset(data, (tb_byte_t)pixel, count);
+        break;
+    case 2:
+        tb_memset_u16(data, bendian? tb_bits_ne_to_be_u16(pixel) : tb_bits_ne_to_le_u16(pixel), count);
+        break;
+    case 3:
+        tb_memset_u24(data, bendian? tb_bits_ne_to_be_u24(pixel) : tb_bits_ne_to_le_u24(pixel), count);
+        break;
+    case 4:
+        tb_memset_u32(data, bendian? tb_bits_ne_to_be_u32(pixel) : tb_bits_ne_to_le_u32(pixel), count);
+        break;
+    default:
+        tb_assert(0);
+        break;
+    }
+}
 static tb_void_t gb_device_bitmap_draw_clear(gb_device_impl_t* device, gb_color_t color)
 {
     // check
@@ -71,12 +101,30 @@ static tb_void_t gb_device_bitmap_draw_clear(gb_device_impl_t* device, gb_color_
     gb_pixmap_ref_t pixmap = impl->pixmap;
     tb_assert(pixmap && pixmap->pixel && pixmap->pixels_fill);
 
-    // the pixels count
-    tb_size_t count = gb_bitmap_size(impl->bitmap) / pixmap->btp;
-    tb_assert(count);
+    // the width, height and row bytes
+    tb_size_t width     = gb_bitmap_width(impl->bitmap);
+    tb_size_t height    = gb_bitmap_height(impl->bitmap);
+    tb_size_t row_bytes = gb_bitmap_row_bytes(impl->bitmap);
+    tb_assert(width && height && row_bytes >= width * pixmap->btp);
 
-    // clear it
-    pixmap->pixels_fill(pixels, pixmap->pixel(color), count, 0xff);
+    // the mipmaps of the device bitmap will be changed
+    gb_bitmap_mipmap_clear(impl->bitmap);
+
+    // the pixel
+    gb_pixel_t pixel = pixmap->pixel(color);
+
+    // the rows are contiguous? clear all pixels at once
+    if (row_bytes == width * pixmap->btp) gb_device_bitmap_clear_fill(pixmap, pixels, pixel, width * height);
+    else
+    {
+        // clear it row by row, the rows may be padded
+        tb_byte_t* row = (tb_byte_t*)pixels;
+        while (height--)
+        {
+            gb_device_bitmap_clear_fill(pixmap, row, pixel, width);
+            row += row_bytes;
+        }
+    }
 }
 static tb_void_t gb_device_bitmap_draw_lines(gb_device_impl_t* device, gb_point_ref_t points, tb_size_t count, gb_rect_ref_t bounds)
 {
@@ -142,14 +190,92 @@ static tb_void_t gb_device_bitmap_draw_path(gb_device_impl_t* device, gb_path_re
         gb_bitmap_render_exit(impl);
     }
 }
+static tb_bool_t gb_device_bitmap_draw_bitmap(gb_device_impl_t* device, gb_bitmap_ref_t bitmap, gb_rect_ref_t src_rect, gb_rect_ref_t dst_rect)
+{
+    // check
+    gb_bitmap_device_ref_t impl = (gb_bitmap_device_ref_t)device;
+    tb_assert_and_check_return_val(impl && impl->bitmap && impl->base.paint && impl->base.matrix && bitmap && src_rect && dst_rect, tb_false);
+
+    /* copy or convert the source rows directly?
+     *
+     * the opaque source is only translated by the integer offset without the scaling and clipping,
+     * and it replaces the destination for the blend mode, the alpha of the destination must be opaque after drawing
+     */
+    gb_paint_ref_t  paint = impl->base.paint;
+    gb_matrix_ref_t matrix = impl->base.matrix;
+    tb_size_t       blend = gb_paint_blend(paint);
+    tb_size_t       pixfmt = gb_bitmap_pixfmt(impl->bitmap);
+    tb_size_t       source_pixfmt = gb_bitmap_pixfmt(bitmap);
+    tb_check_return_val(    (blend == GB_PAINT_BLEND_SRC_OVER || blend == GB_PAINT_BLEND_SRC)
+                        &&  gb_paint_alpha(paint) == 0xff
+                        &&  !gb_bitmap_has_alpha(bitmap)
+                        &&  (!gb_bitmap_has_alpha(impl->bitmap) || !GB_PIXFMT_HAS_ALPHA(source_pixfmt))
+                        &&  (!impl->base.clipper || !gb_clipper_size(impl->base.clipper))
+                        &&  matrix->sx == GB_ONE && matrix->sy == GB_ONE && !matrix->kx && !matrix->ky
+                        &&  src_rect->w == dst_rect->w && src_rect->h == dst_rect->h, tb_false);
+
+    // the source and destination rects must be integer
+    gb_float_t x = dst_rect->x + matrix->tx;
+    gb_float_t y = dst_rect->y + matrix->ty;
+    tb_check_return_val(    gb_device_bitmap_is_integer(x) && gb_device_bitmap_is_integer(y)
+                        &&  gb_device_bitmap_is_integer(src_rect->x) && gb_device_bitmap_is_integer(src_rect->y)
+                        &&  gb_device_bitmap_is_integer(src_rect->w) && gb_device_bitmap_is_integer(src_rect->h), tb_false);
+
+    // the integer rects
+    tb_long_t dx = gb_float_to_long(x);
+    tb_long_t dy = gb_float_to_long(y);
+    tb_long_t sx = gb_float_to_long(src_rect->x);
+    tb_long_t sy = gb_float_to_long(src_rect->y);
+    tb_long_t w = gb_float_to_long(src_rect->w);
+    tb_long_t h = gb_float_to_long(src_rect->h);
+
+    // clip the source rect by the source bitmap, the outside pixels are transparent and we need not draw them
+    if (sx < 0) { dx -= sx; w += sx; sx = 0; }
+    if (sy < 0) { dy -= sy; h += sy; sy = 0; }
+    w = tb_min(w, (tb_long_t)gb_bitmap_width(bitmap) - sx);
+    h = tb_min(h, (tb_long_t)gb_bitmap_height(bitmap) - sy);
+
+    // clip the destination rect by the device bitmap
+    if (dx < 0) { sx -= dx; w += dx; dx = 0; }
+    if (dy < 0) { sy -= dy; h += dy; dy = 0; }
+    w = tb_min(w, (tb_long_t)gb_bitmap_width(impl->bitmap) - dx);
+    h = tb_min(h, (tb_long_t)gb_bitmap_height(impl->bitmap) - dy);
+
+    // nothing to draw?
+    tb_check_return_val(w > 0 && h > 0, tb_true);
+
+    // the pixmaps
+    gb_pixmap_ref_t source_pixmap = gb_pixmap(source_pixfmt, 0xff);
+    tb_assert_and_check_return_val(source_pixmap, tb_false);
+
+    // the rows
+    tb_size_t           row_bytes = gb_bitmap_row_bytes(impl->bitmap);
+    tb_size_t           source_row_bytes = gb_bitmap_row_bytes(bitmap);
+    tb_byte_t*          pixels = (tb_byte_t*)gb_bitmap_data(impl->bitmap) + dy * row_bytes + dx * impl->pixmap->btp;
+    tb_byte_t const*    source = (tb_byte_t const*)gb_bitmap_data(bitmap) + sy * source_row_bytes + sx * source_pixmap->btp;
+    tb_assert_and_check_return_val(pixels && source, tb_false);
+
+    // the mipmaps of the device bitmap will be changed
+    gb_bitmap_mipmap_clear(impl->bitmap);
+
+    // copy the rows for the same pixfmt, otherwise convert them
+    for (; h > 0; h--, pixels += row_bytes, source += source_row_bytes)
+    {
+        // the first row will fail and nothing is drawn if the pixfmts are not supported
+        if (!gb_pixmap_convert(pixfmt, pixels, source_pixfmt, source, w)) return tb_false;
+    }
+
+    // ok
+    return tb_true;
+}
 static gb_shader_ref_t gb_device_bitmap_shader_linear(gb_device_impl_t* device, tb_size_t mode, gb_gradient_ref_t gradient, gb_line_ref_t line)
 {
     // check
     gb_bitmap_device_ref_t impl = (gb_bitmap_device_ref_t)device;
     tb_assert_and_check_return_val(impl, tb_null);
 
-    tb_trace_noimpl();
-    return tb_null;
+    // init shader
+    return gb_bitmap_shader_init_linear(impl, mode, gradient, line);
 }
 static gb_shader_ref_t gb_device_bitmap_shader_radial(gb_device_impl_t* device, tb_size_t mode, gb_gradient_ref_t gradient, gb_circle_ref_t circle)
 {
@@ -157,8 +283,8 @@ static gb_shader_ref_t gb_device_bitmap_shader_radial(gb_device_impl_t* device,
     gb_bitmap_device_ref_t impl = (gb_bitmap_device_ref_t)device;
     tb_assert_and_check_return_val(impl, tb_null);
 
-    tb_trace_noimpl();
-    return tb_null;
+    // init shader
+    return gb_bitmap_shader_init_radial(impl, mode, gradient, circle);
 }
 static gb_shader_ref_t gb_device_bitmap_shader_bitmap(gb_device_impl_t* device, tb_size_t mode, gb_bitmap_ref_t bitmap)
 {
@@ -166,8 +292,8 @@ static gb_shader_ref_t gb_device_bitmap_shader_bitmap(gb_device_impl_t* device,
     gb_bitmap_device_ref_t impl = (gb_bitmap_device_ref_t)device;
     tb_assert_and_check_return_val(impl, tb_null);
 
-    tb_trace_noimpl();
-    return tb_null;
+    // init shader
+    return gb_bitmap_shader_init_bitmap(impl, mode, bitmap);
 }
 static tb_void_t gb_device_bitmap_exit(gb_device_impl_t* device)
 {
@@ -191,6 +317,14 @@ static tb_void_t gb_device_bitmap_exit(gb_device_impl_t* device)
     if (impl->raster) gb_polygon_raster_exit(impl->raster);
     impl->raster = tb_null;
 
+    // exit the rasters of the bands
+    tb_size_t i = 0;
+    for (i = 0; i < tb_arrayn(impl->bands); i++)
+    {
+        if (impl->bands[i].raster) gb_polygon_raster_exit(impl->bands[i].raster);
+        impl->bands[i].raster = tb_null;
+    }
+
     // exit it
     tb_free(impl);
 }
@@ -199,6 +333,11 @@ static tb_void_t gb_device_bitmap_exit(gb_device_impl_t* device)
  * implementation
  */
 gb_device_ref_t gb_device_init_bitmap(gb_bitmap_ref_t bitmap)
+{
+    // init it
+    return gb_device_init_bitmap_parallel(bitmap, tb_null);
+}
+gb_device_ref_t gb_device_init_bitmap_parallel(gb_bitmap_ref_t bitmap, tb_thread_pool_ref_t pool)
 {
     // check
     tb_assert_and_check_return_val(bitmap, tb_null);
@@ -225,6 +364,7 @@ gb_device_ref_t gb_device_init_bitmap(gb_bitmap_ref_t bitmap)
         impl->base.draw_lines       = gb_device_bitmap_draw_lines;
         impl->base.draw_points      = gb_device_bitmap_draw_points;
         impl->base.draw_polygon     = gb_device_bitmap_draw_polygon;
+        impl->base.draw_bitmap      = gb_device_bitmap_draw_bitmap;
         impl->base.shader_linear    = gb_device_bitmap_shader_linear;
         impl->base.shader_radial    = gb_device_bitmap_shader_radial;
         impl->base.shader_bitmap    = gb_device_bitmap_shader_bitmap;
@@ -233,6 +373,9 @@ gb_device_ref_t gb_device_init_bitmap(gb_bitmap_ref_t bitmap)
         // init bitmap
         impl->bitmap = bitmap;
 
+        // init the thread pool for the parallel rasterization
+        impl->pool = pool;
+
         // init pixmap
         impl->pixmap = gb_pixmap(gb_bitmap_pixfmt(bitmap), 0xff);
         tb_assert_and_check_break(impl->pixmap);
@@ -250,7 +393,7 @@ gb_device_ref_t gb_device_init_bitmap(gb_bitmap_ref_t bitmap)
         tb_assert_and_check_break(impl->points);
 
         // init counts
-        impl->counts = tb_vector_init(8, tb_element_uint16());
+        impl->counts = tb_vector_init(8, tb_element_uint32());
         tb_assert_and_check_break(impl->counts);
 
         // ok
@@ -35,16 +35,59 @@
 #include "biltter/solid.h"
 #include "biltter/shader.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_bool_t gb_bitmap_biltter_composite_init(gb_bitmap_biltter_ref_t biltter, gb_bitmap_ref_t bitmap, gb_paint_ref_t paint)
+{
+    // the pixfmt and blend mode
+    tb_size_t pixfmt    = gb_bitmap_pixfmt(bitmap);
+    tb_size_t blend     = gb_paint_blend(paint);
+
+    // no compositing pixmap
+    biltter->composite = tb_null;
+
+    /* the default src-over to the opaque or premultiplied bitmap? 
+     *
+     * the pixmap blends the opaque paint pixel directly, 
+     * it is the same as the premultiplied src-over for the opaque destination and the pargb8888 pixels
+     */
+    tb_check_return_val(    blend != GB_PAINT_BLEND_SRC_OVER
+                        ||  (   GB_PIXFMT_HAS_ALPHA(pixfmt) 
+                            &&  gb_bitmap_has_alpha(bitmap) 
+                            &&  GB_PIXFMT(pixfmt) != GB_PIXFMT(GB_PIXFMT_PARGB8888)), tb_true);
+
+    // the compositing pixmap
+    biltter->composite = gb_pixmap_composite(pixfmt, blend);
+
+    // the src-over of the other pixfmts with alpha blends the straight pixels directly, it is only approximate
+    tb_check_return_val(biltter->composite || blend != GB_PAINT_BLEND_SRC_OVER, tb_true);
+
+    // the blend mode is not supported for this pixfmt? nothing will be drawn
+    if (!biltter->composite)
+    {
+        // trace
+        tb_trace_e("the blend mode %lu is not supported for the pixfmt %lx!", blend, pixfmt);
+        return tb_false;
+    }
+
+    // ok
+    return tb_true;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
-tb_bool_t gb_bitmap_biltter_init(gb_bitmap_biltter_ref_t biltter, gb_bitmap_ref_t bitmap, gb_paint_ref_t paint)
+tb_bool_t gb_bitmap_biltter_init(gb_bitmap_biltter_ref_t biltter, gb_bitmap_ref_t bitmap, gb_matrix_ref_t matrix, gb_paint_ref_t paint)
 {
     // check
-    tb_assert(biltter && bitmap && paint);
+    tb_assert(biltter && bitmap && matrix && paint);
+
+    // init the compositing pixmap
+    if (!gb_bitmap_biltter_composite_init(biltter, bitmap, paint)) return tb_false;
 
     // init it
-    return gb_paint_shader(paint)? gb_bitmap_biltter_shader_init(biltter, bitmap, paint) : gb_bitmap_biltter_solid_init(biltter, bitmap, paint);
+    return gb_paint_shader(paint)? gb_bitmap_biltter_shader_init(biltter, bitmap, matrix, paint) : gb_bitmap_biltter_solid_init(biltter, bitmap, paint);
 }
 tb_void_t gb_bitmap_biltter_exit(gb_bitmap_biltter_ref_t biltter)
 {
@@ -114,3 +157,52 @@ tb_void_t gb_bitmap_biltter_done_r(gb_bitmap_biltter_ref_t biltter, tb_long_t x,
         while (h--) biltter->done_h(biltter, x, y++, w);
     }
 }
+tb_void_t gb_bitmap_biltter_done_s(gb_bitmap_biltter_ref_t biltter, gb_polygon_raster_span_ref_t spans, tb_size_t count)
+{
+    // check
+    tb_assert(biltter && spans);
+
+    // done it
+    if (biltter->done_s) biltter->done_s(biltter, spans, count);
+    else
+    {
+        // check
+        tb_assert(biltter->done_h);
+
+        // done the spans which are covered by more than half
+        gb_polygon_raster_span_ref_t tail = spans + count;
+        for (; spans < tail; spans++)
+        {
+            if (spans->coverage & 0x80) biltter->done_h(biltter, spans->x0, spans->y, spans->x1 - spans->x0);
+        }
+    }
+}
+tb_void_t gb_bitmap_biltter_done_m(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w, tb_long_t h, tb_byte_t const* mask, tb_size_t mask_row_bytes)
+{
+    // check
+    tb_assert(biltter && mask && x >= 0 && y >= 0);
+
+    // no width and height? ignore it
+    tb_check_return(w > 0 && h > 0);
+
+    // done it
+    if (biltter->done_m) biltter->done_m(biltter, x, y, w, h, mask, mask_row_bytes);
+    else
+    {
+        // check
+        tb_assert(biltter->done_h);
+
+        // done the runs which are covered by more than half
+        tb_long_t i;
+        tb_long_t e;
+        for (; h--; y++, mask += mask_row_bytes)
+        {
+            for (i = 0; i < w; i = e)
+            {
+                for (e = i; e < w && (mask[e] & 0x80); e++) ;
+                if (e > i) biltter->done_h(biltter, x + i, y, e - i);
+                else e++;
+            }
+        }
+    }
+}
@@ -27,6 +27,7 @@
  * includes
  */
 #include "prefix.h"
+#include "../../impl/polygon_raster.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
@@ -37,6 +38,12 @@ __tb_extern_c_enter__
  * types
  */
 
+// the bitmap biltter type
+struct __gb_bitmap_biltter_t;
+
+// the bitmap shader lut entry type
+struct __gb_bitmap_shader_lut_entry_t;
+
 // the bitmap biltter solid type
 typedef struct __gb_bitmap_biltter_solid_t
 {
@@ -46,8 +53,120 @@ typedef struct __gb_bitmap_biltter_solid_t
     // the alpha
     tb_byte_t                       alpha;
 
+    // the blend pixmap for the partial coverages
+    gb_pixmap_ref_t                 blend;
+
 }gb_bitmap_biltter_solid_t;
 
+// the bitmap biltter shader type
+typedef struct __gb_bitmap_biltter_shader_t
+{
+    // the shader
+    gb_shader_ref_t                 shader;
+
+    // the shader mode
+    tb_byte_t                       mode;
+
+    // the alpha of the paint
+    tb_byte_t                       alpha;
+
+    // the opaque pixmap of the bitmap
+    gb_pixmap_ref_t                 opaque;
+
+    // the blend pixmap of the bitmap
+    gb_pixmap_ref_t                 blend;
+
+    // the inverse matrix from the device space to the shader space, 16.16 fixed
+    tb_fixed_t                      sx;
+    tb_fixed_t                      kx;
+    tb_fixed_t                      ky;
+    tb_fixed_t                      sy;
+    tb_fixed_t                      tx;
+    tb_fixed_t                      ty;
+
+    union
+    {
+        // the bitmap shader
+        struct
+        {
+            // the source pixmap
+            gb_pixmap_ref_t         pixmap;
+
+            // the source data
+            tb_byte_t const*        data;
+
+            // the source width
+            tb_long_t               width;
+
+            // the source height
+            tb_long_t               height;
+
+            // the row bytes of the source
+            tb_size_t               row_bytes;
+
+            // the btp of the source
+            tb_size_t               btp;
+
+            // the source has alpha?
+            tb_uint8_t              has_alpha   : 1;
+
+            // filter bitmap with the bilinear interpolation?
+            tb_uint8_t              filter      : 1;
+
+            // copy the source rows directly for the integer translation?
+            tb_uint8_t              copy        : 1;
+
+            // composite the premultiplied source rows directly for the integer translation?
+            tb_uint8_t              over        : 1;
+
+        }bitmap;
+
+        // the gradient shader
+        struct
+        {
+            // the color lookup table
+            struct __gb_bitmap_shader_lut_entry_t const* lut;
+
+            // all entries of the lut are opaque?
+            tb_bool_t               opaque;
+
+            /* the gradient position of the device pixel (x, y) for the linear gradient, 32.32 fixed
+             *
+             * t = a * x + b * y + c, [0, 1] for the lut
+             */
+            tb_hong_t               a;
+            tb_hong_t               b;
+            tb_hong_t               c;
+
+            // the center of the radial gradient in the shader space, 16.16 fixed
+            tb_fixed_t              cx;
+            tb_fixed_t              cy;
+
+            // the squared radius of one lut entry for the radial gradient, 32.32 fixed
+            tb_hong_t               rn2;
+
+            // the lut entries per the distance for the radial gradient: lut size / radius, 16.16 fixed
+            tb_hong_t               rinv;
+
+            // evaluate the lut index of the radial gradient incrementally?
+            tb_bool_t               incremental;
+
+        }gradient;
+
+    }u;
+
+    /* done the span of the shader
+     *
+     * @param biltter               the biltter
+     * @param x                     the start x-coordinate
+     * @param y                     the y-coordinate
+     * @param w                     the width
+     * @param coverage              the coverage of the span, 255: full
+     */
+    tb_void_t                       (*done)(struct __gb_bitmap_biltter_t* biltter, tb_long_t x, tb_long_t y, tb_long_t w, tb_byte_t coverage);
+
+}gb_bitmap_biltter_shader_t;
+
 // the bitmap biltter type
 typedef struct __gb_bitmap_biltter_t
 {
@@ -56,6 +175,9 @@ typedef struct __gb_bitmap_biltter_t
         // the solid biltter
         gb_bitmap_biltter_solid_t    solid;
 
+        // the shader biltter
+        gb_bitmap_biltter_shader_t   shader;
+
     }u;
 
     // the bitmap
@@ -64,6 +186,11 @@ typedef struct __gb_bitmap_biltter_t
     // the pixmap
     gb_pixmap_ref_t                 pixmap;
 
+    /* the compositing pixmap for the blend mode or the bitmap with alpha,
+     * tb_null for the default src-over to the opaque or pargb8888 bitmap
+     */
+    gb_pixmap_ref_t                 composite;
+
     // the btp of the bitmap 
     tb_size_t                       btp;
 
@@ -112,6 +239,26 @@ typedef struct __gb_bitmap_biltter_t
      */
     tb_void_t                       (*done_r)(struct __gb_bitmap_biltter_t* biltter, tb_long_t x, tb_long_t y, tb_long_t w, tb_long_t h);
 
+    /* done biltter by the span batches
+     *
+     * @param biltter               the biltter
+     * @param spans                 the spans
+     * @param count                 the spans count
+     */
+    tb_void_t                       (*done_s)(struct __gb_bitmap_biltter_t* biltter, gb_polygon_raster_span_ref_t spans, tb_size_t count);
+
+    /* done biltter by the coverage mask
+     *
+     * @param biltter               the biltter
+     * @param x                     the start x-coordinate
+     * @param y                     the start y-coordinate
+     * @param w                     the width
+     * @param h                     the height
+     * @param mask                  the a8 coverage mask of the rect, 255: full
+     * @param mask_row_bytes        the row bytes of the mask, 0: all rows use the same coverage row
+     */
+    tb_void_t                       (*done_m)(struct __gb_bitmap_biltter_t* biltter, tb_long_t x, tb_long_t y, tb_long_t w, tb_long_t h, tb_byte_t const* mask, tb_size_t mask_row_bytes);
+
 }gb_bitmap_biltter_t, *gb_bitmap_biltter_ref_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -122,11 +269,12 @@ typedef struct __gb_bitmap_biltter_t
  *
  * @param biltter       the biltter
  * @param bitmap        the bitmap
+ * @param matrix        the matrix of the device
  * @param paint         the paint
  *
  * @return              tb_true or tb_false
  */
-tb_bool_t               gb_bitmap_biltter_init(gb_bitmap_biltter_ref_t biltter, gb_bitmap_ref_t bitmap, gb_paint_ref_t paint);
+tb_bool_t               gb_bitmap_biltter_init(gb_bitmap_biltter_ref_t biltter, gb_bitmap_ref_t bitmap, gb_matrix_ref_t matrix, gb_paint_ref_t paint);
 
 /* exit biltter
  *
@@ -170,6 +318,28 @@ tb_void_t               gb_bitmap_biltter_done_v(gb_bitmap_biltter_ref_t biltter
  */
 tb_void_t               gb_bitmap_biltter_done_r(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w, tb_long_t h);
 
+/* done biltter by the span batches
+ *
+ * the span will be filled by done_h if the biltter cannot blend the partial coverages
+ *
+ * @param biltter       the biltter
+ * @param spans         the spans
+ * @param count         the spans count
+ */
+tb_void_t               gb_bitmap_biltter_done_s(gb_bitmap_biltter_ref_t biltter, gb_polygon_raster_span_ref_t spans, tb_size_t count);
+
+/* done biltter by the coverage mask
+ *
+ * @param biltter       the biltter
+ * @param x             the start x-coordinate
+ * @param y             the start y-coordinate
+ * @param w             the width
+ * @param h             the height
+ * @param mask          the a8 coverage mask of the rect, 255: full
+ * @param mask_row_bytes the row bytes of the mask, 0: all rows use the same coverage row
+ */
+tb_void_t               gb_bitmap_biltter_done_m(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w, tb_long_t h, tb_byte_t const* mask, tb_size_t mask_row_bytes);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -0,0 +1,206 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        gradient.h
+ * @ingroup     core
+ *
+ * the span functions of the gradient shader for one pixel storage,
+ * it will be included by shader.c for each storage and need the following definitions:
+ *
+ * - GB_BITMAP_BILTTER_GRADIENT_BTP(biltter):                   the bytes per pixel
+ * - GB_BITMAP_BILTTER_GRADIENT_OPAQUE(biltter, p, s):          set the pixel s to p
+ * - GB_BITMAP_BILTTER_GRADIENT_BLEND(biltter, p, s, a):        blend the pixel s to p with the alpha a
+ * - GB_BITMAP_BILTTER_GRADIENT(name):                          the function name for this storage
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_void_t GB_BITMAP_BILTTER_GRADIENT(lut_set)(gb_bitmap_biltter_ref_t biltter, tb_byte_t* pixels, gb_bitmap_shader_lut_entry_ref_t entry, tb_size_t scale, tb_bool_t opaque)
+{
+    // all entries are opaque and the span is not faded? set it directly
+    if (opaque)
+    {
+        GB_BITMAP_BILTTER_GRADIENT_OPAQUE(biltter, pixels, entry->pixel);
+        return ;
+    }
+
+    // the alpha of this pixel
+    tb_size_t alpha = (entry->alpha * scale) >> 8;
+
+    // opaque? set it
+    if (alpha == 0xff || alpha > GB_ALPHA_MAXN) GB_BITMAP_BILTTER_GRADIENT_OPAQUE(biltter, pixels, entry->pixel);
+    // blend it if not transparent
+    else if (alpha && alpha >= GB_ALPHA_MINN) GB_BITMAP_BILTTER_GRADIENT_BLEND(biltter, pixels, entry->pixel, alpha);
+}
+static __tb_inline__ tb_void_t GB_BITMAP_BILTTER_GRADIENT(linear_span)(gb_bitmap_biltter_ref_t biltter, tb_byte_t* pixels, tb_long_t w, tb_hong_t t, tb_hong_t dt, tb_size_t scale, tb_bool_t opaque, tb_size_t mode)
+{
+    // the lut
+    gb_bitmap_shader_lut_entry_ref_t lut = (gb_bitmap_shader_lut_entry_ref_t)biltter->u.shader.u.gradient.lut;
+
+    // done it, only one add for the position of the next pixel
+    tb_long_t   i;
+    tb_size_t   btp = GB_BITMAP_BILTTER_GRADIENT_BTP(biltter);
+    tb_byte_t*  tail = pixels + w * btp;
+    for (; pixels < tail; pixels += btp, t += dt)
+    {
+        i = gb_bitmap_biltter_shader_linear_index(t, mode);
+        if (i >= 0) GB_BITMAP_BILTTER_GRADIENT(lut_set)(biltter, pixels, lut + i, scale, opaque);
+    }
+}
+static __tb_inline__ tb_void_t GB_BITMAP_BILTTER_GRADIENT(linear_done)(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w, tb_byte_t coverage)
+{
+    // check
+    tb_assert(biltter && x >= 0 && y >= 0 && w >= 0);
+
+    // the shader
+    gb_bitmap_biltter_shader_t* shader = &biltter->u.shader;
+
+    // the alpha scale of the span: [1, 256]
+    tb_size_t scale = ((shader->alpha + 1) * (coverage + 1)) >> 8;
+
+    // set the opaque pixels without blending them if all entries are opaque and the span is not faded
+    tb_bool_t opaque = (shader->u.gradient.opaque && scale == 256)? tb_true : tb_false;
+
+    // the gradient position of the first pixel center: t = a * (x + 0.5) + b * (y + 0.5) + c
+    tb_hong_t t = ((shader->u.gradient.a * ((x << 1) + 1) + shader->u.gradient.b * ((y << 1) + 1)) >> 1) + shader->u.gradient.c;
+
+    // the pixels
+    tb_byte_t* pixels = (tb_byte_t*)gb_bitmap_data(biltter->bitmap) + y * biltter->row_bytes + x * GB_BITMAP_BILTTER_GRADIENT_BTP(biltter);
+
+    // done it with the constant mode for inlining the lut index
+    switch (shader->mode)
+    {
+    case GB_SHADER_MODE_CLAMP:
+        GB_BITMAP_BILTTER_GRADIENT(linear_span)(biltter, pixels, w, t, shader->u.gradient.a, scale, opaque, GB_SHADER_MODE_CLAMP);
+        break;
+    case GB_SHADER_MODE_REPEAT:
+        GB_BITMAP_BILTTER_GRADIENT(linear_span)(biltter, pixels, w, t, shader->u.gradient.a, scale, opaque, GB_SHADER_MODE_REPEAT);
+        break;
+    case GB_SHADER_MODE_MIRROR:
+        GB_BITMAP_BILTTER_GRADIENT(linear_span)(biltter, pixels, w, t, shader->u.gradient.a, scale, opaque, GB_SHADER_MODE_MIRROR);
+        break;
+    default:
+        GB_BITMAP_BILTTER_GRADIENT(linear_span)(biltter, pixels, w, t, shader->u.gradient.a, scale, opaque, GB_SHADER_MODE_BORDER);
+        break;
+    }
+}
+static __tb_inline__ tb_void_t GB_BITMAP_BILTTER_GRADIENT(radial_span)(gb_bitmap_biltter_ref_t biltter, tb_byte_t* pixels, tb_long_t w, tb_hong_t f, tb_hong_t df, tb_hong_t ddf, tb_size_t scale, tb_bool_t opaque, tb_size_t mode)
+{
+    // the lut
+    gb_bitmap_shader_lut_entry_ref_t lut = (gb_bitmap_shader_lut_entry_ref_t)biltter->u.shader.u.gradient.lut;
+
+    // the pixels
+    tb_long_t   i;
+    tb_long_t   k;
+    tb_size_t   btp = GB_BITMAP_BILTTER_GRADIENT_BTP(biltter);
+    tb_byte_t*  tail = pixels + w * btp;
+    if (biltter->u.shader.u.gradient.incremental)
+    {
+        /* the squared distance range of the lut index i: [lo, hi)
+         *
+         * lo = (i * r / n)^2
+         * hi = ((i + 1) * r / n)^2
+         *
+         * the index moves a few entries only for each pixel, so we need not compute sqrt for it
+         */
+        tb_hong_t rn2 = biltter->u.shader.u.gradient.rn2;
+        tb_hong_t lo;
+        tb_hong_t hi;
+        i   = gb_bitmap_biltter_shader_radial_index(biltter, f);
+        lo  = (tb_hong_t)i * i * rn2;
+        hi  = (tb_hong_t)(i + 1) * (i + 1) * rn2;
+        for (; pixels < tail; pixels += btp)
+        {
+            // update the index
+            while (f >= hi) { i++; lo = hi; hi = (tb_hong_t)(i + 1) * (i + 1) * rn2; }
+            while (f < lo)  { i--; hi = lo; lo = (tb_hong_t)i * i * rn2; }
+
+            // set it
+            k = gb_bitmap_biltter_shader_lut_wrap(i, mode);
+            if (k >= 0) GB_BITMAP_BILTTER_GRADIENT(lut_set)(biltter, pixels, lut + k, scale, opaque);
+
+            // the squared distance of the next pixel with the forward differences
+            f   += df;
+            df  += ddf;
+        }
+    }
+    else
+    {
+        for (; pixels < tail; pixels += btp)
+        {
+            // set it
+            k = gb_bitmap_biltter_shader_lut_wrap(gb_bitmap_biltter_shader_radial_index(biltter, f), mode);
+            if (k >= 0) GB_BITMAP_BILTTER_GRADIENT(lut_set)(biltter, pixels, lut + k, scale, opaque);
+
+            // the squared distance of the next pixel with the forward differences
+            f   += df;
+            df  += ddf;
+        }
+    }
+}
+static __tb_inline__ tb_void_t GB_BITMAP_BILTTER_GRADIENT(radial_done)(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w, tb_byte_t coverage)
+{
+    // check
+    tb_assert(biltter && x >= 0 && y >= 0 && w >= 0);
+
+    // the shader
+    gb_bitmap_biltter_shader_t* shader = &biltter->u.shader;
+
+    // the alpha scale of the span: [1, 256]
+    tb_size_t scale = ((shader->alpha + 1) * (coverage + 1)) >> 8;
+
+    // set the opaque pixels without blending them if all entries are opaque and the span is not faded
+    tb_bool_t opaque = (shader->u.gradient.opaque && scale == 256)? tb_true : tb_false;
+
+    // the offset from the center to the first pixel center in the shader space, 16.16 fixed
+    tb_hong_t dx = ((((tb_hong_t)shader->sx * ((x << 1) + 1) + (tb_hong_t)shader->kx * ((y << 1) + 1)) >> 1) + shader->tx) - shader->u.gradient.cx;
+    tb_hong_t dy = ((((tb_hong_t)shader->ky * ((x << 1) + 1) + (tb_hong_t)shader->sy * ((y << 1) + 1)) >> 1) + shader->ty) - shader->u.gradient.cy;
+
+    /* the squared distance and its forward differences along the span, 32.32 fixed
+     *
+     * f(n)     = (dx + n * sx)^2 + (dy + n * ky)^2
+     * df(n)    = f(n + 1) - f(n) = 2 * (dx * sx + dy * ky) + sx^2 + ky^2 + n * ddf
+     * ddf      = 2 * (sx^2 + ky^2)
+     */
+    tb_hong_t s2    = (tb_hong_t)shader->sx * shader->sx + (tb_hong_t)shader->ky * shader->ky;
+    tb_hong_t f     = dx * dx + dy * dy;
+    tb_hong_t df    = (dx * shader->sx + dy * shader->ky) * 2 + s2;
+    tb_hong_t ddf   = s2 << 1;
+
+    // the pixels
+    tb_byte_t* pixels = (tb_byte_t*)gb_bitmap_data(biltter->bitmap) + y * biltter->row_bytes + x * GB_BITMAP_BILTTER_GRADIENT_BTP(biltter);
+
+    // done it with the constant mode for inlining the lut index
+    switch (shader->mode)
+    {
+    case GB_SHADER_MODE_CLAMP:
+        GB_BITMAP_BILTTER_GRADIENT(radial_span)(biltter, pixels, w, f, df, ddf, scale, opaque, GB_SHADER_MODE_CLAMP);
+        break;
+    case GB_SHADER_MODE_REPEAT:
+        GB_BITMAP_BILTTER_GRADIENT(radial_span)(biltter, pixels, w, f, df, ddf, scale, opaque, GB_SHADER_MODE_REPEAT);
+        break;
+    case GB_SHADER_MODE_MIRROR:
+        GB_BITMAP_BILTTER_GRADIENT(radial_span)(biltter, pixels, w, f, df, ddf, scale, opaque, GB_SHADER_MODE_MIRROR);
+        break;
+    default:
+        GB_BITMAP_BILTTER_GRADIENT(radial_span)(biltter, pixels, w, f, df, ddf, scale, opaque, GB_SHADER_MODE_BORDER);
+        break;
+    }
+}
@@ -31,4 +31,46 @@
 #include "../device.h"
 #include "../biltter.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the pixel storage enum of the specialized biltter
+typedef enum __gb_bitmap_biltter_storage_e
+{
+    GB_BITMAP_BILTTER_STORAGE_NONE      = 0     //!< no specialized biltter, use the pixmap
+,   GB_BITMAP_BILTTER_STORAGE_RGB32     = 1     //!< argb8888, xrgb8888, rgba8888 and rgbx8888
+,   GB_BITMAP_BILTTER_STORAGE_RGB565    = 2     //!< rgb565
+
+}gb_bitmap_biltter_storage_e;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * inlines
+ */
+
+// the pixel storage of the specialized biltter for the given pixfmt
+static __tb_inline__ tb_size_t gb_bitmap_biltter_storage(tb_size_t pixfmt)
+{
+    // only for the native endian
+    tb_check_return_val(GB_PIXFMT_BE(pixfmt) == GB_PIXFMT_NENDIAN, GB_BITMAP_BILTTER_STORAGE_NONE);
+
+    // the storage
+    switch (GB_PIXFMT(pixfmt))
+    {
+    case GB_PIXFMT(GB_PIXFMT_ARGB8888):
+    case GB_PIXFMT(GB_PIXFMT_XRGB8888):
+    case GB_PIXFMT(GB_PIXFMT_RGBA8888):
+    case GB_PIXFMT(GB_PIXFMT_RGBX8888):
+    case GB_PIXFMT(GB_PIXFMT_PARGB8888):
+        return GB_BITMAP_BILTTER_STORAGE_RGB32;
+    case GB_PIXFMT(GB_PIXFMT_RGB565):
+        return GB_BITMAP_BILTTER_STORAGE_RGB565;
+    default:
+        break;
+    }
+
+    // none
+    return GB_BITMAP_BILTTER_STORAGE_NONE;
+}
+
 #endif
@@ -32,20 +32,709 @@
  * includes
  */
 #include "shader.h"
+#include "../shader.h"
+#include "../../../pixmap/rgb16.h"
+#include "../../../pixmap/rgb32.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * the rgb32 storage: argb8888, xrgb8888, rgba8888, rgbx8888
+ */
+#define gb_bitmap_biltter_span_pixel_t              tb_uint32_t
+#define GB_BITMAP_BILTTER_SPAN_FILL(p, s, n)        tb_memset_u32(p, (tb_uint32_t)(s), n)
+#define GB_BITMAP_BILTTER_SPAN_BLEND(d, s, a)       gb_pixmap_rgb32_blend(d, s, (tb_byte_t)(a))
+#define GB_BITMAP_BILTTER_SPAN(name)                gb_bitmap_biltter_rgb32_##name
+#include "span.h"
+#undef gb_bitmap_biltter_span_pixel_t
+#undef GB_BITMAP_BILTTER_SPAN_FILL
+#undef GB_BITMAP_BILTTER_SPAN_BLEND
+#undef GB_BITMAP_BILTTER_SPAN
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * the rgb16 storage: rgb565
+ */
+#define gb_bitmap_biltter_span_pixel_t              tb_uint16_t
+#define GB_BITMAP_BILTTER_SPAN_FILL(p, s, n)        tb_memset_u16(p, (tb_uint16_t)(s), n)
+#define GB_BITMAP_BILTTER_SPAN_BLEND(d, s, a)       gb_pixmap_rgb565_blend(d, s, (tb_byte_t)((a) >> 3))
+#define GB_BITMAP_BILTTER_SPAN(name)                gb_bitmap_biltter_rgb565_##name
+#include "span.h"
+#undef gb_bitmap_biltter_span_pixel_t
+#undef GB_BITMAP_BILTTER_SPAN_FILL
+#undef GB_BITMAP_BILTTER_SPAN_BLEND
+#undef GB_BITMAP_BILTTER_SPAN
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_long_t gb_bitmap_biltter_shader_wrap(tb_long_t i, tb_long_t n, tb_size_t mode)
+{
+    // inside?
+    if ((tb_ulong_t)i < (tb_ulong_t)n) return i;
+
+    // wrap it
+    switch (mode)
+    {
+    case GB_SHADER_MODE_CLAMP:
+        return i < 0? 0 : n - 1;
+    case GB_SHADER_MODE_REPEAT:
+        i %= n;
+        return i < 0? i + n : i;
+    case GB_SHADER_MODE_MIRROR:
+        {
+            tb_long_t n2 = n << 1;
+            i %= n2;
+            if (i < 0) i += n2;
+            return i < n? i : n2 - 1 - i;
+        }
+    default:
+        break;
+    }
+
+    // outside for the border mode
+    return -1;
+}
+static __tb_inline__ tb_void_t gb_bitmap_biltter_shader_pixel_set(gb_bitmap_biltter_ref_t biltter, tb_byte_t* pixels, gb_color_t color, tb_size_t scale)
+{
+    // the alpha of this pixel
+    tb_size_t alpha = (color.a * scale) >> 8;
+
+    // the pixel is opaque and blended with this alpha, so the alpha is not applied twice
+    color.a = 0xff;
+
+    // opaque? set it
+    if (alpha == 0xff || alpha > GB_ALPHA_MAXN) biltter->u.shader.opaque->pixel_set(pixels, biltter->u.shader.opaque->pixel(color), 0xff);
+    // blend it if not transparent
+    else if (alpha && alpha >= GB_ALPHA_MINN) biltter->u.shader.blend->pixel_set(pixels, biltter->u.shader.blend->pixel(color), (tb_byte_t)alpha);
+}
+static __tb_inline__ tb_bool_t gb_bitmap_biltter_shader_bitmap_color(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, gb_color_t* color)
+{
+    // the shader
+    gb_bitmap_biltter_shader_t* shader = &biltter->u.shader;
+
+    // wrap the coordinate
+    x = gb_bitmap_biltter_shader_wrap(x, shader->u.bitmap.width, shader->mode);
+    y = gb_bitmap_biltter_shader_wrap(y, shader->u.bitmap.height, shader->mode);
+
+    // outside?
+    tb_check_return_val(x >= 0 && y >= 0, tb_false);
+
+    // get the color
+    *color = shader->u.bitmap.pixmap->color_get(shader->u.bitmap.data + y * shader->u.bitmap.row_bytes + x * shader->u.bitmap.btp);
+    if (!shader->u.bitmap.has_alpha) color->a = 0xff;
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t gb_bitmap_biltter_shader_bitmap_color_filter(gb_bitmap_biltter_ref_t biltter, tb_fixed_t u, tb_fixed_t v, gb_color_t* color)
+{
+    // the top-left pixel and the fractions for the pixel centers
+    u -= TB_FIXED_HALF;
+    v -= TB_FIXED_HALF;
+    tb_long_t   x = u >> 16;
+    tb_long_t   y = v >> 16;
+    tb_size_t   fx = (u >> 8) & 0xff;
+    tb_size_t   fy = (v >> 8) & 0xff;
+
+    // the weights of the four pixels, the sum is 65536
+    tb_size_t   weights[4];
+    weights[0] = (256 - fx) * (256 - fy);
+    weights[1] = fx * (256 - fy);
+    weights[2] = (256 - fx) * fy;
+    weights[3] = fx * fy;
+
+    /* interpolate the premultiplied colors 
+     *
+     * a * w <= 255 * 65536 and c * a * w <= 255 * 255 * 65536, so tb_uint32_t is enough
+     */
+    tb_size_t   i = 0;
+    tb_uint32_t a = 0;
+    tb_uint32_t r = 0;
+    tb_uint32_t g = 0;
+    tb_uint32_t b = 0;
+    tb_uint32_t aw = 0;
+    gb_color_t  sample;
+    for (i = 0; i < 4; i++)
+    {
+        // no weight?
+        tb_check_continue(weights[i]);
+
+        // get the sample, the outside sample is transparent
+        if (!gb_bitmap_biltter_shader_bitmap_color(biltter, x + (i & 1), y + (i >> 1), &sample)) continue;
+
+        // accumulate it
+        aw  = sample.a * weights[i];
+        a  += aw;
+        r  += sample.r * aw;
+        g  += sample.g * aw;
+        b  += sample.b * aw;
+    }
+
+    // transparent?
+    tb_check_return_val(a, tb_false);
+
+    // make color
+    color->a = (tb_byte_t)(a >> 16);
+    color->r = (tb_byte_t)(r / a);
+    color->g = (tb_byte_t)(g / a);
+    color->b = (tb_byte_t)(b / a);
+
+    // ok
+    return tb_true;
+}
+static tb_void_t gb_bitmap_biltter_shader_bitmap_copy(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w)
+{
+    // the shader
+    gb_bitmap_biltter_shader_t* shader = &biltter->u.shader;
+
+    // the source row
+    tb_long_t   width = shader->u.bitmap.width;
+    tb_size_t   mode = shader->mode;
+    tb_long_t   sy = gb_bitmap_biltter_shader_wrap(y + (shader->ty >> 16), shader->u.bitmap.height, mode);
+    tb_check_return(sy >= 0);
+
+    // the factors
+    tb_size_t           btp = biltter->btp;
+    tb_byte_t*          pixels = (tb_byte_t*)gb_bitmap_data(biltter->bitmap) + y * biltter->row_bytes + x * btp;
+    tb_byte_t const*    source = shader->u.bitmap.data + sy * shader->u.bitmap.row_bytes;
+    gb_pixmap_ref_t     opaque = shader->opaque;
+
+    // copy the pixels
+    tb_long_t   n = 0;
+    tb_long_t   sx = x + (shader->tx >> 16);
+    while (w > 0)
+    {
+        // inside? copy it
+        if (sx >= 0 && sx < width)
+        {
+            n = tb_min(w, width - sx);
+            tb_memcpy(pixels, source + sx * btp, n * btp);
+        }
+        // repeat? copy the wrapped pixels
+        else if (mode == GB_SHADER_MODE_REPEAT)
+        {
+            tb_long_t i = gb_bitmap_biltter_shader_wrap(sx, width, mode);
+            n = tb_min(w, width - i);
+            tb_memcpy(pixels, source + i * btp, n * btp);
+        }
+        // clamp? fill the edge pixel
+        else if (mode == GB_SHADER_MODE_CLAMP)
+        {
+            n = sx < 0? tb_min(w, -sx) : w;
+            opaque->pixels_fill(pixels, opaque->pixel_get(source + (sx < 0? 0 : width - 1) * btp), n, 0xff);
+        }
+        // mirror? copy the mirrored pixel
+        else if (mode == GB_SHADER_MODE_MIRROR)
+        {
+            n = 1;
+            opaque->pixel_cpy(pixels, source + gb_bitmap_biltter_shader_wrap(sx, width, mode) * btp, 0xff);
+        }
+        // border? skip the outside pixels
+        else
+        {
+            tb_check_break(sx < 0);
+            n = tb_min(w, -sx);
+        }
+
+        // next
+        pixels  += n * btp;
+        sx      += n;
+        w       -= n;
+    }
+}
+static tb_void_t gb_bitmap_biltter_shader_bitmap_over(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w, tb_byte_t alpha)
+{
+    // the shader
+    gb_bitmap_biltter_shader_t* shader = &biltter->u.shader;
+
+    // the source row
+    tb_long_t   width = shader->u.bitmap.width;
+    tb_size_t   mode = shader->mode;
+    tb_long_t   sy = gb_bitmap_biltter_shader_wrap(y + (shader->ty >> 16), shader->u.bitmap.height, mode);
+    tb_check_return(sy >= 0);
+
+    // the factors
+    tb_size_t           btp = biltter->btp;
+    tb_byte_t*          pixels = (tb_byte_t*)gb_bitmap_data(biltter->bitmap) + y * biltter->row_bytes + x * btp;
+    tb_byte_t*          tail = pixels + w * btp;
+    tb_byte_t const*    source = shader->u.bitmap.data + sy * shader->u.bitmap.row_bytes;
+    gb_pixmap_ref_t     blend = shader->blend;
+
+    // composite the premultiplied pixels without unpremultiplying them
+    tb_long_t   i = 0;
+    tb_long_t   sx = x + (shader->tx >> 16);
+    for (; pixels < tail; pixels += btp, sx++)
+    {
+        i = gb_bitmap_biltter_shader_wrap(sx, width, mode);
+        if (i >= 0) blend->pixel_cpy(pixels, source + i * btp, alpha);
+    }
+}
+static tb_void_t gb_bitmap_biltter_shader_bitmap_done(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w, tb_byte_t coverage)
+{
+    // check
+    tb_assert(biltter && x >= 0 && y >= 0 && w >= 0);
+
+    // the shader
+    gb_bitmap_biltter_shader_t* shader = &biltter->u.shader;
+
+    // copy the source rows directly for the integer translation
+    if (shader->u.bitmap.copy && coverage == 0xff) 
+    {
+        gb_bitmap_biltter_shader_bitmap_copy(biltter, x, y, w);
+        return ;
+    }
+
+    // the alpha scale of the span: [1, 256]
+    tb_size_t scale = ((shader->alpha + 1) * (coverage + 1)) >> 8;
+
+    // composite the premultiplied source rows directly for the integer translation
+    if (shader->u.bitmap.over)
+    {
+        gb_bitmap_biltter_shader_bitmap_over(biltter, x, y, w, (tb_byte_t)((scale * 255) >> 8));
+        return ;
+    }
+
+    /* the source coordinate of the first pixel center, 16.16 fixed
+     *
+     * u = sx * (x + 0.5) + kx * (y + 0.5) + tx
+     * v = ky * (x + 0.5) + sy * (y + 0.5) + ty
+     */
+    tb_fixed_t  u = (tb_fixed_t)((((tb_hong_t)shader->sx * ((x << 1) + 1) + (tb_hong_t)shader->kx * ((y << 1) + 1)) >> 1) + shader->tx);
+    tb_fixed_t  v = (tb_fixed_t)((((tb_hong_t)shader->ky * ((x << 1) + 1) + (tb_hong_t)shader->sy * ((y << 1) + 1)) >> 1) + shader->ty);
+    tb_fixed_t  du = shader->sx;
+    tb_fixed_t  dv = shader->ky;
+
+    // the pixels
+    tb_size_t   btp = biltter->btp;
+    tb_byte_t*  pixels = (tb_byte_t*)gb_bitmap_data(biltter->bitmap) + y * biltter->row_bytes + x * btp;
+    tb_byte_t*  tail = pixels + w * btp;
+
+    // done it with the incremental dda
+    gb_color_t  color;
+    if (shader->u.bitmap.filter)
+    {
+        for (; pixels < tail; pixels += btp, u += du, v += dv)
+        {
+            if (gb_bitmap_biltter_shader_bitmap_color_filter(biltter, u, v, &color))
+                gb_bitmap_biltter_shader_pixel_set(biltter, pixels, color, scale);
+        }
+    }
+    else
+    {
+        for (; pixels < tail; pixels += btp, u += du, v += dv)
+        {
+            if (gb_bitmap_biltter_shader_bitmap_color(biltter, u >> 16, v >> 16, &color))
+                gb_bitmap_biltter_shader_pixel_set(biltter, pixels, color, scale);
+        }
+    }
+}
+static tb_bool_t gb_bitmap_biltter_shader_bitmap_init(gb_bitmap_biltter_ref_t biltter, gb_paint_ref_t paint)
+{
+    // the shader
+    gb_bitmap_biltter_shader_t* shader = &biltter->u.shader;
+
+    // the source bitmap
+    gb_bitmap_ref_t bitmap = ((gb_bitmap_shader_ref_t)shader->shader)->u.bitmap;
+    tb_assert_and_check_return_val(bitmap && gb_bitmap_width(bitmap) && gb_bitmap_height(bitmap), tb_false);
+
+    /* the footprint of one device pixel in the source bitmap, 16.16 fixed
+     *
+     * it is the longer length of the columns of the inverse matrix, (sx, ky) and (kx, sy),
+     * and the source is minified by this footprint
+     *
+     * the components are clamped to 2^30 for the squared sums without overflow,
+     * it is far beyond the last mipmap level of the max bitmap size
+     */
+    tb_hong_t sx = tb_min(tb_abs((tb_hong_t)shader->sx), (tb_hong_t)1 << 30);
+    tb_hong_t kx = tb_min(tb_abs((tb_hong_t)shader->kx), (tb_hong_t)1 << 30);
+    tb_hong_t ky = tb_min(tb_abs((tb_hong_t)shader->ky), (tb_hong_t)1 << 30);
+    tb_hong_t sy = tb_min(tb_abs((tb_hong_t)shader->sy), (tb_hong_t)1 << 30);
+    tb_hong_t fx = sx * sx + ky * ky;
+    tb_hong_t fy = kx * kx + sy * sy;
+    tb_hong_t footprint = tb_max(fx, fy);
+
+    // the mipmap level: floor(log2(footprint)), each level halves the footprint
+    tb_size_t level = 0;
+    while (level < 30 && footprint >= ((tb_hong_t)4 << 32))
+    {
+        footprint >>= 2;
+        level++;
+    }
+
+    // sample the mipmap for the minified source
+    if (level)
+    {
+        // the mipmap of this level, it will be clamped to the last level
+        gb_bitmap_ref_t mipmap = gb_bitmap_mipmap(bitmap, level);
+        if (mipmap && mipmap != bitmap)
+        {
+            // map the coordinate to the mipmap: u' = u * mw / w, v' = v * mh / h
+            tb_hong_t w = gb_bitmap_width(bitmap);
+            tb_hong_t h = gb_bitmap_height(bitmap);
+            tb_hong_t mw = gb_bitmap_width(mipmap);
+            tb_hong_t mh = gb_bitmap_height(mipmap);
+            shader->sx = (tb_fixed_t)(shader->sx * mw / w);
+            shader->kx = (tb_fixed_t)(shader->kx * mw / w);
+            shader->tx = (tb_fixed_t)(shader->tx * mw / w);
+            shader->ky = (tb_fixed_t)(shader->ky * mh / h);
+            shader->sy = (tb_fixed_t)(shader->sy * mh / h);
+            shader->ty = (tb_fixed_t)(shader->ty * mh / h);
+
+            // use the mipmap
+            bitmap = mipmap;
+        }
+    }
+
+    // init the source pixmap
+    shader->u.bitmap.pixmap = gb_pixmap(gb_bitmap_pixfmt(bitmap), 0xff);
+    tb_assert_and_check_return_val(shader->u.bitmap.pixmap && shader->u.bitmap.pixmap->color_get, tb_false);
+
+    // init the source
+    shader->u.bitmap.data       = (tb_byte_t const*)gb_bitmap_data(bitmap);
+    shader->u.bitmap.width      = gb_bitmap_width(bitmap);
+    shader->u.bitmap.height     = gb_bitmap_height(bitmap);
+    shader->u.bitmap.row_bytes  = gb_bitmap_row_bytes(bitmap);
+    shader->u.bitmap.btp        = shader->u.bitmap.pixmap->btp;
+    shader->u.bitmap.has_alpha  = gb_bitmap_has_alpha(bitmap)? 1 : 0;
+    shader->u.bitmap.filter     = (gb_paint_flag(paint) & GB_PAINT_FLAG_FILTER_BITMAP)? 1 : 0;
+    tb_assert_and_check_return_val(shader->u.bitmap.data && shader->u.bitmap.width && shader->u.bitmap.height, tb_false);
+
+    /* copy the source rows directly?
+     *
+     * the same opaque pixel format and only translated by the integer offset,
+     * and the opaque source replaces the destination for the blend mode
+     */
+    tb_size_t blend = gb_paint_blend(paint);
+    shader->u.bitmap.copy       =   (   gb_bitmap_pixfmt(bitmap) == gb_bitmap_pixfmt(biltter->bitmap)
+                                    &&  (blend == GB_PAINT_BLEND_SRC_OVER || blend == GB_PAINT_BLEND_SRC)
+                                    &&  !shader->u.bitmap.has_alpha
+                                    &&  shader->alpha == 0xff
+                                    &&  shader->sx == TB_FIXED_ONE && shader->sy == TB_FIXED_ONE
+                                    &&  !shader->kx && !shader->ky
+                                    &&  !(shader->tx & 0xffff) && !(shader->ty & 0xffff))? 1 : 0;
+
+    /* composite the premultiplied source rows directly?
+     *
+     * the same pargb8888 pixel format with alpha and only translated by the integer offset,
+     * and the pixel_cpy of the blend pixmap is the premultiplied src-over
+     */
+    shader->u.bitmap.over       =   (   !shader->u.bitmap.copy
+                                    &&  gb_bitmap_pixfmt(bitmap) == gb_bitmap_pixfmt(biltter->bitmap)
+                                    &&  GB_PIXFMT(gb_bitmap_pixfmt(bitmap)) == GB_PIXFMT(GB_PIXFMT_PARGB8888)
+                                    &&  blend == GB_PAINT_BLEND_SRC_OVER
+                                    &&  shader->sx == TB_FIXED_ONE && shader->sy == TB_FIXED_ONE
+                                    &&  !shader->kx && !shader->ky
+                                    &&  !(shader->tx & 0xffff) && !(shader->ty & 0xffff))? 1 : 0;
+
+    // init done
+    shader->done = gb_bitmap_biltter_shader_bitmap_done;
+
+    // ok
+    return tb_true;
+}
+static __tb_inline__ tb_long_t gb_bitmap_biltter_shader_lut_wrap(tb_long_t i, tb_size_t mode)
+{
+    // inside?
+    if ((tb_ulong_t)i < GB_BITMAP_SHADER_LUT_SIZE) return i;
+
+    // wrap it
+    switch (mode)
+    {
+    case GB_SHADER_MODE_CLAMP:
+        return i < 0? 0 : GB_BITMAP_SHADER_LUT_SIZE - 1;
+    case GB_SHADER_MODE_REPEAT:
+        return i & (GB_BITMAP_SHADER_LUT_SIZE - 1);
+    case GB_SHADER_MODE_MIRROR:
+        i &= (GB_BITMAP_SHADER_LUT_SIZE << 1) - 1;
+        return i < GB_BITMAP_SHADER_LUT_SIZE? i : (GB_BITMAP_SHADER_LUT_SIZE << 1) - 1 - i;
+    default:
+        break;
+    }
+
+    // outside for the border mode
+    return -1;
+}
+static __tb_inline__ tb_long_t gb_bitmap_biltter_shader_linear_index(tb_hong_t t, tb_size_t mode)
+{
+    // wrap the position to [0, 1] if be outside, 32.32 fixed
+    if ((tb_hize_t)t > ((tb_hize_t)1 << 32))
+    {
+        switch (mode)
+        {
+        case GB_SHADER_MODE_CLAMP:
+            t = t < 0? 0 : ((tb_hong_t)1 << 32);
+            break;
+        case GB_SHADER_MODE_REPEAT:
+            t &= ((tb_hong_t)1 << 32) - 1;
+            break;
+        case GB_SHADER_MODE_MIRROR:
+            t &= ((tb_hong_t)1 << 33) - 1;
+            if (t > ((tb_hong_t)1 << 32)) t = ((tb_hong_t)1 << 33) - t;
+            break;
+        default:
+            // outside for the border mode
+            return -1;
+        }
+    }
+
+    /* the lut index: round(t * (n - 1))
+     *
+     * the entry i is baked at i / (n - 1), so the stops at 0 and 1 hit the first and last entries
+     */
+    return (tb_long_t)((t * (GB_BITMAP_SHADER_LUT_SIZE - 1) + ((tb_hong_t)1 << 31)) >> 32);
+}
+static __tb_inline__ tb_long_t gb_bitmap_biltter_shader_radial_index(gb_bitmap_biltter_ref_t biltter, tb_hong_t f)
+{
+    // the distance to the center, 16.16 fixed
+    tb_hong_t d = tb_isqrti64((tb_uint64_t)f);
+
+    // the lut index
+    return (tb_long_t)((d * biltter->u.shader.u.gradient.rinv) >> 32);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * the gradient spans for the pixmap
+ */
+#define GB_BITMAP_BILTTER_GRADIENT_BTP(biltter)             ((biltter)->btp)
+#define GB_BITMAP_BILTTER_GRADIENT_OPAQUE(biltter, p, s)    (biltter)->u.shader.opaque->pixel_set(p, s, 0xff)
+#define GB_BITMAP_BILTTER_GRADIENT_BLEND(biltter, p, s, a)  (biltter)->u.shader.blend->pixel_set(p, s, (tb_byte_t)(a))
+#define GB_BITMAP_BILTTER_GRADIENT(name)                    gb_bitmap_biltter_shader_##name
+#include "gradient.h"
+#undef GB_BITMAP_BILTTER_GRADIENT_BTP
+#undef GB_BITMAP_BILTTER_GRADIENT_OPAQUE
+#undef GB_BITMAP_BILTTER_GRADIENT_BLEND
+#undef GB_BITMAP_BILTTER_GRADIENT
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * the gradient spans for the rgb32 storage
+ */
+#define GB_BITMAP_BILTTER_GRADIENT_BTP(biltter)             (4)
+#define GB_BITMAP_BILTTER_GRADIENT_OPAQUE(biltter, p, s)    (*((tb_uint32_t*)(p)) = (tb_uint32_t)(s))
+#define GB_BITMAP_BILTTER_GRADIENT_BLEND(biltter, p, s, a)  gb_bitmap_biltter_rgb32_pixel_set(p, s, a)
+#define GB_BITMAP_BILTTER_GRADIENT(name)                    gb_bitmap_biltter_shader_rgb32_##name
+#include "gradient.h"
+#undef GB_BITMAP_BILTTER_GRADIENT_BTP
+#undef GB_BITMAP_BILTTER_GRADIENT_OPAQUE
+#undef GB_BITMAP_BILTTER_GRADIENT_BLEND
+#undef GB_BITMAP_BILTTER_GRADIENT
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * the gradient spans for the rgb565 storage
+ */
+#define GB_BITMAP_BILTTER_GRADIENT_BTP(biltter)             (2)
+#define GB_BITMAP_BILTTER_GRADIENT_OPAQUE(biltter, p, s)    (*((tb_uint16_t*)(p)) = (tb_uint16_t)(s))
+#define GB_BITMAP_BILTTER_GRADIENT_BLEND(biltter, p, s, a)  gb_bitmap_biltter_rgb565_pixel_set(p, s, a)
+#define GB_BITMAP_BILTTER_GRADIENT(name)                    gb_bitmap_biltter_shader_rgb565_##name
+#include "gradient.h"
+#undef GB_BITMAP_BILTTER_GRADIENT_BTP
+#undef GB_BITMAP_BILTTER_GRADIENT_OPAQUE
+#undef GB_BITMAP_BILTTER_GRADIENT_BLEND
+#undef GB_BITMAP_BILTTER_GRADIENT
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_hong_t gb_bitmap_biltter_shader_linear_ratio(tb_hong_t n, tb_hong_t l)
+{
+    // n / l, 32.32 fixed for the 32.32 n and the 16.16 l
+    return (n / l) * 65536 + ((n % l) * 65536) / l;
+}
+static tb_bool_t gb_bitmap_biltter_shader_linear_init(gb_bitmap_biltter_ref_t biltter, gb_paint_ref_t paint)
+{
+    // the shader
+    gb_bitmap_biltter_shader_t* shader = &biltter->u.shader;
+
+    // the gradient shader
+    gb_bitmap_shader_ref_t impl = (gb_bitmap_shader_ref_t)shader->shader;
+    tb_assert_and_check_return_val(impl->u.gradient.lut, tb_false);
+
+    // the lut is baked for the pixfmt of the device
+    tb_assert_and_check_return_val(impl->u.gradient.pixfmt == gb_bitmap_pixfmt(biltter->bitmap), tb_false);
+
+    // init the lut
+    shader->u.gradient.lut      = impl->u.gradient.lut;
+    shader->u.gradient.opaque   = impl->u.gradient.opaque;
+
+    // the line, 16.16 fixed
+    gb_line_ref_t   line = &impl->u.gradient.u.line;
+    tb_hong_t       x0 = gb_float_to_fixed(line->p0.x);
+    tb_hong_t       y0 = gb_float_to_fixed(line->p0.y);
+    tb_hong_t       dx = gb_float_to_fixed(line->p1.x) - x0;
+    tb_hong_t       dy = gb_float_to_fixed(line->p1.y) - y0;
+
+    // the length of the line, 16.16 fixed
+    tb_hong_t       l = tb_isqrti64((tb_uint64_t)(dx * dx + dy * dy));
+    tb_check_return_val(l > 0, tb_false);
+
+    // the unit direction of the line, 16.16 fixed
+    tb_hong_t       ex = (dx * 65536) / l;
+    tb_hong_t       ey = (dy * 65536) / l;
+
+    /* project the device pixel to the line in the shader space
+     *
+     * t = ((u - x0) * ex + (v - y0) * ey) / l
+     *   = a * x + b * y + c
+     *
+     * a = (sx * ex + ky * ey) / l
+     * b = (kx * ex + sy * ey) / l
+     * c = ((tx - x0) * ex + (ty - y0) * ey) / l
+     */
+    shader->u.gradient.a = gb_bitmap_biltter_shader_linear_ratio((tb_hong_t)shader->sx * ex + (tb_hong_t)shader->ky * ey, l);
+    shader->u.gradient.b = gb_bitmap_biltter_shader_linear_ratio((tb_hong_t)shader->kx * ex + (tb_hong_t)shader->sy * ey, l);
+    shader->u.gradient.c = gb_bitmap_biltter_shader_linear_ratio((shader->tx - x0) * ex + (shader->ty - y0) * ey, l);
+
+    // init done for the storage, the compositing pixmap need the generic version
+    switch (biltter->composite? GB_BITMAP_BILTTER_STORAGE_NONE : gb_bitmap_biltter_storage(gb_bitmap_pixfmt(biltter->bitmap)))
+    {
+    case GB_BITMAP_BILTTER_STORAGE_RGB32:
+        shader->done = gb_bitmap_biltter_shader_rgb32_linear_done;
+        break;
+    case GB_BITMAP_BILTTER_STORAGE_RGB565:
+        shader->done = gb_bitmap_biltter_shader_rgb565_linear_done;
+        break;
+    default:
+        shader->done = gb_bitmap_biltter_shader_linear_done;
+        break;
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t gb_bitmap_biltter_shader_radial_init(gb_bitmap_biltter_ref_t biltter, gb_paint_ref_t paint)
+{
+    // the shader
+    gb_bitmap_biltter_shader_t* shader = &biltter->u.shader;
+
+    // the gradient shader
+    gb_bitmap_shader_ref_t impl = (gb_bitmap_shader_ref_t)shader->shader;
+    tb_assert_and_check_return_val(impl->u.gradient.lut, tb_false);
+
+    // the lut is baked for the pixfmt of the device
+    tb_assert_and_check_return_val(impl->u.gradient.pixfmt == gb_bitmap_pixfmt(biltter->bitmap), tb_false);
+
+    // init the lut
+    shader->u.gradient.lut      = impl->u.gradient.lut;
+    shader->u.gradient.opaque   = impl->u.gradient.opaque;
+
+    // the circle, 16.16 fixed
+    gb_circle_ref_t circle = &impl->u.gradient.u.circle;
+    tb_hong_t       r = gb_float_to_fixed(circle->r);
+    tb_check_return_val(r > 0, tb_false);
+
+    // init the center
+    shader->u.gradient.cx       = gb_float_to_fixed(circle->c.x);
+    shader->u.gradient.cy       = gb_float_to_fixed(circle->c.y);
+
+    // init the lut entries per the distance 
+    shader->u.gradient.rinv     = ((tb_hong_t)GB_BITMAP_SHADER_LUT_SIZE << 32) / r;
+
+    // init the squared radius of one lut entry
+    shader->u.gradient.rn2      = (r * r) >> (GB_BITMAP_SHADER_LUT_BITS << 1);
+
+    /* evaluate the lut index incrementally if one pixel moves a few entries only,
+     * otherwise compute the distance with sqrt for each pixel
+     */
+    tb_hong_t s2 = (tb_hong_t)shader->sx * shader->sx + (tb_hong_t)shader->ky * shader->ky;
+    shader->u.gradient.incremental = (shader->u.gradient.rn2 > 0 && s2 <= (shader->u.gradient.rn2 << 4))? tb_true : tb_false;
+
+    // init done for the storage, the compositing pixmap need the generic version
+    switch (biltter->composite? GB_BITMAP_BILTTER_STORAGE_NONE : gb_bitmap_biltter_storage(gb_bitmap_pixfmt(biltter->bitmap)))
+    {
+    case GB_BITMAP_BILTTER_STORAGE_RGB32:
+        shader->done = gb_bitmap_biltter_shader_rgb32_radial_done;
+        break;
+    case GB_BITMAP_BILTTER_STORAGE_RGB565:
+        shader->done = gb_bitmap_biltter_shader_rgb565_radial_done;
+        break;
+    default:
+        shader->done = gb_bitmap_biltter_shader_radial_done;
+        break;
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_void_t gb_bitmap_biltter_shader_done_p(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y)
+{
+    // check
+    tb_assert(biltter && biltter->u.shader.done);
+
+    // done
+    biltter->u.shader.done(biltter, x, y, 1, 0xff);
+}
+static tb_void_t gb_bitmap_biltter_shader_done_h(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w)
+{
+    // check
+    tb_assert(biltter && biltter->u.shader.done);
+
+    // no width? ignore it
+    tb_check_return(w);
+
+    // done
+    biltter->u.shader.done(biltter, x, y, w, 0xff);
+}
+static tb_void_t gb_bitmap_biltter_shader_done_v(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t h)
+{
+    // check
+    tb_assert(biltter && biltter->u.shader.done);
+
+    // done
+    while (h-- > 0) biltter->u.shader.done(biltter, x, y++, 1, 0xff);
+}
+static tb_void_t gb_bitmap_biltter_shader_done_r(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w, tb_long_t h)
+{
+    // check
+    tb_assert(biltter && biltter->u.shader.done);
+
+    // no width? ignore it
+    tb_check_return(w);
+
+    // done
+    while (h-- > 0) biltter->u.shader.done(biltter, x, y++, w, 0xff);
+}
+static tb_void_t gb_bitmap_biltter_shader_done_s(gb_bitmap_biltter_ref_t biltter, gb_polygon_raster_span_ref_t spans, tb_size_t count)
+{
+    // check
+    tb_assert(biltter && biltter->u.shader.done && spans);
+
+    // done
+    gb_polygon_raster_span_ref_t tail = spans + count;
+    for (; spans < tail; spans++)
+    {
+        if (spans->x1 > spans->x0) biltter->u.shader.done(biltter, spans->x0, spans->y, spans->x1 - spans->x0, spans->coverage);
+    }
+}
+static tb_void_t gb_bitmap_biltter_shader_done_m(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w, tb_long_t h, tb_byte_t const* mask, tb_size_t mask_row_bytes)
+{
+    // check
+    tb_assert(biltter && biltter->u.shader.done && mask);
+
+    // done the runs of the same coverage
+    tb_long_t   i;
+    tb_long_t   e;
+    tb_byte_t   coverage;
+    for (; h--; y++, mask += mask_row_bytes)
+    {
+        for (i = 0; i < w; i = e)
+        {
+            coverage = mask[i];
+            for (e = i + 1; e < w && mask[e] == coverage; e++) ;
+            if (coverage) biltter->u.shader.done(biltter, x + i, y, e - i, coverage);
+        }
+    }
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
-tb_bool_t gb_bitmap_biltter_shader_init(gb_bitmap_biltter_ref_t biltter, gb_bitmap_ref_t bitmap, gb_paint_ref_t paint)
+tb_bool_t gb_bitmap_biltter_shader_init(gb_bitmap_biltter_ref_t biltter, gb_bitmap_ref_t bitmap, gb_matrix_ref_t matrix, gb_paint_ref_t paint)
 {
     // check
-    tb_assert(biltter && bitmap && paint);
+    tb_assert(biltter && bitmap && matrix && paint);
  
     // init bitmap
     biltter->bitmap = bitmap;
 
     // init pixmap
-    biltter->pixmap = gb_pixmap(gb_bitmap_pixfmt(bitmap), gb_paint_alpha(paint));
+    biltter->pixmap = biltter->composite? biltter->composite : gb_pixmap(gb_bitmap_pixfmt(bitmap), gb_paint_alpha(paint));
     tb_check_return_val(biltter->pixmap, tb_false);
 
     // init btp and row_bytes
@@ -53,15 +742,57 @@ tb_bool_t gb_bitmap_biltter_shader_init(gb_bitmap_biltter_ref_t biltter, gb_bitm
     biltter->row_bytes  = gb_bitmap_row_bytes(biltter->bitmap);
 
     // init shader
-    // TODO
+    gb_bitmap_biltter_shader_t* shader = &biltter->u.shader;
+    shader->shader      = gb_paint_shader(paint);
+    shader->mode        = (tb_byte_t)gb_shader_mode(shader->shader);
+    shader->alpha       = gb_paint_alpha(paint);
+    shader->done        = tb_null;
+    tb_assert_and_check_return_val(shader->shader, tb_false);
 
-    // init operations
-    // TODO
+    // init the opaque and blend pixmaps, the compositing pixmap is used for both
+    shader->opaque      = biltter->composite? biltter->composite : gb_pixmap(gb_bitmap_pixfmt(bitmap), 0xff);
+    shader->blend       = biltter->composite? biltter->composite : gb_pixmap(gb_bitmap_pixfmt(bitmap), GB_ALPHA_MAXN);
+    tb_assert_and_check_return_val(shader->opaque && shader->blend, tb_false);
 
-    // trace
-    tb_trace_noimpl();
+    // init the inverse matrix: device => shader
+    gb_matrix_t inverse = *matrix;
+    gb_matrix_multiply(&inverse, gb_shader_matrix(shader->shader));
+    if (!gb_matrix_invert(&inverse)) return tb_false;
+    shader->sx          = gb_float_to_fixed(inverse.sx);
+    shader->kx          = gb_float_to_fixed(inverse.kx);
+    shader->ky          = gb_float_to_fixed(inverse.ky);
+    shader->sy          = gb_float_to_fixed(inverse.sy);
+    shader->tx          = gb_float_to_fixed(inverse.tx);
+    shader->ty          = gb_float_to_fixed(inverse.ty);
+
+    // init the shader for the type
+    tb_bool_t ok = tb_false;
+    switch (gb_shader_type(shader->shader))
+    {
+    case GB_SHADER_TYPE_BITMAP:
+        ok = gb_bitmap_biltter_shader_bitmap_init(biltter, paint);
+        break;
+    case GB_SHADER_TYPE_LINEAR:
+        ok = gb_bitmap_biltter_shader_linear_init(biltter, paint);
+        break;
+    case GB_SHADER_TYPE_RADIAL:
+        ok = gb_bitmap_biltter_shader_radial_init(biltter, paint);
+        break;
+    default:
+        tb_trace_noimpl();
+        break;
+    }
+    tb_check_return_val(ok && shader->done, tb_false);
+
+    // init operations
+    biltter->done_p     = gb_bitmap_biltter_shader_done_p;
+    biltter->done_h     = gb_bitmap_biltter_shader_done_h;
+    biltter->done_v     = gb_bitmap_biltter_shader_done_v;
+    biltter->done_r     = gb_bitmap_biltter_shader_done_r;
+    biltter->done_s     = gb_bitmap_biltter_shader_done_s;
+    biltter->done_m     = gb_bitmap_biltter_shader_done_m;
+    biltter->exit       = tb_null;
 
     // ok
-    return tb_false;
+    return tb_true;
 }
-
@@ -32,6 +32,34 @@
  * includes
  */
 #include "solid.h"
+#include "../../../pixmap/rgb16.h"
+#include "../../../pixmap/rgb32.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * the rgb32 storage: argb8888, xrgb8888, rgba8888, rgbx8888
+ */
+#define gb_bitmap_biltter_span_pixel_t              tb_uint32_t
+#define GB_BITMAP_BILTTER_SPAN_FILL(p, s, n)        tb_memset_u32(p, (tb_uint32_t)(s), n)
+#define GB_BITMAP_BILTTER_SPAN_BLEND(d, s, a)       gb_pixmap_rgb32_blend(d, s, (tb_byte_t)(a))
+#define GB_BITMAP_BILTTER_SPAN(name)                gb_bitmap_biltter_rgb32_##name
+#include "span.h"
+#undef gb_bitmap_biltter_span_pixel_t
+#undef GB_BITMAP_BILTTER_SPAN_FILL
+#undef GB_BITMAP_BILTTER_SPAN_BLEND
+#undef GB_BITMAP_BILTTER_SPAN
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * the rgb16 storage: rgb565
+ */
+#define gb_bitmap_biltter_span_pixel_t              tb_uint16_t
+#define GB_BITMAP_BILTTER_SPAN_FILL(p, s, n)        tb_memset_u16(p, (tb_uint16_t)(s), n)
+#define GB_BITMAP_BILTTER_SPAN_BLEND(d, s, a)       gb_pixmap_rgb565_blend(d, s, (tb_byte_t)((a) >> 3))
+#define GB_BITMAP_BILTTER_SPAN(name)                gb_bitmap_biltter_rgb565_##name
+#include "span.h"
+#undef gb_bitmap_biltter_span_pixel_t
+#undef GB_BITMAP_BILTTER_SPAN_FILL
+#undef GB_BITMAP_BILTTER_SPAN_BLEND
+#undef GB_BITMAP_BILTTER_SPAN
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
@@ -120,6 +148,137 @@ static tb_void_t gb_bitmap_biltter_solid_done_r(gb_bitmap_biltter_ref_t biltter,
         }
     }
 }
+static tb_void_t gb_bitmap_biltter_solid_done_s(gb_bitmap_biltter_ref_t biltter, gb_polygon_raster_span_ref_t spans, tb_size_t count)
+{
+    // check
+    tb_assert(biltter && biltter->pixmap && biltter->pixmap->pixels_fill);
+    tb_assert(biltter->u.solid.blend && biltter->u.solid.blend->pixels_fill);
+    tb_assert(spans);
+
+    // the pixels
+    tb_byte_t* pixels = (tb_byte_t*)gb_bitmap_data(biltter->bitmap);
+    tb_assert(pixels);
+
+    // the factors
+    tb_size_t                       btp = biltter->btp;
+    tb_size_t                       row_bytes = biltter->row_bytes;
+    gb_pixel_t                      pixel = biltter->u.solid.pixel;
+    tb_size_t                       alpha = biltter->u.solid.alpha;
+    gb_pixmap_func_pixels_fill_t    pixels_fill = biltter->pixmap->pixels_fill;
+    gb_pixmap_func_pixels_fill_t    blend_fill = biltter->u.solid.blend->pixels_fill;
+    tb_size_t                       coverage_alpha = 0;
+
+    // done
+    gb_polygon_raster_span_ref_t    tail = spans + count;
+    for (; spans < tail; spans++)
+    {
+        // check
+        tb_assert(spans->x0 >= 0 && spans->y >= 0 && spans->x1 >= spans->x0);
+
+        // full coverage? fill it
+        if (spans->coverage == 0xff) pixels_fill(pixels + spans->y * row_bytes + spans->x0 * btp, pixel, spans->x1 - spans->x0, (tb_byte_t)alpha);
+        // partial coverage? blend it if not transparent
+        else
+        {
+            coverage_alpha = (alpha * (spans->coverage + 1)) >> 8;
+            if (coverage_alpha >= GB_ALPHA_MINN) blend_fill(pixels + spans->y * row_bytes + spans->x0 * btp, pixel, spans->x1 - spans->x0, (tb_byte_t)coverage_alpha);
+        }
+    }
+}
+static tb_void_t gb_bitmap_biltter_solid_done_m_opaque(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w, tb_long_t h, tb_byte_t const* mask, tb_size_t mask_row_bytes)
+{
+    // check
+    tb_assert(biltter && biltter->pixmap && biltter->pixmap->pixels_fill);
+    tb_assert(biltter->u.solid.blend && biltter->u.solid.blend->pixel_set);
+    tb_assert(x >= 0 && y >= 0 && w >= 0 && h >= 0 && mask);
+
+    // the pixels
+    tb_byte_t* pixels = (tb_byte_t*)gb_bitmap_data(biltter->bitmap);
+    tb_assert(pixels);
+
+    // the factors
+    tb_size_t                       btp = biltter->btp;
+    tb_size_t                       row_bytes = biltter->row_bytes;
+    gb_pixel_t                      pixel = biltter->u.solid.pixel;
+    gb_pixmap_func_pixels_fill_t    pixels_fill = biltter->pixmap->pixels_fill;
+    gb_pixmap_func_pixel_set_t      blend_set = biltter->u.solid.blend->pixel_set;
+
+    // done
+    tb_long_t   i;
+    tb_long_t   e;
+    tb_byte_t*  row;
+    tb_size_t   coverage;
+    for (pixels += y * row_bytes + x * btp; h--; pixels += row_bytes, mask += mask_row_bytes)
+    {
+        for (i = 0, row = pixels; i < w; i = e)
+        {
+            // fill the run of the full coverages
+            coverage = mask[i];
+            if (coverage == 0xff)
+            {
+                for (e = i + 1; e < w && mask[e] == 0xff; e++) ;
+                pixels_fill(row + i * btp, pixel, e - i, 0xff);
+            }
+            // skip the run of the empty coverages
+            else if (!coverage)
+            {
+                for (e = i + 1; e < w && !mask[e]; e++) ;
+            }
+            // blend the partial coverage with the coverage as alpha
+            else
+            {
+                if (coverage >= GB_ALPHA_MINN) blend_set(row + i * btp, pixel, (tb_byte_t)coverage);
+                e = i + 1;
+            }
+        }
+    }
+}
+static tb_void_t gb_bitmap_biltter_solid_done_m_alpha(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w, tb_long_t h, tb_byte_t const* mask, tb_size_t mask_row_bytes)
+{
+    // check
+    tb_assert(biltter && biltter->pixmap && biltter->pixmap->pixels_fill);
+    tb_assert(biltter->u.solid.blend && biltter->u.solid.blend->pixel_set);
+    tb_assert(x >= 0 && y >= 0 && w >= 0 && h >= 0 && mask);
+
+    // the pixels
+    tb_byte_t* pixels = (tb_byte_t*)gb_bitmap_data(biltter->bitmap);
+    tb_assert(pixels);
+
+    // the factors
+    tb_size_t                       btp = biltter->btp;
+    tb_size_t                       row_bytes = biltter->row_bytes;
+    gb_pixel_t                      pixel = biltter->u.solid.pixel;
+    tb_size_t                       alpha = biltter->u.solid.alpha;
+    gb_pixmap_func_pixels_fill_t    pixels_fill = biltter->pixmap->pixels_fill;
+    gb_pixmap_func_pixel_set_t      blend_set = biltter->u.solid.blend->pixel_set;
+
+    // done
+    tb_long_t   i;
+    tb_long_t   e;
+    tb_byte_t*  row;
+    tb_size_t   coverage;
+    tb_size_t   coverage_alpha;
+    for (pixels += y * row_bytes + x * btp; h--; pixels += row_bytes, mask += mask_row_bytes)
+    {
+        for (i = 0, row = pixels; i < w; i = e)
+        {
+            // fill the run of the full coverages with the alpha of the paint
+            coverage = mask[i];
+            if (coverage == 0xff)
+            {
+                for (e = i + 1; e < w && mask[e] == 0xff; e++) ;
+                pixels_fill(row + i * btp, pixel, e - i, (tb_byte_t)alpha);
+            }
+            // blend the partial coverage with the modulated alpha
+            else
+            {
+                coverage_alpha = (alpha * (coverage + 1)) >> 8;
+                if (coverage_alpha && coverage_alpha >= GB_ALPHA_MINN) blend_set(row + i * btp, pixel, (tb_byte_t)coverage_alpha);
+                e = i + 1;
+            }
+        }
+    }
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
@@ -132,25 +291,65 @@ tb_bool_t gb_bitmap_biltter_solid_init(gb_bitmap_biltter_ref_t biltter, gb_bitma
     // init bitmap
     biltter->bitmap = bitmap;
 
-    // init pixmap
-    biltter->pixmap = gb_pixmap(gb_bitmap_pixfmt(bitmap), gb_paint_alpha(paint));
+    // init pixmap, the compositing pixmap blends all alphas
+    biltter->pixmap = biltter->composite? biltter->composite : gb_pixmap(gb_bitmap_pixfmt(bitmap), gb_paint_alpha(paint));
     tb_check_return_val(biltter->pixmap, tb_false);
 
     // init btp and row_bytes
     biltter->btp        = biltter->pixmap->btp;
     biltter->row_bytes  = gb_bitmap_row_bytes(biltter->bitmap);
 
-    // init solid
-    biltter->u.solid.pixel = biltter->pixmap->pixel(gb_paint_color(paint));
+    // init solid, the pixel is opaque and blended with the alpha of the paint
+    gb_color_t color = gb_paint_color(paint);
+    color.a = 0xff;
+    biltter->u.solid.pixel = biltter->pixmap->pixel(color);
     biltter->u.solid.alpha = gb_paint_alpha(paint);
 
+    // opaque?
+    tb_bool_t opaque = (biltter->u.solid.alpha == 0xff || biltter->u.solid.alpha > GB_ALPHA_MAXN);
+
+    // init the blend pixmap for the partial coverages
+    biltter->u.solid.blend = biltter->composite? biltter->composite : gb_pixmap(gb_bitmap_pixfmt(bitmap), GB_ALPHA_MAXN);
+    tb_check_return_val(biltter->u.solid.blend, tb_false);
+
     // init operations
     biltter->done_p     = gb_bitmap_biltter_solid_done_p;
     biltter->done_h     = gb_bitmap_biltter_solid_done_h;
     biltter->done_v     = gb_bitmap_biltter_solid_done_v;
     biltter->done_r     = gb_bitmap_biltter_solid_done_r;
+    biltter->done_s     = gb_bitmap_biltter_solid_done_s;
+    biltter->done_m     = opaque? gb_bitmap_biltter_solid_done_m_opaque : gb_bitmap_biltter_solid_done_m_alpha;
     biltter->exit       = tb_null;
 
+    /* init the specialized operations for the storage at the native endian
+     *
+     * the alpha fill of done_h and done_r still use the pixmap, which may be vectorized,
+     * and the compositing pixmap is always used for the blend mode or the bitmap with alpha
+     */
+    switch (biltter->composite? GB_BITMAP_BILTTER_STORAGE_NONE : gb_bitmap_biltter_storage(gb_bitmap_pixfmt(bitmap)))
+    {
+    case GB_BITMAP_BILTTER_STORAGE_RGB32:
+        if (opaque)
+        {
+            biltter->done_h = gb_bitmap_biltter_rgb32_solid_done_h;
+            biltter->done_r = gb_bitmap_biltter_rgb32_solid_done_r;
+        }
+        biltter->done_s = gb_bitmap_biltter_rgb32_solid_done_s;
+        biltter->done_m = opaque? gb_bitmap_biltter_rgb32_solid_done_m_opaque : gb_bitmap_biltter_rgb32_solid_done_m_alpha;
+        break;
+    case GB_BITMAP_BILTTER_STORAGE_RGB565:
+        if (opaque)
+        {
+            biltter->done_h = gb_bitmap_biltter_rgb565_solid_done_h;
+            biltter->done_r = gb_bitmap_biltter_rgb565_solid_done_r;
+        }
+        biltter->done_s = gb_bitmap_biltter_rgb565_solid_done_s;
+        biltter->done_m = opaque? gb_bitmap_biltter_rgb565_solid_done_m_opaque : gb_bitmap_biltter_rgb565_solid_done_m_alpha;
+        break;
+    default:
+        break;
+    }
+
     // ok
     return tb_true;
 }
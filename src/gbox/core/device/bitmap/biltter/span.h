@@ -0,0 +1,177 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        span.h
+ * @ingroup     core
+ *
+ * the specialized span biltter for one pixel storage at the native endian,
+ * it will be included by the biltters for each storage and need the following definitions:
+ *
+ * - gb_bitmap_biltter_span_pixel_t:            the pixel type of the storage
+ * - GB_BITMAP_BILTTER_SPAN_FILL(p, s, n):      fill n pixels at p with the pixel s
+ * - GB_BITMAP_BILTTER_SPAN_BLEND(d, s, a):     blend the pixel s to the pixel d with the alpha a
+ * - GB_BITMAP_BILTTER_SPAN(name):              the function name for this storage
+ *
+ * all functions are inline, so the biltter picks them directly at init and 
+ * the inner loops need not call the pixmap operations or the tb_bits_* helpers
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_void_t GB_BITMAP_BILTTER_SPAN(pixels_blend)(tb_byte_t* pixels, gb_pixel_t pixel, tb_size_t count, tb_size_t alpha)
+{
+    gb_bitmap_biltter_span_pixel_t* p = (gb_bitmap_biltter_span_pixel_t*)pixels;
+    gb_bitmap_biltter_span_pixel_t* e = p + count;
+    for (; p < e; p++) *p = GB_BITMAP_BILTTER_SPAN_BLEND(*p, pixel, alpha);
+}
+static __tb_inline__ tb_void_t GB_BITMAP_BILTTER_SPAN(pixel_set)(tb_byte_t* pixels, gb_pixel_t pixel, tb_size_t alpha)
+{
+    gb_bitmap_biltter_span_pixel_t* p = (gb_bitmap_biltter_span_pixel_t*)pixels;
+    *p = alpha == 0xff? (gb_bitmap_biltter_span_pixel_t)pixel : GB_BITMAP_BILTTER_SPAN_BLEND(*p, pixel, alpha);
+}
+static __tb_inline__ tb_void_t GB_BITMAP_BILTTER_SPAN(solid_done_h)(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w)
+{
+    // check
+    tb_assert(biltter && x >= 0 && y >= 0 && w >= 0);
+
+    // the pixels
+    tb_byte_t* pixels = (tb_byte_t*)gb_bitmap_data(biltter->bitmap) + y * biltter->row_bytes + x * sizeof(gb_bitmap_biltter_span_pixel_t);
+
+    // done
+    GB_BITMAP_BILTTER_SPAN_FILL(pixels, biltter->u.solid.pixel, w);
+}
+static __tb_inline__ tb_void_t GB_BITMAP_BILTTER_SPAN(solid_done_r)(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w, tb_long_t h)
+{
+    // check
+    tb_assert(biltter && x >= 0 && y >= 0 && w >= 0 && h >= 0);
+
+    // the pixels
+    tb_size_t   row_bytes = biltter->row_bytes;
+    tb_byte_t*  pixels = (tb_byte_t*)gb_bitmap_data(biltter->bitmap) + y * row_bytes + x * sizeof(gb_bitmap_biltter_span_pixel_t);
+    gb_pixel_t  pixel = biltter->u.solid.pixel;
+
+    // done
+    if (!x && w * sizeof(gb_bitmap_biltter_span_pixel_t) == row_bytes) GB_BITMAP_BILTTER_SPAN_FILL(pixels, pixel, w * h);
+    else
+    {
+        for (; h > 0; h--, pixels += row_bytes) GB_BITMAP_BILTTER_SPAN_FILL(pixels, pixel, w);
+    }
+}
+static __tb_inline__ tb_void_t GB_BITMAP_BILTTER_SPAN(solid_done_s)(gb_bitmap_biltter_ref_t biltter, gb_polygon_raster_span_ref_t spans, tb_size_t count)
+{
+    // check
+    tb_assert(biltter && spans);
+
+    // the factors
+    tb_byte_t*  data = (tb_byte_t*)gb_bitmap_data(biltter->bitmap);
+    tb_size_t   row_bytes = biltter->row_bytes;
+    gb_pixel_t  pixel = biltter->u.solid.pixel;
+    tb_size_t   alpha = biltter->u.solid.alpha;
+    tb_bool_t   opaque = (alpha == 0xff || alpha > GB_ALPHA_MAXN);
+    tb_size_t   coverage_alpha;
+    tb_byte_t*  pixels;
+
+    // done
+    gb_polygon_raster_span_ref_t tail = spans + count;
+    for (; spans < tail; spans++)
+    {
+        // check
+        tb_assert(spans->x0 >= 0 && spans->y >= 0 && spans->x1 >= spans->x0);
+
+        // the pixels
+        pixels = data + spans->y * row_bytes + spans->x0 * sizeof(gb_bitmap_biltter_span_pixel_t);
+
+        // full coverage? fill it
+        if (spans->coverage == 0xff)
+        {
+            if (opaque) GB_BITMAP_BILTTER_SPAN_FILL(pixels, pixel, spans->x1 - spans->x0);
+            else GB_BITMAP_BILTTER_SPAN(pixels_blend)(pixels, pixel, spans->x1 - spans->x0, alpha);
+        }
+        // partial coverage? blend it if not transparent
+        else
+        {
+            coverage_alpha = (alpha * (spans->coverage + 1)) >> 8;
+            if (coverage_alpha && coverage_alpha >= GB_ALPHA_MINN) GB_BITMAP_BILTTER_SPAN(pixels_blend)(pixels, pixel, spans->x1 - spans->x0, coverage_alpha);
+        }
+    }
+}
+static __tb_inline__ tb_void_t GB_BITMAP_BILTTER_SPAN(solid_done_m_opaque)(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w, tb_long_t h, tb_byte_t const* mask, tb_size_t mask_row_bytes)
+{
+    // check
+    tb_assert(biltter && x >= 0 && y >= 0 && w >= 0 && h >= 0 && mask);
+
+    // the factors
+    tb_size_t   row_bytes = biltter->row_bytes;
+    tb_byte_t*  pixels = (tb_byte_t*)gb_bitmap_data(biltter->bitmap) + y * row_bytes + x * sizeof(gb_bitmap_biltter_span_pixel_t);
+    gb_pixel_t  pixel = biltter->u.solid.pixel;
+
+    // done
+    tb_long_t   i;
+    tb_long_t   e;
+    tb_size_t   coverage;
+    for (; h > 0; h--, pixels += row_bytes, mask += mask_row_bytes)
+    {
+        for (i = 0; i < w; i = e)
+        {
+            // fill the run of the full coverages
+            coverage = mask[i];
+            if (coverage == 0xff)
+            {
+                for (e = i + 1; e < w && mask[e] == 0xff; e++) ;
+                GB_BITMAP_BILTTER_SPAN_FILL(pixels + i * sizeof(gb_bitmap_biltter_span_pixel_t), pixel, e - i);
+            }
+            // skip the run of the empty coverages
+            else if (!coverage)
+            {
+                for (e = i + 1; e < w && !mask[e]; e++) ;
+            }
+            // blend the partial coverage with the coverage as alpha
+            else
+            {
+                if (coverage >= GB_ALPHA_MINN) GB_BITMAP_BILTTER_SPAN(pixel_set)(pixels + i * sizeof(gb_bitmap_biltter_span_pixel_t), pixel, coverage);
+                e = i + 1;
+            }
+        }
+    }
+}
+static __tb_inline__ tb_void_t GB_BITMAP_BILTTER_SPAN(solid_done_m_alpha)(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w, tb_long_t h, tb_byte_t const* mask, tb_size_t mask_row_bytes)
+{
+    // check
+    tb_assert(biltter && x >= 0 && y >= 0 && w >= 0 && h >= 0 && mask);
+
+    // the factors
+    tb_size_t   row_bytes = biltter->row_bytes;
+    tb_byte_t*  pixels = (tb_byte_t*)gb_bitmap_data(biltter->bitmap) + y * row_bytes + x * sizeof(gb_bitmap_biltter_span_pixel_t);
+    gb_pixel_t  pixel = biltter->u.solid.pixel;
+    tb_size_t   alpha = biltter->u.solid.alpha;
+
+    // done
+    tb_long_t   i;
+    tb_size_t   coverage_alpha;
+    for (; h > 0; h--, pixels += row_bytes, mask += mask_row_bytes)
+    {
+        for (i = 0; i < w; i++)
+        {
+            // blend it with the alpha modulated by the coverage
+            coverage_alpha = (alpha * (mask[i] + 1)) >> 8;
+            if (coverage_alpha && coverage_alpha >= GB_ALPHA_MINN) GB_BITMAP_BILTTER_SPAN(pixel_set)(pixels + i * sizeof(gb_bitmap_biltter_span_pixel_t), pixel, coverage_alpha);
+        }
+    }
+}
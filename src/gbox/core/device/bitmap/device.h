@@ -31,10 +31,60 @@
 #include "../../impl/stroker.h"
 #include "../../impl/polygon_raster.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the bands maxn for the parallel rasterization
+#define GB_BITMAP_DEVICE_BANDS_MAXN         (16)
+
+// the minimum height of the band for the parallel rasterization
+#ifdef __gb_small__
+#   define GB_BITMAP_DEVICE_BAND_HEIGHT_MINN    (64)
+#else
+#   define GB_BITMAP_DEVICE_BAND_HEIGHT_MINN    (32)
+#endif
+
+// the spans maxn of the raster batch
+#ifdef __gb_small__
+#   define GB_BITMAP_DEVICE_SPANS_MAXN      (64)
+#else
+#   define GB_BITMAP_DEVICE_SPANS_MAXN      (256)
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
 
+// the bitmap device band type for the parallel rasterization
+typedef struct __gb_bitmap_device_band_t
+{
+    // the device
+    struct __gb_bitmap_device_t*    device;
+
+    // the raster of this band
+    gb_polygon_raster_ref_t         raster;
+
+    // the task of this band
+    tb_thread_pool_task_ref_t       task;
+
+    // the polygon
+    gb_polygon_ref_t                polygon;
+
+    // the bounds
+    gb_rect_ref_t                   bounds;
+
+    // the top y-coordinate of this band
+    tb_long_t                       top;
+
+    // the bottom y-coordinate of this band
+    tb_long_t                       bottom;
+
+    // the spans batch of this band
+    gb_polygon_raster_span_t        spans[GB_BITMAP_DEVICE_SPANS_MAXN];
+
+}gb_bitmap_device_band_t, *gb_bitmap_device_band_ref_t;
+
 // the bitmap device type
 typedef struct __gb_bitmap_device_t
 {
@@ -65,9 +115,18 @@ typedef struct __gb_bitmap_device_t
     // the biltter
     gb_bitmap_biltter_t             biltter;
 
+    // the spans batch of the raster
+    gb_polygon_raster_span_t        spans[GB_BITMAP_DEVICE_SPANS_MAXN];
+
     // the stroker
     gb_stroker_ref_t                stroker;
 
+    // the thread pool for the parallel rasterization, serial if be null
+    tb_thread_pool_ref_t            pool;
+
+    // the bands for the parallel rasterization
+    gb_bitmap_device_band_t         bands[GB_BITMAP_DEVICE_BANDS_MAXN];
+
 }gb_bitmap_device_t, *gb_bitmap_device_ref_t;
 
 #endif
@@ -100,9 +100,9 @@ static tb_size_t gb_bitmap_render_apply_matrix_for_polygon(gb_bitmap_device_ref_
 
     // done
     gb_point_ref_t  points = polygon->points;
-    tb_uint16_t*    counts = polygon->counts;
-    tb_uint16_t     count = *counts++;
-    tb_uint16_t     index = 0;
+    tb_uint32_t*    counts = polygon->counts;
+    tb_uint32_t     count = *counts++;
+    tb_uint32_t     index = 0;
     while (index < count)
     {
         // apply to point
@@ -206,11 +206,24 @@ tb_bool_t gb_bitmap_render_init(gb_bitmap_device_ref_t device)
     tb_bool_t ok = tb_false;
     do
     {
+        // the mipmaps of the device bitmap will be changed after drawing
+        gb_bitmap_mipmap_clear(device->bitmap);
+
         // init shader
         device->shader = gb_paint_shader(device->base.paint);
 
         // init biltter
-        if (!gb_bitmap_biltter_init(&device->biltter, device->bitmap, device->base.paint)) break;
+        if (!gb_bitmap_biltter_init(&device->biltter, device->bitmap, device->base.matrix, device->base.paint)) break;
+
+        // these blend modes may make the opaque pixels translucent, the device bitmap has alpha after drawing
+        tb_size_t blend = gb_paint_blend(device->base.paint);
+        if (    GB_PIXFMT_HAS_ALPHA(gb_bitmap_pixfmt(device->bitmap))
+            &&  (   blend == GB_PAINT_BLEND_SRC
+                ||  blend == GB_PAINT_BLEND_DST_IN
+                ||  blend == GB_PAINT_BLEND_DST_OUT))
+        {
+            gb_bitmap_set_alpha(device->bitmap, tb_true);
+        }
 
         // ok
         ok = tb_true;
@@ -242,7 +255,7 @@ tb_void_t gb_bitmap_render_draw_path(gb_bitmap_device_ref_t device, gb_path_ref_
     // fill it
     if (mode & GB_PAINT_MODE_FILL)
     {
-        gb_bitmap_render_draw_polygon(device, gb_path_polygon(path), gb_path_hint(path), gb_path_bounds(path));
+        gb_bitmap_render_draw_polygon(device, gb_path_polygon_for_matrix(path, device->base.matrix), gb_path_hint(path), gb_path_bounds(path));
     }
 
     // stroke it
@@ -251,7 +264,7 @@ tb_void_t gb_bitmap_render_draw_path(gb_bitmap_device_ref_t device, gb_path_ref_
         // only stroke?
         if (gb_bitmap_render_stroke_only(device))
         {
-            gb_bitmap_render_draw_polygon(device, gb_path_polygon(path), gb_path_hint(path), gb_path_bounds(path));
+            gb_bitmap_render_draw_polygon(device, gb_path_polygon_for_matrix(path, device->base.matrix), gb_path_hint(path), gb_path_bounds(path));
         }
         // fill the stroked path
         else gb_bitmap_render_stroke_fill(device, gb_stroker_done_path(device->stroker, device->base.paint, path));
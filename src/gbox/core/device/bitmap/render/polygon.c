@@ -37,13 +37,136 @@
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
-static tb_void_t gb_bitmap_render_fill_raster(tb_long_t lx, tb_long_t rx, tb_long_t yb, tb_long_t ye, tb_cpointer_t priv)
+static tb_void_t gb_bitmap_render_fill_raster(gb_polygon_raster_span_ref_t spans, tb_size_t count, tb_cpointer_t priv)
 {
     // check
-    tb_assert(priv && rx >= lx && ye > yb);
+    tb_assert(priv && spans);
 
     // done biltter
-    gb_bitmap_biltter_done_r((gb_bitmap_biltter_ref_t)priv, lx, yb, rx - lx, ye - yb);
+    gb_bitmap_biltter_done_s((gb_bitmap_biltter_ref_t)priv, spans, count);
+}
+static tb_void_t gb_bitmap_render_fill_raster_coverage(tb_long_t x, tb_long_t y, tb_byte_t const* coverages, tb_size_t count, tb_cpointer_t priv)
+{
+    // check
+    gb_bitmap_biltter_ref_t biltter = (gb_bitmap_biltter_ref_t)priv;
+    tb_assert(biltter && biltter->bitmap && coverages);
+
+    /* clip the coverages of this line by the bitmap
+     *
+     * the edges which only graze the border of the bitmap, e.g. the sub-pixel overhang of the rotated rect,
+     * still make the coverages outside the bitmap
+     */
+    tb_long_t w = (tb_long_t)count;
+    tb_check_return(y >= 0 && y < (tb_long_t)gb_bitmap_height(biltter->bitmap));
+    if (x < 0)
+    {
+        coverages -= x;
+        w += x;
+        x = 0;
+    }
+    if (x + w > (tb_long_t)gb_bitmap_width(biltter->bitmap)) w = (tb_long_t)gb_bitmap_width(biltter->bitmap) - x;
+    tb_check_return(w > 0);
+
+    // done biltter with the coverages of this line as the mask
+    gb_bitmap_biltter_done_m(biltter, x, y, w, 1, coverages, 0);
+}
+static tb_void_t gb_bitmap_render_fill_raster_done(gb_bitmap_device_ref_t device, gb_polygon_raster_ref_t raster, gb_polygon_raster_span_ref_t spans, gb_polygon_ref_t polygon, gb_rect_ref_t bounds)
+{
+    // check
+    tb_assert(device && device->base.paint && raster && spans);
+
+    // anti-aliasing? done raster with the coverage mask of each line
+    if (gb_paint_flag(device->base.paint) & GB_PAINT_FLAG_ANTIALIASING)
+        gb_polygon_raster_done_coverage(raster, polygon, bounds, gb_paint_fill_rule(device->base.paint), gb_bitmap_render_fill_raster_coverage, &device->biltter);
+    // done raster with the span batches
+    else gb_polygon_raster_done_spans(raster, polygon, bounds, gb_paint_fill_rule(device->base.paint), tb_false, spans, GB_BITMAP_DEVICE_SPANS_MAXN, gb_bitmap_render_fill_raster, &device->biltter);
+}
+static tb_void_t gb_bitmap_render_fill_band(gb_bitmap_device_band_ref_t band)
+{
+    // check
+    tb_assert(band && band->device && band->raster);
+
+    // only rasterize the lines of this band
+    gb_polygon_raster_band_set(band->raster, band->top, band->bottom);
+
+    // done raster
+    gb_bitmap_render_fill_raster_done(band->device, band->raster, band->spans, band->polygon, band->bounds);
+}
+static tb_void_t gb_bitmap_render_fill_band_task(tb_thread_pool_worker_ref_t worker, tb_cpointer_t priv)
+{
+    // fill this band
+    gb_bitmap_render_fill_band((gb_bitmap_device_band_ref_t)priv);
+}
+static tb_bool_t gb_bitmap_render_fill_polygon_parallel(gb_bitmap_device_ref_t device, gb_polygon_ref_t polygon, gb_rect_ref_t bounds)
+{
+    // check
+    tb_assert(device && polygon && bounds);
+
+    // no thread pool? 
+    tb_check_return_val(device->pool, tb_false);
+
+    // the lines of the polygon
+    tb_long_t top       = gb_floor(bounds->y);
+    tb_long_t bottom    = gb_ceil(bounds->y + bounds->h) + 1;
+
+    // compute the bands count
+    tb_size_t count = (tb_size_t)(bottom - top) / GB_BITMAP_DEVICE_BAND_HEIGHT_MINN;
+    count = tb_min(count, tb_processor_count());
+    count = tb_min(count, GB_BITMAP_DEVICE_BANDS_MAXN);
+
+    // too small? done it in the serial mode
+    tb_check_return_val(count > 1, tb_false);
+
+    // init the bands
+    tb_size_t                   i = 0;
+    gb_bitmap_device_band_ref_t band = tb_null;
+    for (i = 0; i < count; i++)
+    {
+        // the band
+        band = &device->bands[i];
+
+        // init the raster of this band
+        if (!band->raster) band->raster = gb_polygon_raster_init();
+        tb_assert_and_check_return_val(band->raster, tb_false);
+
+        // init this band
+        band->device    = device;
+        band->polygon   = polygon;
+        band->bounds    = bounds;
+        band->task      = tb_null;
+        band->top       = top + (bottom - top) * (tb_long_t)i / (tb_long_t)count;
+        band->bottom    = top + (bottom - top) * (tb_long_t)(i + 1) / (tb_long_t)count;
+    }
+
+    // post the other bands to the thread pool
+    for (i = 1; i < count; i++)
+    {
+        band = &device->bands[i];
+        band->task = tb_thread_pool_task_init(device->pool, "fill_band", gb_bitmap_render_fill_band_task, tb_null, band, tb_false);
+    }
+
+    // fill the first band in the current thread
+    gb_bitmap_render_fill_band(&device->bands[0]);
+
+    // wait the other bands
+    for (i = 1; i < count; i++)
+    {
+        band = &device->bands[i];
+        if (band->task)
+        {
+            // wait it
+            tb_thread_pool_task_wait(device->pool, band->task, -1);
+
+            // exit it
+            tb_thread_pool_task_exit(device->pool, band->task);
+            band->task = tb_null;
+        }
+        // post failed? fill it in the current thread
+        else gb_bitmap_render_fill_band(band);
+    }
+
+    // ok
+    return tb_true;
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -54,8 +177,11 @@ tb_void_t gb_bitmap_render_fill_polygon(gb_bitmap_device_ref_t device, gb_polygo
     // check
     tb_assert(device && device->base.paint);
 
+    // done raster for the bands concurrently if the polygon is large enough
+    if (gb_bitmap_render_fill_polygon_parallel(device, polygon, bounds)) return ;
+
     // done raster
-    gb_polygon_raster_done(device->raster, polygon, bounds, gb_paint_fill_rule(device->base.paint), gb_bitmap_render_fill_raster, &device->biltter);
+    gb_bitmap_render_fill_raster_done(device, device->raster, device->spans, polygon, bounds);
 }
 tb_void_t gb_bitmap_render_stroke_polygon(gb_bitmap_device_ref_t device, gb_polygon_ref_t polygon)
 {
@@ -63,11 +189,11 @@ tb_void_t gb_bitmap_render_stroke_polygon(gb_bitmap_device_ref_t device, gb_poly
     tb_assert(device && polygon && polygon->points && polygon->counts);
 
     // done
-    tb_uint16_t     index = 0;
+    tb_uint32_t     index = 0;
     gb_point_t      points_line[2];
     gb_point_ref_t  points = polygon->points;
-    tb_uint16_t*    counts = polygon->counts;
-    tb_uint16_t     count = *counts++;
+    tb_uint32_t*    counts = polygon->counts;
+    tb_uint32_t     count = *counts++;
     while (index < count)
     {
         // the point
@@ -0,0 +1,240 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        shader.c
+ * @ingroup     core
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "bitmap_shader"
+#define TB_TRACE_MODULE_DEBUG           (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "shader.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_void_t gb_bitmap_shader_exit(gb_shader_impl_t* shader)
+{
+    // check
+    gb_bitmap_shader_ref_t impl = (gb_bitmap_shader_ref_t)shader;
+    tb_assert_and_check_return(impl);
+
+    // exit the color lookup table of the gradient
+    if (impl->base.type == GB_SHADER_TYPE_LINEAR || impl->base.type == GB_SHADER_TYPE_RADIAL)
+    {
+        if (impl->u.gradient.lut) tb_free(impl->u.gradient.lut);
+        impl->u.gradient.lut = tb_null;
+    }
+
+    // exit it
+    tb_free(impl);
+}
+static tb_fixed_t gb_bitmap_shader_gradient_stop(gb_gradient_ref_t gradient, tb_size_t index)
+{
+    // the uniform stops if no radios
+    if (!gradient->radios) return gradient->count > 1? (tb_fixed_t)((index << 16) / (gradient->count - 1)) : 0;
+
+    // the stop
+    tb_fixed_t stop = gb_float_to_fixed(gradient->radios[index]);
+    return stop < 0? 0 : tb_min(stop, TB_FIXED_ONE);
+}
+static tb_bool_t gb_bitmap_shader_gradient_lut_init(gb_bitmap_shader_ref_t shader, gb_pixmap_ref_t pixmap, gb_gradient_ref_t gradient)
+{
+    // check
+    tb_assert_and_check_return_val(shader && pixmap && gradient && gradient->colors && gradient->count, tb_false);
+
+    // make the lut
+    gb_bitmap_shader_lut_entry_ref_t lut = tb_nalloc0_type(GB_BITMAP_SHADER_LUT_SIZE, gb_bitmap_shader_lut_entry_t);
+    tb_assert_and_check_return_val(lut, tb_false);
+
+    // bake the stops
+    tb_size_t   i;
+    tb_size_t   stop = 0;
+    tb_size_t   count = gradient->count;
+    tb_fixed_t  p0 = gb_bitmap_shader_gradient_stop(gradient, 0);
+    tb_fixed_t  p1 = count > 1? gb_bitmap_shader_gradient_stop(gradient, 1) : p0;
+    tb_bool_t   opaque = tb_true;
+    for (i = 0; i < GB_BITMAP_SHADER_LUT_SIZE; i++)
+    {
+        // the position of this entry: [0, 1]
+        tb_fixed_t t = (tb_fixed_t)((i << 16) / (GB_BITMAP_SHADER_LUT_SIZE - 1));
+
+        // seek to the segment: [p0, p1] which contains t
+        while (stop + 2 < count && t > p1)
+        {
+            stop++;
+            p0 = p1;
+            p1 = gb_bitmap_shader_gradient_stop(gradient, stop + 1);
+            if (p1 < p0) p1 = p0;
+        }
+
+        // the colors of this segment
+        gb_color_t c0 = gradient->colors[stop];
+        gb_color_t c1 = gradient->colors[count > 1? stop + 1 : stop];
+
+        // the factor of this segment: [0, 256]
+        tb_size_t f = 0;
+        if (t >= p1) f = 256;
+        else if (t > p0) f = (tb_size_t)((((tb_hong_t)(t - p0)) << 8) / (p1 - p0));
+
+        /* interpolate the premultiplied color 
+         *
+         * the premultiplied interpolation will not bleed the color of the transparent stop
+         */
+        tb_size_t a0 = c0.a + (c0.a >> 7);
+        tb_size_t a1 = c1.a + (c1.a >> 7);
+        tb_size_t a = (c0.a * (256 - f) + c1.a * f) >> 8;
+        tb_size_t r = (((c0.r * a0) >> 8) * (256 - f) + ((c1.r * a1) >> 8) * f) >> 8;
+        tb_size_t g = (((c0.g * a0) >> 8) * (256 - f) + ((c1.g * a1) >> 8) * f) >> 8;
+        tb_size_t b = (((c0.b * a0) >> 8) * (256 - f) + ((c1.b * a1) >> 8) * f) >> 8;
+
+        // unpremultiply it for the device pixel, the pixel is opaque and blended with the alpha of the entry
+        gb_color_t color;
+        color.a = 0xff;
+        color.r = (tb_byte_t)(a? tb_min((r * 255 + (a >> 1)) / a, 255) : 0);
+        color.g = (tb_byte_t)(a? tb_min((g * 255 + (a >> 1)) / a, 255) : 0);
+        color.b = (tb_byte_t)(a? tb_min((b * 255 + (a >> 1)) / a, 255) : 0);
+
+        // save it
+        lut[i].pixel = pixmap->pixel(color);
+        lut[i].alpha = (tb_byte_t)a;
+        if (a != 0xff) opaque = tb_false;
+    }
+
+    // save the lut
+    shader->u.gradient.lut      = lut;
+    shader->u.gradient.pixfmt   = pixmap->pixfmt;
+    shader->u.gradient.opaque   = opaque;
+
+    // ok
+    return tb_true;
+}
+
+static gb_bitmap_shader_ref_t gb_bitmap_shader_init_gradient(gb_bitmap_device_ref_t device, tb_size_t type, tb_size_t mode, gb_gradient_ref_t gradient)
+{
+    // check
+    tb_assert_and_check_return_val(device && device->bitmap && gradient, tb_null);
+
+    // done
+    tb_bool_t               ok = tb_false;
+    gb_bitmap_shader_ref_t  shader = tb_null;
+    do
+    {
+        // the opaque pixmap of the device
+        gb_pixmap_ref_t pixmap = gb_pixmap(gb_bitmap_pixfmt(device->bitmap), 0xff);
+        tb_assert_and_check_break(pixmap);
+
+        // make shader
+        shader = tb_malloc0_type(gb_bitmap_shader_t);
+        tb_assert_and_check_break(shader);
+
+        // init base
+        shader->base.type   = (tb_uint8_t)type;
+        shader->base.mode   = (tb_uint8_t)mode;
+        shader->base.refn   = 1;
+        shader->base.exit   = gb_bitmap_shader_exit;
+        gb_matrix_clear(&shader->base.matrix);
+
+        // init lut
+        if (!gb_bitmap_shader_gradient_lut_init(shader, pixmap, gradient)) break;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (shader) gb_bitmap_shader_exit((gb_shader_impl_t*)shader);
+        shader = tb_null;
+    }
+
+    // ok?
+    return shader;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+gb_shader_ref_t gb_bitmap_shader_init_linear(gb_bitmap_device_ref_t device, tb_size_t mode, gb_gradient_ref_t gradient, gb_line_ref_t line)
+{
+    // check
+    tb_assert_and_check_return_val(line, tb_null);
+
+    // init gradient shader
+    gb_bitmap_shader_ref_t shader = gb_bitmap_shader_init_gradient(device, GB_SHADER_TYPE_LINEAR, mode, gradient);
+    tb_check_return_val(shader, tb_null);
+
+    // init line
+    shader->u.gradient.u.line = *line;
+
+    // ok
+    return (gb_shader_ref_t)shader;
+}
+gb_shader_ref_t gb_bitmap_shader_init_radial(gb_bitmap_device_ref_t device, tb_size_t mode, gb_gradient_ref_t gradient, gb_circle_ref_t circle)
+{
+    // check
+    tb_assert_and_check_return_val(circle, tb_null);
+
+    // init gradient shader
+    gb_bitmap_shader_ref_t shader = gb_bitmap_shader_init_gradient(device, GB_SHADER_TYPE_RADIAL, mode, gradient);
+    tb_check_return_val(shader, tb_null);
+
+    // init circle
+    shader->u.gradient.u.circle = *circle;
+
+    // ok
+    return (gb_shader_ref_t)shader;
+}
+gb_shader_ref_t gb_bitmap_shader_init_bitmap(gb_bitmap_device_ref_t device, tb_size_t mode, gb_bitmap_ref_t bitmap)
+{
+    // check
+    tb_assert_and_check_return_val(device && bitmap, tb_null);
+
+    // the bitmap width and height
+    tb_size_t width     = gb_bitmap_width(bitmap);
+    tb_size_t height    = gb_bitmap_height(bitmap);
+    tb_assert_and_check_return_val(width && height && width <= GB_WIDTH_MAXN && height <= GB_HEIGHT_MAXN, tb_null);
+
+    // make shader
+    gb_bitmap_shader_ref_t shader = tb_malloc0_type(gb_bitmap_shader_t);
+    tb_assert_and_check_return_val(shader, tb_null);
+
+    // init base
+    shader->base.type   = GB_SHADER_TYPE_BITMAP;
+    shader->base.mode   = (tb_uint8_t)mode;
+    shader->base.refn   = 1;
+    shader->base.exit   = gb_bitmap_shader_exit;
+    gb_matrix_clear(&shader->base.matrix);
+
+    // init bitmap
+    shader->u.bitmap    = bitmap;
+
+    // ok
+    return (gb_shader_ref_t)shader;
+}
@@ -0,0 +1,149 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        shader.h
+ * @ingroup     core
+ *
+ */
+#ifndef GB_CORE_DEVICE_BITMAP_SHADER_H
+#define GB_CORE_DEVICE_BITMAP_SHADER_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "device.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the bits of the gradient color lookup table size
+#ifdef __gb_small__
+#   define GB_BITMAP_SHADER_LUT_BITS        (8)
+#else
+#   define GB_BITMAP_SHADER_LUT_BITS        (10)
+#endif
+
+// the size of the gradient color lookup table
+#define GB_BITMAP_SHADER_LUT_SIZE           (1 << GB_BITMAP_SHADER_LUT_BITS)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the bitmap shader lut entry type
+typedef struct __gb_bitmap_shader_lut_entry_t
+{
+    // the pixel of the device pixfmt
+    gb_pixel_t                      pixel;
+
+    // the alpha
+    tb_byte_t                       alpha;
+
+}gb_bitmap_shader_lut_entry_t, *gb_bitmap_shader_lut_entry_ref_t;
+
+// the bitmap shader type
+typedef struct __gb_bitmap_shader_t
+{
+    // the base
+    gb_shader_impl_t                base;
+
+    union
+    {
+        // the bitmap of the bitmap shader
+        gb_bitmap_ref_t             bitmap;
+
+        // the gradient of the linear and radial shader
+        struct
+        {
+            /* the color lookup table of the device pixfmt
+             *
+             * the stops are interpolated in the premultiplied space once and are baked into 
+             * GB_BITMAP_SHADER_LUT_SIZE entries, so the biltter only need index it for each pixel
+             */
+            gb_bitmap_shader_lut_entry_ref_t lut;
+
+            // the pixfmt of the lut pixels
+            tb_size_t               pixfmt;
+
+            // all entries are opaque?
+            tb_bool_t               opaque;
+
+            union
+            {
+                // the line of the linear gradient
+                gb_line_t           line;
+
+                // the circle of the radial gradient
+                gb_circle_t         circle;
+
+            }u;
+
+        }gradient;
+
+    }u;
+
+}gb_bitmap_shader_t, *gb_bitmap_shader_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interface
+ */
+
+/* init linear gradient shader
+ *
+ * @param device    the device
+ * @param mode      the mode 
+ * @param gradient  the gradient, the stops will be baked into the color lookup table
+ * @param line      the line
+ *
+ * @return          the shader
+ */
+gb_shader_ref_t     gb_bitmap_shader_init_linear(gb_bitmap_device_ref_t device, tb_size_t mode, gb_gradient_ref_t gradient, gb_line_ref_t line);
+
+/* init radial gradient shader
+ *
+ * @param device    the device
+ * @param mode      the mode 
+ * @param gradient  the gradient, the stops will be baked into the color lookup table
+ * @param circle    the circle
+ *
+ * @return          the shader
+ */
+gb_shader_ref_t     gb_bitmap_shader_init_radial(gb_bitmap_device_ref_t device, tb_size_t mode, gb_gradient_ref_t gradient, gb_circle_ref_t circle);
+
+/* init bitmap shader
+ *
+ * @param device    the device
+ * @param mode      the mode 
+ * @param bitmap    the bitmap, it will be referenced only and should be kept until the shader is exited
+ *
+ * @return          the shader
+ */
+gb_shader_ref_t     gb_bitmap_shader_init_bitmap(gb_bitmap_device_ref_t device, tb_size_t mode, gb_bitmap_ref_t bitmap);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+#endif
@@ -250,7 +250,7 @@ static tb_void_t gb_gl_render_stroke_points(gb_gl_device_ref_t device, gb_point_
     // done
     gb_glDrawArrays(GB_GL_POINTS, 0, (gb_GLint_t)count);
 }
-static tb_void_t gb_gl_render_stroke_polygon(gb_gl_device_ref_t device, gb_point_ref_t points, tb_uint16_t const* counts)
+static tb_void_t gb_gl_render_stroke_polygon(gb_gl_device_ref_t device, gb_point_ref_t points, tb_uint32_t const* counts)
 {
     // check
     tb_assert(device && points && counts);
@@ -259,7 +259,7 @@ static tb_void_t gb_gl_render_stroke_polygon(gb_gl_device_ref_t device, gb_point
     gb_gl_render_apply_vertices(device, points);
 
     // done
-    tb_uint16_t count;
+    tb_uint32_t count;
     tb_size_t   index = 0;
     while ((count = *counts++))
     {
@@ -431,14 +431,14 @@ tb_void_t gb_gl_render_draw_path(gb_gl_device_ref_t device, gb_path_ref_t path)
     // fill it
     if (mode & GB_PAINT_MODE_FILL)
     {
-        gb_gl_render_draw_polygon(device, gb_path_polygon(path), gb_path_hint(path), gb_path_bounds(path));
+        gb_gl_render_draw_polygon(device, gb_path_polygon_for_matrix(path, device->base.matrix), gb_path_hint(path), gb_path_bounds(path));
     }
 
     // stroke it
     if ((mode & GB_PAINT_MODE_STROKE) && (gb_paint_stroke_width(device->base.paint) > 0))
     {
         // only stroke?
-        if (gb_gl_render_stroke_only(device)) gb_gl_render_draw_polygon(device, gb_path_polygon(path), gb_path_hint(path), gb_path_bounds(path));
+        if (gb_gl_render_stroke_only(device)) gb_gl_render_draw_polygon(device, gb_path_polygon_for_matrix(path, device->base.matrix), gb_path_hint(path), gb_path_bounds(path));
         // fill the stroked path
         else gb_gl_render_stroke_fill(device, gb_stroker_done_path(device->stroker, device->base.paint, path));
     }
@@ -113,6 +113,17 @@ typedef struct __gb_device_impl_t
      */
     tb_void_t               (*draw_polygon)(struct __gb_device_impl_t* device, gb_polygon_ref_t polygon, gb_shape_ref_t hint, gb_rect_ref_t bounds);
 
+    /*! draw bitmap directly, optional
+     *
+     * @param device        the device
+     * @param bitmap        the bitmap
+     * @param src_rect      the source rect in the bitmap
+     * @param dst_rect      the destination rect
+     *
+     * @return              tb_true or tb_false if it need be drawn with the bitmap shader
+     */
+    tb_bool_t               (*draw_bitmap)(struct __gb_device_impl_t* device, gb_bitmap_ref_t bitmap, gb_rect_ref_t src_rect, gb_rect_ref_t dst_rect);
+
     /*! init linear gradient shader
      *
      * @param device        the device
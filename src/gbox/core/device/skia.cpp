@@ -405,7 +405,7 @@ static tb_void_t gb_device_skia_draw_polygon(gb_device_impl_t* device, gb_polygo
 
     // the points
     gb_point_ref_t      points = polygon->points;
-    tb_uint16_t const*  counts = polygon->counts;
+    tb_uint32_t const*  counts = polygon->counts;
     tb_assert_and_check_return(points && counts);
 
     // apply matrix
@@ -423,7 +423,7 @@ static tb_void_t gb_device_skia_draw_polygon(gb_device_impl_t* device, gb_polygo
     // init path
     gb_point_ref_t  first = tb_null;
     gb_point_ref_t  point = tb_null;
-    tb_uint16_t     count = *counts++;
+    tb_uint32_t     count = *counts++;
     tb_size_t       index = 0;
     while (index < count)
     {
@@ -0,0 +1,234 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        bitmap_pool.c
+ * @ingroup     core
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "bitmap_pool"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "bitmap_pool.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the maximum bytes of the cached data
+#ifdef __gb_small__
+#   define GB_BITMAP_POOL_CACHE_BITS        (23)
+#else
+#   define GB_BITMAP_POOL_CACHE_BITS        (26)
+#endif
+#define GB_BITMAP_POOL_CACHE_MAXN           (1 << GB_BITMAP_POOL_CACHE_BITS)
+
+// the minimum size class: 256 bytes
+#define GB_BITMAP_POOL_CLASS_BITS           (8)
+#define GB_BITMAP_POOL_CLASS_MINN           (1 << GB_BITMAP_POOL_CLASS_BITS)
+
+/* the size classes count
+ *
+ * the class 0 is [1, 256] and each power of two is split into four classes, 
+ * e.g. (256, 320], (320, 384], (384, 448], (448, 512], ... 
+ */
+#define GB_BITMAP_POOL_CLASS_MAXN           (((GB_BITMAP_POOL_CACHE_BITS - GB_BITMAP_POOL_CLASS_BITS) << 2) + 1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the cached data block, it is stored at the head of the freed data
+typedef struct __gb_bitmap_pool_block_t
+{
+    // the next block of this class
+    struct __gb_bitmap_pool_block_t*    next;
+
+    // the row bytes of the last user
+    tb_size_t                           row_bytes;
+
+}gb_bitmap_pool_block_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the lock
+static tb_spinlock_t            g_lock = TB_SPINLOCK_INIT;
+
+// the cached blocks of the size classes
+static gb_bitmap_pool_block_t*  g_blocks[GB_BITMAP_POOL_CLASS_MAXN];
+
+// the cached bytes
+static tb_size_t                g_cached = 0;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_size_t gb_bitmap_pool_class_capacity(tb_size_t index)
+{
+    // the minimum class?
+    tb_check_return_val(index, GB_BITMAP_POOL_CLASS_MINN);
+
+    // the power of two and the step of this class
+    tb_size_t b = GB_BITMAP_POOL_CLASS_BITS + ((index - 1) >> 2);
+    tb_size_t n = ((index - 1) & 3) + 1;
+
+    // 2^b + n * 2^b / 4
+    return ((tb_size_t)1 << b) + n * ((tb_size_t)1 << (b - 2));
+}
+static tb_long_t gb_bitmap_pool_class(tb_size_t size, tb_size_t* capacity)
+{
+    // too large? it will not be cached
+    if (size > GB_BITMAP_POOL_CACHE_MAXN)
+    {
+        *capacity = tb_align(size, GB_BITMAP_POOL_ALIGN);
+        return -1;
+    }
+
+    // the class index
+    tb_size_t index = 0;
+    if (size > GB_BITMAP_POOL_CLASS_MINN)
+    {
+        // the power of two: 2^b < size <= 2^(b + 1)
+        tb_size_t b = 31 - tb_bits_cl0_u32_be((tb_uint32_t)(size - 1));
+
+        // the step of this power: 2^b / 4
+        tb_size_t step = (tb_size_t)1 << (b - 2);
+        tb_size_t n = (size - ((tb_size_t)1 << b) + step - 1) / step;
+        tb_assert(n >= 1 && n <= 4);
+
+        // the index
+        index = ((b - GB_BITMAP_POOL_CLASS_BITS) << 2) + n;
+    }
+
+    // the class capacity
+    *capacity = gb_bitmap_pool_class_capacity(index);
+    return index;
+}
+static tb_void_t gb_bitmap_pool_evict(tb_size_t size)
+{
+    // free the blocks of the larger classes first until the cache has the enough space
+    tb_long_t i = GB_BITMAP_POOL_CLASS_MAXN - 1;
+    for (; i >= 0 && g_cached + size > GB_BITMAP_POOL_CACHE_MAXN; i--)
+    {
+        // the class capacity
+        tb_size_t capacity = gb_bitmap_pool_class_capacity(i);
+
+        // free the blocks of this class
+        while (g_blocks[i] && g_cached + size > GB_BITMAP_POOL_CACHE_MAXN)
+        {
+            gb_bitmap_pool_block_t* block = g_blocks[i];
+            g_blocks[i] = block->next;
+            g_cached -= capacity;
+            tb_align_free(block);
+        }
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_pointer_t gb_bitmap_pool_malloc(tb_size_t size, tb_size_t row_bytes, tb_size_t* capacity)
+{
+    // check
+    tb_assert_and_check_return_val(size && capacity, tb_null);
+
+    // the size class
+    tb_long_t index = gb_bitmap_pool_class(size, capacity);
+
+    // reuse the cached block of this class
+    gb_bitmap_pool_block_t* block = tb_null;
+    if (index >= 0)
+    {
+        // enter
+        tb_spinlock_enter(&g_lock);
+
+        // find the block with the same row bytes, otherwise use the first block
+        gb_bitmap_pool_block_t** prev = &g_blocks[index];
+        gb_bitmap_pool_block_t** item = prev;
+        for (; *item && (*item)->row_bytes != row_bytes; item = &(*item)->next) ;
+        if (*item) prev = item;
+
+        // remove it
+        block = *prev;
+        if (block)
+        {
+            *prev = block->next;
+            g_cached -= *capacity;
+        }
+
+        // leave
+        tb_spinlock_leave(&g_lock);
+    }
+
+    // trace
+    tb_trace_d("malloc: %lu => %lu, class: %ld, reused: %d", size, *capacity, index, block? 1 : 0);
+
+    // make a new block if no cached block
+    return block? (tb_pointer_t)block : tb_align_malloc(*capacity, GB_BITMAP_POOL_ALIGN);
+}
+tb_void_t gb_bitmap_pool_free(tb_pointer_t data, tb_size_t capacity, tb_size_t row_bytes)
+{
+    // check
+    tb_check_return(data);
+
+    // the size class
+    tb_size_t   size = 0;
+    tb_long_t   index = gb_bitmap_pool_class(capacity, &size);
+
+    // cannot be cached? free it directly
+    if (index < 0 || size != capacity)
+    {
+        tb_align_free(data);
+        return ;
+    }
+
+    // enter
+    tb_spinlock_enter(&g_lock);
+
+    // free the older blocks if the cache is full
+    gb_bitmap_pool_evict(capacity);
+
+    // cache it
+    gb_bitmap_pool_block_t* block = (gb_bitmap_pool_block_t*)data;
+    block->next         = g_blocks[index];
+    block->row_bytes    = row_bytes;
+    g_blocks[index]     = block;
+    g_cached           += capacity;
+
+    // leave
+    tb_spinlock_leave(&g_lock);
+}
+tb_void_t gb_bitmap_pool_clear()
+{
+    // enter
+    tb_spinlock_enter(&g_lock);
+
+    // free all blocks
+    gb_bitmap_pool_evict(GB_BITMAP_POOL_CACHE_MAXN);
+
+    // leave
+    tb_spinlock_leave(&g_lock);
+}
@@ -0,0 +1,80 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        bitmap_pool.h
+ * @ingroup     core
+ */
+#ifndef GB_CORE_IMPL_BITMAP_POOL_H
+#define GB_CORE_IMPL_BITMAP_POOL_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the alignment of the pooled data and the rows, the simd kernels can use the aligned loads
+#define GB_BITMAP_POOL_ALIGN            (64)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* malloc the pixels data from the bitmap pool
+ *
+ * the size is rounded up to the size class and the cached data of this class is reused,
+ * the data with the same row bytes is preferred, the data is not cleared.
+ *
+ * @param size          the data size
+ * @param row_bytes     the row bytes
+ * @param capacity      return the real capacity of the data
+ *
+ * @return              the data aligned by GB_BITMAP_POOL_ALIGN
+ */
+tb_pointer_t            gb_bitmap_pool_malloc(tb_size_t size, tb_size_t row_bytes, tb_size_t* capacity);
+
+/* free the pixels data to the bitmap pool
+ *
+ * the data is cached for the next allocation of this class, 
+ * and the cached data of the larger classes will be freed first if the cache is full
+ *
+ * @param data          the data
+ * @param capacity      the capacity returned by gb_bitmap_pool_malloc()
+ * @param row_bytes     the row bytes of the last user
+ */
+tb_void_t               gb_bitmap_pool_free(tb_pointer_t data, tb_size_t capacity, tb_size_t row_bytes);
+
+/* free all cached data of the bitmap pool
+ */
+tb_void_t               gb_bitmap_pool_clear(tb_noarg_t);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
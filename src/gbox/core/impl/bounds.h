@@ -81,6 +81,47 @@ static __tb_inline__ tb_void_t  gb_bounds_make(gb_rect_ref_t bounds, gb_point_re
     bounds->h = y1 - y0;
 }
 
+/* grow the made bounds for the appended points
+ *
+ * @param bounds                the bounds
+ * @param points                the appended points
+ * @param count                 the appended points count
+ */
+static __tb_inline__ tb_void_t  gb_bounds_grow(gb_rect_ref_t bounds, gb_point_ref_t points, tb_size_t count)
+{
+    // check
+    tb_assert(bounds && points);
+
+    // done
+    gb_float_t x0 = bounds->x;
+    gb_float_t y0 = bounds->y;
+    gb_float_t x1 = x0 + bounds->w;
+    gb_float_t y1 = y0 + bounds->h;
+    gb_float_t x;
+    gb_float_t y;
+    while (count--)
+    {
+        // the point
+        x = points->x;
+        y = points->y;
+
+        // make minimum and maximum point
+        if (x < x0) x0 = x;
+        if (y < y0) y0 = y;
+        if (x > x1) x1 = x;
+        if (y > y1) y1 = y;
+
+        // next point
+        points++;
+    }
+
+    // make bounds
+    bounds->x = x0;
+    bounds->y = y0;
+    bounds->w = x1 - x0;
+    bounds->h = y1 - y0;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -30,38 +30,6 @@
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
-static tb_void_t gb_cubic_make_line_impl(gb_point_t const points[4], tb_size_t count, gb_cubic_line_func_t func, tb_cpointer_t priv)
-{
-    /* divide it
-     * 
-     *          p1                 p2
-     *          . . . . . . . . . . .
-     *         .                     .
-     *        .    o2 . . . . . o4    .
-     *       .           o3            .
-     *   o1 .             |             . o5
-     *     .            chop             .
-     *    .                               .
-     *   .                                 .
-     *  .                                   .
-     * .                                     .
-     * p0, o0                                p3, o6
-     *
-     */
-    if (count)
-    {
-        // chop the cubic at half
-        gb_point_t output[7];
-        gb_cubic_chop_at_half(points, output);
-
-        // make line for cubic(o0, o1, o2, o3)
-        gb_cubic_make_line_impl(output, count - 1, func, priv);
-
-        // make line to cubic(o3, o4, o5, o6)
-        gb_cubic_make_line_impl(output + 3, count - 1, func, priv);
-    }
-    else func((gb_point_ref_t)&points[3], priv);
-}
 static tb_void_t gb_cubic_chop_xy_at(gb_float_t const* xy, gb_float_t* output, gb_float_t factor) 
 {
     // compute the interpolation of p0 => p1
@@ -135,23 +103,31 @@ gb_float_t gb_cubic_near_distance(gb_point_t const points[4])
     // using the maximum value
     return tb_max(d1, d2);
 }
-tb_size_t gb_cubic_divide_line_count(gb_point_t const points[4])
+tb_size_t gb_cubic_divide_line_count(gb_point_t const points[4], gb_float_t scale)
 {
     // check
-    tb_assert(points);
+    tb_assert(points && scale >= 0);
 
     // compute the approximate distance
     gb_float_t distance = gb_cubic_near_distance(points);
     tb_assert(distance >= 0);
 
-    // get the integer distance
-    tb_size_t idistance = gb_ceil(distance);
-
-    // compute the divided count
-    tb_size_t count = (tb_ilog2i(idistance) >> 1) + 1;
+    /* compute the scaled distance with the tolerance
+     *
+     * the max error of the lines is about distance / 2 and it will be reduced to 1/4 after dividing it once,
+     * so the error is less than 1/4 pixel if 4^count >= (distance * scale / 2) / (1 / 4) = distance * scale * 2,
+     * and n = ceil(distance * scale * 2) for both the fixed and float
+     */
+#ifdef GB_CONFIG_FLOAT_FIXED
+    tb_hize_t n = (tb_hize_t)(((tb_hong_t)distance * scale + (((tb_hong_t)1 << 31) - 1)) >> 31);
+#else
+    gb_float_t f = distance * scale * 2;
+    tb_hize_t n = f < (gb_float_t)(1 << (GB_CUBIC_DIVIDED_LINE_MAXN << 1))? (tb_hize_t)gb_ceil(f) : ((tb_hize_t)1 << (GB_CUBIC_DIVIDED_LINE_MAXN << 1));
+#endif
 
-    // limit the count
-    if (count > GB_CUBIC_DIVIDED_MAXN) count = GB_CUBIC_DIVIDED_MAXN;
+    // compute the divided count: ceil(log4(n))
+    tb_size_t count = 0;
+    while (count < GB_CUBIC_DIVIDED_LINE_MAXN && ((tb_hize_t)1 << (count << 1)) < n) count++;
 
     // ok
     return count;
@@ -274,15 +250,91 @@ tb_size_t gb_cubic_chop_at_max_curvature(gb_point_t const points[4], gb_point_t
     // the sub-curve count
     return factors_count + 1;
 }
-tb_void_t gb_cubic_make_line(gb_point_t const points[4], gb_cubic_line_func_t func, tb_cpointer_t priv)
+tb_size_t gb_cubic_make_line(gb_point_t const points[4], tb_size_t count, gb_point_ref_t output)
 {
     // check
-    tb_assert(func && points);
+    tb_assert(points && output && count <= GB_CUBIC_DIVIDED_LINE_MAXN);
 
-    // compute the divided count first
-    tb_size_t count = gb_cubic_divide_line_count(points);
+    /* make the points at t = i / n by the forward differencing, n = 2^count
+     *
+     * they are the same as the end points of the sub-curves after chopping it at half for count times
+     *
+     * X(t) = x0 + c1 * t + c2 * t^2 + c3 * t^3
+     * c1 = 3 * (x1 - x0)
+     * c2 = 3 * (x0 - 2 * x1 + x2)
+     * c3 = x3 - x0 + 3 * (x1 - x2)
+     *
+     * X(i) * n^3 = x0 * n^3 + c1 * n^2 * i + c2 * n * i^2 + c3 * i^3
+     * => d1(0) = c1 * n^2 + c2 * n + c3
+     * => d2(0) = 2 * c2 * n + 6 * c3
+     * => d3 = 6 * c3
+     */
+    tb_size_t i = 1;
+    tb_size_t n = (tb_size_t)1 << count;
+#ifdef GB_CONFIG_FLOAT_FIXED
+    // compute them exactly with the integers scaled by n^3
+    tb_size_t shift = count * 3;
+    tb_hong_t round = shift? ((tb_hong_t)1 << (shift - 1)) : 0;
+    tb_hong_t c1x   = ((tb_hong_t)points[1].x - points[0].x) * 3;
+    tb_hong_t c1y   = ((tb_hong_t)points[1].y - points[0].y) * 3;
+    tb_hong_t c2x   = ((tb_hong_t)points[0].x - ((tb_hong_t)points[1].x << 1) + points[2].x) * 3;
+    tb_hong_t c2y   = ((tb_hong_t)points[0].y - ((tb_hong_t)points[1].y << 1) + points[2].y) * 3;
+    tb_hong_t c3x   = (tb_hong_t)points[3].x - points[0].x + ((tb_hong_t)points[1].x - points[2].x) * 3;
+    tb_hong_t c3y   = (tb_hong_t)points[3].y - points[0].y + ((tb_hong_t)points[1].y - points[2].y) * 3;
+    tb_hong_t x     = (tb_hong_t)points[0].x << shift;
+    tb_hong_t y     = (tb_hong_t)points[0].y << shift;
+    tb_hong_t d1x   = (c1x << (count << 1)) + (c2x << count) + c3x;
+    tb_hong_t d1y   = (c1y << (count << 1)) + (c2y << count) + c3y;
+    tb_hong_t d2x   = ((c2x << count) << 1) + c3x * 6;
+    tb_hong_t d2y   = ((c2y << count) << 1) + c3y * 6;
+    tb_hong_t d3x   = c3x * 6;
+    tb_hong_t d3y   = c3y * 6;
+    for (; i < n; i++, output++)
+    {
+        x   += d1x;
+        y   += d1y;
+        d1x += d2x;
+        d1y += d2y;
+        d2x += d3x;
+        d2y += d3y;
+        output->x = (gb_float_t)((x + round) >> shift);
+        output->y = (gb_float_t)((y + round) >> shift);
+    }
+#else
+    // the step
+    gb_float_t h    = 1.0f / (gb_float_t)n;
+    gb_float_t hh   = h * h;
+    gb_float_t hhh  = hh * h;
+    gb_float_t c1x  = (points[1].x - points[0].x) * 3;
+    gb_float_t c1y  = (points[1].y - points[0].y) * 3;
+    gb_float_t c2x  = (points[0].x - points[1].x - points[1].x + points[2].x) * 3;
+    gb_float_t c2y  = (points[0].y - points[1].y - points[1].y + points[2].y) * 3;
+    gb_float_t c3x  = points[3].x - points[0].x + (points[1].x - points[2].x) * 3;
+    gb_float_t c3y  = points[3].y - points[0].y + (points[1].y - points[2].y) * 3;
+    gb_float_t x    = points[0].x;
+    gb_float_t y    = points[0].y;
+    gb_float_t d1x  = c1x * h + c2x * hh + c3x * hhh;
+    gb_float_t d1y  = c1y * h + c2y * hh + c3y * hhh;
+    gb_float_t d2x  = c2x * hh * 2 + c3x * hhh * 6;
+    gb_float_t d2y  = c2y * hh * 2 + c3y * hhh * 6;
+    gb_float_t d3x  = c3x * hhh * 6;
+    gb_float_t d3y  = c3y * hhh * 6;
+    for (; i < n; i++, output++)
+    {
+        x   += d1x;
+        y   += d1y;
+        d1x += d2x;
+        d1y += d2y;
+        d2x += d3x;
+        d2y += d3y;
+        output->x = x;
+        output->y = y;
+    }
+#endif
 
-    // make line
-    gb_cubic_make_line_impl(points, count, func, priv);
-}
+    // the last point is the end point exactly
+    *output = points[3];
 
+    // the points count
+    return n;
+}
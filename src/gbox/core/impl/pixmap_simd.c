@@ -0,0 +1,1084 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        pixmap_simd.c
+ * @ingroup     core
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "pixmap_simd"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "pixmap_simd.h"
+#if defined(TB_COMPILER_IS_GCC) && TB_COMPILER_VERSION_BE(4, 9) && (defined(TB_ARCH_x86) || defined(TB_ARCH_x64))
+#   define GB_PIXMAP_SIMD_HAVE_X86
+#   include <immintrin.h>
+#elif defined(TB_ARCH_ARM) && (defined(__ARM_NEON__) || defined(__ARM_NEON)) && !defined(TB_WORDS_BIGENDIAN)
+#   define GB_PIXMAP_SIMD_HAVE_NEON
+#   include <arm_neon.h>
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// enable the instruction set for the given function and we need not any compile flags
+#ifdef GB_PIXMAP_SIMD_HAVE_X86
+#   define GB_PIXMAP_SIMD_TARGET(isa)   __attribute__((target(isa)))
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the simd type
+typedef enum __gb_pixmap_simd_e
+{
+    GB_PIXMAP_SIMD_NONE     = 0
+,   GB_PIXMAP_SIMD_SSE2     = 1
+,   GB_PIXMAP_SIMD_AVX2     = 2
+,   GB_PIXMAP_SIMD_NEON     = 3
+
+}gb_pixmap_simd_e;
+
+// the pixel kind of the converter
+typedef enum __gb_pixmap_simd_kind_e
+{
+    GB_PIXMAP_SIMD_KIND_RGB32   = 0
+,   GB_PIXMAP_SIMD_KIND_RGB565  = 1
+,   GB_PIXMAP_SIMD_KIND_RGB888  = 2
+
+}gb_pixmap_simd_kind_e;
+
+// the pixel layout of the converter
+typedef struct __gb_pixmap_simd_layout_t
+{
+    // the byte offsets of the channels in the pixel, only for rgb32 and rgb888
+    tb_byte_t               a;
+    tb_byte_t               r;
+    tb_byte_t               g;
+    tb_byte_t               b;
+
+    // the kind
+    tb_byte_t               kind;
+
+    // the bytes of the pixel
+    tb_byte_t               btp;
+
+    // has alpha?
+    tb_byte_t               alpha;
+
+}gb_pixmap_simd_layout_t;
+
+// the converter func type
+typedef tb_void_t           (*gb_pixmap_simd_func_convert_t)(tb_byte_t* d, gb_pixmap_simd_layout_t const* dl, tb_byte_t const* s, gb_pixmap_simd_layout_t const* sl, tb_size_t count);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+#if defined(GB_PIXMAP_SIMD_HAVE_X86) || defined(GB_PIXMAP_SIMD_HAVE_NEON)
+static __tb_inline__ tb_uint32_t gb_pixmap_simd_rgb32_blend(tb_uint32_t d, tb_uint32_t s, tb_size_t a)
+{
+    // (s * a + d * (256 - a)) >> 8 for each channel, the 16-bits lanes will not be overflow
+    tb_uint32_t hs = (s >> 8) & 0x00ff00ff;
+    tb_uint32_t hd = (d >> 8) & 0x00ff00ff;
+    tb_uint32_t ls = s & 0x00ff00ff;
+    tb_uint32_t ld = d & 0x00ff00ff;
+    hd = ((hs * a + hd * (256 - a)) >> 8) & 0x00ff00ff;
+    ld = ((ls * a + ld * (256 - a)) >> 8) & 0x00ff00ff;
+    return (hd << 8) | ld;
+}
+static __tb_inline__ tb_void_t gb_pixmap_simd_rgb32_pixels_fill_tail(tb_uint32_t* p, gb_pixel_t pixel, tb_size_t count, tb_size_t alpha)
+{
+    while (count--)
+    {
+        tb_bits_set_u32_le(p, gb_pixmap_simd_rgb32_blend(tb_bits_get_u32_le(p), pixel, alpha));
+        p++;
+    }
+}
+static __tb_inline__ tb_void_t gb_pixmap_simd_rgb565_pixels_fill_tail(tb_uint16_t* p, gb_pixel_t pixel, tb_size_t count, tb_long_t alpha)
+{
+    // the source channels
+    tb_long_t sr = (pixel >> 11) & 0x1f;
+    tb_long_t sg = (pixel >> 5) & 0x3f;
+    tb_long_t sb = pixel & 0x1f;
+
+    // d + ((s - d) * a) >> 5 for each channel
+    tb_long_t d;
+    tb_long_t dr;
+    tb_long_t dg;
+    tb_long_t db;
+    while (count--)
+    {
+        d   = tb_bits_get_u16_le(p);
+        dr  = (d >> 11) & 0x1f;
+        dg  = (d >> 5) & 0x3f;
+        db  = d & 0x1f;
+        dr += ((sr - dr) * alpha) >> 5;
+        dg += ((sg - dg) * alpha) >> 5;
+        db += ((sb - db) * alpha) >> 5;
+        tb_bits_set_u16_le(p, (tb_uint16_t)((dr << 11) | (dg << 5) | db));
+        p++;
+    }
+}
+static tb_bool_t gb_pixmap_simd_layout(tb_size_t pixfmt, gb_pixmap_simd_layout_t* layout)
+{
+    // the bit shifts of the channels in the pixel value
+    tb_size_t   a = 0;
+    tb_size_t   r = 0;
+    tb_size_t   g = 0;
+    tb_size_t   b = 0;
+    tb_size_t   bendian = GB_PIXFMT_BE(pixfmt);
+    switch (GB_PIXFMT(pixfmt))
+    {
+    case GB_PIXFMT(GB_PIXFMT_ARGB8888):
+    case GB_PIXFMT(GB_PIXFMT_XRGB8888):
+        a = 24; r = 16; g = 8; b = 0;
+        layout->kind = GB_PIXMAP_SIMD_KIND_RGB32;
+        layout->btp = 4;
+        break;
+    case GB_PIXFMT(GB_PIXFMT_RGBA8888):
+    case GB_PIXFMT(GB_PIXFMT_RGBX8888):
+        a = 0; r = 24; g = 16; b = 8;
+        layout->kind = GB_PIXMAP_SIMD_KIND_RGB32;
+        layout->btp = 4;
+        break;
+    case GB_PIXFMT(GB_PIXFMT_RGB888):
+        a = 0; r = 16; g = 8; b = 0;
+        layout->kind = GB_PIXMAP_SIMD_KIND_RGB888;
+        layout->btp = 3;
+        break;
+    case GB_PIXFMT(GB_PIXFMT_RGB565):
+        // only for little endian
+        tb_check_return_val(!bendian, tb_false);
+        layout->kind = GB_PIXMAP_SIMD_KIND_RGB565;
+        layout->btp = 2;
+        break;
+    default:
+        return tb_false;
+    }
+
+    // the byte offsets of the channels in memory
+    layout->a = (tb_byte_t)(bendian? layout->btp - 1 - (a >> 3) : (a >> 3));
+    layout->r = (tb_byte_t)(bendian? layout->btp - 1 - (r >> 3) : (r >> 3));
+    layout->g = (tb_byte_t)(bendian? layout->btp - 1 - (g >> 3) : (g >> 3));
+    layout->b = (tb_byte_t)(bendian? layout->btp - 1 - (b >> 3) : (b >> 3));
+    layout->alpha = GB_PIXFMT_HAS_ALPHA(pixfmt)? 1 : 0;
+
+    // ok
+    return tb_true;
+}
+static __tb_inline__ tb_void_t gb_pixmap_simd_convert_tail(tb_byte_t* d, gb_pixmap_simd_layout_t const* dl, tb_byte_t const* s, gb_pixmap_simd_layout_t const* sl, tb_size_t count)
+{
+    // the alpha is kept only if both have alpha, the same as converting it with the color
+    tb_byte_t   r;
+    tb_byte_t   g;
+    tb_byte_t   b;
+    tb_byte_t   a;
+    tb_size_t   p;
+    while (count--)
+    {
+        // get the channels
+        if (sl->kind == GB_PIXMAP_SIMD_KIND_RGB565)
+        {
+            p = tb_bits_get_u16_le(s);
+            r = (tb_byte_t)GB_RGB_565_R(p);
+            g = (tb_byte_t)GB_RGB_565_G(p);
+            b = (tb_byte_t)GB_RGB_565_B(p);
+            a = 0xff;
+        }
+        else
+        {
+            r = s[sl->r];
+            g = s[sl->g];
+            b = s[sl->b];
+            a = sl->alpha? s[sl->a] : 0xff;
+        }
+
+        // set the channels
+        if (dl->kind == GB_PIXMAP_SIMD_KIND_RGB565) tb_bits_set_u16_le(d, (tb_uint16_t)GB_RGB_565(r, g, b));
+        else
+        {
+            d[dl->r] = r;
+            d[dl->g] = g;
+            d[dl->b] = b;
+            if (dl->kind == GB_PIXMAP_SIMD_KIND_RGB32) d[dl->a] = dl->alpha? a : 0xff;
+        }
+
+        // next
+        s += sl->btp;
+        d += dl->btp;
+    }
+}
+static __tb_inline__ tb_void_t gb_pixmap_simd_reduce2x2_tail(tb_byte_t* d, tb_byte_t const* s0, tb_byte_t const* s1, tb_size_t count)
+{
+    // reduce the left pixels
+    tb_size_t i = 0;
+    for (; count; count--, d += 4, s0 += 8, s1 += 8)
+    {
+        for (i = 0; i < 4; i++) d[i] = (tb_byte_t)((s0[i] + s0[i + 4] + s1[i] + s1[i + 4] + 2) >> 2);
+    }
+}
+#endif
+
+#ifdef GB_PIXMAP_SIMD_HAVE_X86
+GB_PIXMAP_SIMD_TARGET("sse2") static tb_void_t gb_pixmap_simd_rgb32_pixels_fill_sse2(tb_pointer_t data, gb_pixel_t pixel, tb_size_t count, tb_byte_t alpha)
+{
+    // transparent?
+    tb_check_return(alpha);
+
+    // the source: s * a for each channel
+    __m128i         zero = _mm_setzero_si128();
+    __m128i         sa = _mm_mullo_epi16(_mm_unpacklo_epi8(_mm_set1_epi32((tb_int32_t)pixel), zero), _mm_set1_epi16((tb_int16_t)alpha));
+    __m128i         ia = _mm_set1_epi16((tb_int16_t)(256 - alpha));
+
+    // blend 4 pixels: (s * a + d * (256 - a)) >> 8
+    __m128i         d;
+    __m128i         dl;
+    __m128i         dh;
+    tb_uint32_t*    p = (tb_uint32_t*)data;
+    tb_uint32_t*    e = p + (count & ~3);
+    while (p < e)
+    {
+        d   = _mm_loadu_si128((__m128i const*)p);
+        dl  = _mm_unpacklo_epi8(d, zero);
+        dh  = _mm_unpackhi_epi8(d, zero);
+        dl  = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(dl, ia), sa), 8);
+        dh  = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(dh, ia), sa), 8);
+        _mm_storeu_si128((__m128i*)p, _mm_packus_epi16(dl, dh));
+        p += 4;
+    }
+
+    // blend the left pixels
+    gb_pixmap_simd_rgb32_pixels_fill_tail(p, pixel, count & 3, alpha);
+}
+GB_PIXMAP_SIMD_TARGET("avx2") static tb_void_t gb_pixmap_simd_rgb32_pixels_fill_avx2(tb_pointer_t data, gb_pixel_t pixel, tb_size_t count, tb_byte_t alpha)
+{
+    // transparent?
+    tb_check_return(alpha);
+
+    // the source: s * a for each channel
+    __m256i         zero = _mm256_setzero_si256();
+    __m256i         sa = _mm256_mullo_epi16(_mm256_unpacklo_epi8(_mm256_set1_epi32((tb_int32_t)pixel), zero), _mm256_set1_epi16((tb_int16_t)alpha));
+    __m256i         ia = _mm256_set1_epi16((tb_int16_t)(256 - alpha));
+
+    /* blend 8 pixels: (s * a + d * (256 - a)) >> 8
+     *
+     * the unpack and pack are done in the 128-bits lanes, so the order of pixels will be kept
+     */
+    __m256i         d;
+    __m256i         dl;
+    __m256i         dh;
+    tb_uint32_t*    p = (tb_uint32_t*)data;
+    tb_uint32_t*    e = p + (count & ~7);
+    while (p < e)
+    {
+        d   = _mm256_loadu_si256((__m256i const*)p);
+        dl  = _mm256_unpacklo_epi8(d, zero);
+        dh  = _mm256_unpackhi_epi8(d, zero);
+        dl  = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(dl, ia), sa), 8);
+        dh  = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(dh, ia), sa), 8);
+        _mm256_storeu_si256((__m256i*)p, _mm256_packus_epi16(dl, dh));
+        p += 8;
+    }
+
+    // blend the left pixels
+    gb_pixmap_simd_rgb32_pixels_fill_tail(p, pixel, count & 7, alpha);
+}
+GB_PIXMAP_SIMD_TARGET("sse2") static tb_void_t gb_pixmap_simd_rgb565_pixels_fill_sse2(tb_pointer_t data, gb_pixel_t pixel, tb_size_t count, tb_byte_t alpha)
+{
+    // transparent?
+    tb_size_t a = alpha >> 3;
+    tb_check_return(a);
+
+    // the source channels
+    __m128i         sr = _mm_set1_epi16((tb_int16_t)((pixel >> 11) & 0x1f));
+    __m128i         sg = _mm_set1_epi16((tb_int16_t)((pixel >> 5) & 0x3f));
+    __m128i         sb = _mm_set1_epi16((tb_int16_t)(pixel & 0x1f));
+    __m128i         sa = _mm_set1_epi16((tb_int16_t)a);
+    __m128i         m6 = _mm_set1_epi16(0x3f);
+    __m128i         m5 = _mm_set1_epi16(0x1f);
+
+    // blend 8 pixels: d + ((s - d) * a) >> 5
+    __m128i         d;
+    __m128i         dr;
+    __m128i         dg;
+    __m128i         db;
+    tb_uint16_t*    p = (tb_uint16_t*)data;
+    tb_uint16_t*    e = p + (count & ~7);
+    while (p < e)
+    {
+        d   = _mm_loadu_si128((__m128i const*)p);
+        dr  = _mm_srli_epi16(d, 11);
+        dg  = _mm_and_si128(_mm_srli_epi16(d, 5), m6);
+        db  = _mm_and_si128(d, m5);
+        dr  = _mm_add_epi16(dr, _mm_srai_epi16(_mm_mullo_epi16(_mm_sub_epi16(sr, dr), sa), 5));
+        dg  = _mm_add_epi16(dg, _mm_srai_epi16(_mm_mullo_epi16(_mm_sub_epi16(sg, dg), sa), 5));
+        db  = _mm_add_epi16(db, _mm_srai_epi16(_mm_mullo_epi16(_mm_sub_epi16(sb, db), sa), 5));
+        _mm_storeu_si128((__m128i*)p, _mm_or_si128(_mm_or_si128(_mm_slli_epi16(dr, 11), _mm_slli_epi16(dg, 5)), db));
+        p += 8;
+    }
+
+    // blend the left pixels
+    gb_pixmap_simd_rgb565_pixels_fill_tail(p, pixel, count & 7, a);
+}
+GB_PIXMAP_SIMD_TARGET("avx2") static tb_void_t gb_pixmap_simd_rgb565_pixels_fill_avx2(tb_pointer_t data, gb_pixel_t pixel, tb_size_t count, tb_byte_t alpha)
+{
+    // transparent?
+    tb_size_t a = alpha >> 3;
+    tb_check_return(a);
+
+    // the source channels
+    __m256i         sr = _mm256_set1_epi16((tb_int16_t)((pixel >> 11) & 0x1f));
+    __m256i         sg = _mm256_set1_epi16((tb_int16_t)((pixel >> 5) & 0x3f));
+    __m256i         sb = _mm256_set1_epi16((tb_int16_t)(pixel & 0x1f));
+    __m256i         sa = _mm256_set1_epi16((tb_int16_t)a);
+    __m256i         m6 = _mm256_set1_epi16(0x3f);
+    __m256i         m5 = _mm256_set1_epi16(0x1f);
+
+    // blend 16 pixels: d + ((s - d) * a) >> 5
+    __m256i         d;
+    __m256i         dr;
+    __m256i         dg;
+    __m256i         db;
+    tb_uint16_t*    p = (tb_uint16_t*)data;
+    tb_uint16_t*    e = p + (count & ~15);
+    while (p < e)
+    {
+        d   = _mm256_loadu_si256((__m256i const*)p);
+        dr  = _mm256_srli_epi16(d, 11);
+        dg  = _mm256_and_si256(_mm256_srli_epi16(d, 5), m6);
+        db  = _mm256_and_si256(d, m5);
+        dr  = _mm256_add_epi16(dr, _mm256_srai_epi16(_mm256_mullo_epi16(_mm256_sub_epi16(sr, dr), sa), 5));
+        dg  = _mm256_add_epi16(dg, _mm256_srai_epi16(_mm256_mullo_epi16(_mm256_sub_epi16(sg, dg), sa), 5));
+        db  = _mm256_add_epi16(db, _mm256_srai_epi16(_mm256_mullo_epi16(_mm256_sub_epi16(sb, db), sa), 5));
+        _mm256_storeu_si256((__m256i*)p, _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi16(dr, 11), _mm256_slli_epi16(dg, 5)), db));
+        p += 16;
+    }
+
+    // blend the left pixels
+    gb_pixmap_simd_rgb565_pixels_fill_tail(p, pixel, count & 15, a);
+}
+GB_PIXMAP_SIMD_TARGET("sse2") static tb_void_t gb_pixmap_simd_rgb32_convert_sse2(tb_byte_t* d, gb_pixmap_simd_layout_t const* dl, tb_byte_t const* s, gb_pixmap_simd_layout_t const* sl, tb_size_t count)
+{
+    // the alpha is moved if both have alpha, otherwise it will be filled with 0xff
+    tb_bool_t       alpha = sl->alpha && dl->alpha;
+
+    // the shifts of the channels: ((x >> (s * 8)) & 0xff) << (d * 8)
+    __m128i         sa = _mm_cvtsi32_si128(sl->a << 3);
+    __m128i         sr = _mm_cvtsi32_si128(sl->r << 3);
+    __m128i         sg = _mm_cvtsi32_si128(sl->g << 3);
+    __m128i         sb = _mm_cvtsi32_si128(sl->b << 3);
+    __m128i         da = _mm_cvtsi32_si128(dl->a << 3);
+    __m128i         dr = _mm_cvtsi32_si128(dl->r << 3);
+    __m128i         dg = _mm_cvtsi32_si128(dl->g << 3);
+    __m128i         db = _mm_cvtsi32_si128(dl->b << 3);
+    __m128i         ma = _mm_set1_epi32(alpha? 0xff : 0);
+    __m128i         mc = _mm_set1_epi32(0xff);
+    __m128i         xa = _mm_set1_epi32(alpha? 0 : (tb_int32_t)(0xffu << (dl->a << 3)));
+
+    // convert 4 pixels
+    __m128i         x;
+    __m128i         y;
+    tb_byte_t*      e = d + ((count & ~3) << 2);
+    while (d < e)
+    {
+        x = _mm_loadu_si128((__m128i const*)s);
+        y = _mm_or_si128(xa, _mm_sll_epi32(_mm_and_si128(_mm_srl_epi32(x, sa), ma), da));
+        y = _mm_or_si128(y, _mm_sll_epi32(_mm_and_si128(_mm_srl_epi32(x, sr), mc), dr));
+        y = _mm_or_si128(y, _mm_sll_epi32(_mm_and_si128(_mm_srl_epi32(x, sg), mc), dg));
+        y = _mm_or_si128(y, _mm_sll_epi32(_mm_and_si128(_mm_srl_epi32(x, sb), mc), db));
+        _mm_storeu_si128((__m128i*)d, y);
+        s += 16;
+        d += 16;
+    }
+
+    // convert the left pixels
+    gb_pixmap_simd_convert_tail(d, dl, s, sl, count & 3);
+}
+GB_PIXMAP_SIMD_TARGET("sse2") static tb_void_t gb_pixmap_simd_rgb565_to_rgb32_sse2(tb_byte_t* d, gb_pixmap_simd_layout_t const* dl, tb_byte_t const* s, gb_pixmap_simd_layout_t const* sl, tb_size_t count)
+{
+    // the shifts of the channels
+    __m128i         dr = _mm_cvtsi32_si128(dl->r << 3);
+    __m128i         dg = _mm_cvtsi32_si128(dl->g << 3);
+    __m128i         db = _mm_cvtsi32_si128(dl->b << 3);
+    __m128i         xa = _mm_set1_epi32((tb_int32_t)(0xffu << (dl->a << 3)));
+    __m128i         mr = _mm_set1_epi32(0xf8);
+    __m128i         mg = _mm_set1_epi32(0xfc);
+    __m128i         z = _mm_setzero_si128();
+
+    // convert 8 pixels
+    __m128i         p;
+    __m128i         x;
+    tb_size_t       i;
+    tb_byte_t*      e = d + ((count & ~7) << 2);
+    while (d < e)
+    {
+        p = _mm_loadu_si128((__m128i const*)s);
+        for (i = 0; i < 2; i++)
+        {
+            // the 4 pixels of the low or high half
+            x = i? _mm_unpackhi_epi16(p, z) : _mm_unpacklo_epi16(p, z);
+
+            // r: (p >> 8) & 0xf8, g: (p >> 3) & 0xfc, b: (p << 3) & 0xf8
+            _mm_storeu_si128((__m128i*)d, _mm_or_si128(_mm_or_si128(xa, _mm_sll_epi32(_mm_and_si128(_mm_srli_epi32(x, 8), mr), dr))
+                                                    ,   _mm_or_si128(_mm_sll_epi32(_mm_and_si128(_mm_srli_epi32(x, 3), mg), dg)
+                                                                    , _mm_sll_epi32(_mm_and_si128(_mm_slli_epi32(x, 3), mr), db))));
+            d += 16;
+        }
+        s += 16;
+    }
+
+    // convert the left pixels
+    gb_pixmap_simd_convert_tail(d, dl, s, sl, count & 7);
+}
+GB_PIXMAP_SIMD_TARGET("sse2") static tb_void_t gb_pixmap_simd_rgb32_to_rgb565_sse2(tb_byte_t* d, gb_pixmap_simd_layout_t const* dl, tb_byte_t const* s, gb_pixmap_simd_layout_t const* sl, tb_size_t count)
+{
+    // the shifts of the channels
+    __m128i         sr = _mm_cvtsi32_si128((sl->r << 3) + 3);
+    __m128i         sg = _mm_cvtsi32_si128((sl->g << 3) + 2);
+    __m128i         sb = _mm_cvtsi32_si128((sl->b << 3) + 3);
+    __m128i         m5 = _mm_set1_epi32(0x1f);
+    __m128i         m6 = _mm_set1_epi32(0x3f);
+    __m128i         k = _mm_set1_epi32(0x8000);
+    __m128i         k16 = _mm_set1_epi16((tb_int16_t)0x8000);
+
+    // convert 8 pixels
+    __m128i         x;
+    __m128i         y[2];
+    tb_size_t       i;
+    tb_byte_t*      e = d + ((count & ~7) << 1);
+    while (d < e)
+    {
+        for (i = 0; i < 2; i++)
+        {
+            // (r >> 3) << 11 | (g >> 2) << 5 | (b >> 3)
+            x       = _mm_loadu_si128((__m128i const*)s);
+            y[i]    = _mm_or_si128(_mm_slli_epi32(_mm_and_si128(_mm_srl_epi32(x, sr), m5), 11), _mm_slli_epi32(_mm_and_si128(_mm_srl_epi32(x, sg), m6), 5));
+            y[i]    = _mm_or_si128(y[i], _mm_and_si128(_mm_srl_epi32(x, sb), m5));
+
+            // bias it for the signed saturation of packs
+            y[i]    = _mm_sub_epi32(y[i], k);
+            s += 16;
+        }
+
+        // pack to 16-bits and remove the bias
+        _mm_storeu_si128((__m128i*)d, _mm_xor_si128(_mm_packs_epi32(y[0], y[1]), k16));
+        d += 16;
+    }
+
+    // convert the left pixels
+    gb_pixmap_simd_convert_tail(d, dl, s, sl, count & 7);
+}
+GB_PIXMAP_SIMD_TARGET("avx2") static tb_void_t gb_pixmap_simd_rgb32_convert_avx2(tb_byte_t* d, gb_pixmap_simd_layout_t const* dl, tb_byte_t const* s, gb_pixmap_simd_layout_t const* sl, tb_size_t count)
+{
+    // the alpha is moved if both have alpha, otherwise it will be filled with 0xff
+    tb_bool_t       alpha = sl->alpha && dl->alpha;
+
+    // make the shuffle indices of the channels for 8 pixels, 0x80: zero
+    tb_size_t       i;
+    tb_byte_t       indices[32];
+    for (i = 0; i < 32; i += 4)
+    {
+        indices[i + dl->a] = alpha? (tb_byte_t)((i & 15) + sl->a) : 0x80;
+        indices[i + dl->r] = (tb_byte_t)((i & 15) + sl->r);
+        indices[i + dl->g] = (tb_byte_t)((i & 15) + sl->g);
+        indices[i + dl->b] = (tb_byte_t)((i & 15) + sl->b);
+    }
+    __m256i         k = _mm256_loadu_si256((__m256i const*)indices);
+    __m256i         xa = _mm256_set1_epi32(alpha? 0 : (tb_int32_t)(0xffu << (dl->a << 3)));
+
+    // convert 8 pixels
+    tb_byte_t*      e = d + ((count & ~7) << 2);
+    while (d < e)
+    {
+        _mm256_storeu_si256((__m256i*)d, _mm256_or_si256(_mm256_shuffle_epi8(_mm256_loadu_si256((__m256i const*)s), k), xa));
+        s += 32;
+        d += 32;
+    }
+
+    // convert the left pixels
+    gb_pixmap_simd_convert_tail(d, dl, s, sl, count & 7);
+}
+GB_PIXMAP_SIMD_TARGET("avx2") static tb_void_t gb_pixmap_simd_rgb565_to_rgb32_avx2(tb_byte_t* d, gb_pixmap_simd_layout_t const* dl, tb_byte_t const* s, gb_pixmap_simd_layout_t const* sl, tb_size_t count)
+{
+    // the shifts of the channels
+    __m128i         dr = _mm_cvtsi32_si128(dl->r << 3);
+    __m128i         dg = _mm_cvtsi32_si128(dl->g << 3);
+    __m128i         db = _mm_cvtsi32_si128(dl->b << 3);
+    __m256i         xa = _mm256_set1_epi32((tb_int32_t)(0xffu << (dl->a << 3)));
+    __m256i         mr = _mm256_set1_epi32(0xf8);
+    __m256i         mg = _mm256_set1_epi32(0xfc);
+
+    // convert 8 pixels
+    __m256i         x;
+    tb_byte_t*      e = d + ((count & ~7) << 2);
+    while (d < e)
+    {
+        // r: (p >> 8) & 0xf8, g: (p >> 3) & 0xfc, b: (p << 3) & 0xf8
+        x = _mm256_cvtepu16_epi32(_mm_loadu_si128((__m128i const*)s));
+        _mm256_storeu_si256((__m256i*)d, _mm256_or_si256(_mm256_or_si256(xa, _mm256_sll_epi32(_mm256_and_si256(_mm256_srli_epi32(x, 8), mr), dr))
+                                                    ,   _mm256_or_si256(_mm256_sll_epi32(_mm256_and_si256(_mm256_srli_epi32(x, 3), mg), dg)
+                                                                    , _mm256_sll_epi32(_mm256_and_si256(_mm256_slli_epi32(x, 3), mr), db))));
+        s += 16;
+        d += 32;
+    }
+
+    // convert the left pixels
+    gb_pixmap_simd_convert_tail(d, dl, s, sl, count & 7);
+}
+GB_PIXMAP_SIMD_TARGET("avx2") static tb_void_t gb_pixmap_simd_rgb32_to_rgb565_avx2(tb_byte_t* d, gb_pixmap_simd_layout_t const* dl, tb_byte_t const* s, gb_pixmap_simd_layout_t const* sl, tb_size_t count)
+{
+    // the shifts of the channels
+    __m128i         sr = _mm_cvtsi32_si128((sl->r << 3) + 3);
+    __m128i         sg = _mm_cvtsi32_si128((sl->g << 3) + 2);
+    __m128i         sb = _mm_cvtsi32_si128((sl->b << 3) + 3);
+    __m256i         m5 = _mm256_set1_epi32(0x1f);
+    __m256i         m6 = _mm256_set1_epi32(0x3f);
+
+    // convert 16 pixels
+    __m256i         x;
+    __m256i         y[2];
+    tb_size_t       i;
+    tb_byte_t*      e = d + ((count & ~15) << 1);
+    while (d < e)
+    {
+        for (i = 0; i < 2; i++)
+        {
+            // (r >> 3) << 11 | (g >> 2) << 5 | (b >> 3)
+            x       = _mm256_loadu_si256((__m256i const*)s);
+            y[i]    = _mm256_or_si256(_mm256_slli_epi32(_mm256_and_si256(_mm256_srl_epi32(x, sr), m5), 11), _mm256_slli_epi32(_mm256_and_si256(_mm256_srl_epi32(x, sg), m6), 5));
+            y[i]    = _mm256_or_si256(y[i], _mm256_and_si256(_mm256_srl_epi32(x, sb), m5));
+            s += 32;
+        }
+
+        // pack to 16-bits, the packing is in-lane and we need restore the order of the 64-bits blocks
+        _mm256_storeu_si256((__m256i*)d, _mm256_permute4x64_epi64(_mm256_packus_epi32(y[0], y[1]), 0xd8));
+        d += 32;
+    }
+
+    // convert the left pixels
+    gb_pixmap_simd_convert_tail(d, dl, s, sl, count & 15);
+}
+GB_PIXMAP_SIMD_TARGET("avx2") static tb_void_t gb_pixmap_simd_rgb888_to_rgb32_avx2(tb_byte_t* d, gb_pixmap_simd_layout_t const* dl, tb_byte_t const* s, gb_pixmap_simd_layout_t const* sl, tb_size_t count)
+{
+    // make the shuffle indices of the channels for 4 pixels in each lane, 0x80: zero
+    tb_size_t       i;
+    tb_byte_t       indices[32];
+    for (i = 0; i < 32; i += 4)
+    {
+        indices[i + dl->a] = 0x80;
+        indices[i + dl->r] = (tb_byte_t)(((i & 15) >> 2) * 3 + sl->r);
+        indices[i + dl->g] = (tb_byte_t)(((i & 15) >> 2) * 3 + sl->g);
+        indices[i + dl->b] = (tb_byte_t)(((i & 15) >> 2) * 3 + sl->b);
+    }
+    __m256i         k = _mm256_loadu_si256((__m256i const*)indices);
+    __m256i         xa = _mm256_set1_epi32((tb_int32_t)(0xffu << (dl->a << 3)));
+
+    // convert 8 pixels, the lanes load 16 bytes at s and s + 12, so we need 28 readable bytes
+    __m256i         x;
+    tb_size_t       n = count;
+    for (; n >= 10; n -= 8)
+    {
+        x = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((__m128i const*)s)), _mm_loadu_si128((__m128i const*)(s + 12)), 1);
+        _mm256_storeu_si256((__m256i*)d, _mm256_or_si256(_mm256_shuffle_epi8(x, k), xa));
+        s += 24;
+        d += 32;
+    }
+
+    // convert the left pixels
+    gb_pixmap_simd_convert_tail(d, dl, s, sl, n);
+}
+GB_PIXMAP_SIMD_TARGET("avx2") static tb_void_t gb_pixmap_simd_rgb32_to_rgb888_avx2(tb_byte_t* d, gb_pixmap_simd_layout_t const* dl, tb_byte_t const* s, gb_pixmap_simd_layout_t const* sl, tb_size_t count)
+{
+    // make the shuffle indices for packing 4 pixels to the low 12 bytes in each lane, 0x80: zero
+    tb_size_t       i;
+    tb_byte_t       indices[32];
+    for (i = 0; i < 32; i++) indices[i] = 0x80;
+    for (i = 0; i < 8; i++)
+    {
+        indices[((i >> 2) << 4) + (i & 3) * 3 + dl->r] = (tb_byte_t)((i & 3) * 4 + sl->r);
+        indices[((i >> 2) << 4) + (i & 3) * 3 + dl->g] = (tb_byte_t)((i & 3) * 4 + sl->g);
+        indices[((i >> 2) << 4) + (i & 3) * 3 + dl->b] = (tb_byte_t)((i & 3) * 4 + sl->b);
+    }
+    __m256i         k = _mm256_loadu_si256((__m256i const*)indices);
+
+    // convert 8 pixels
+    __m256i         y;
+    __m128i         l;
+    __m128i         h;
+    tb_byte_t*      e = d + (count & ~7) * 3;
+    while (d < e)
+    {
+        y = _mm256_shuffle_epi8(_mm256_loadu_si256((__m256i const*)s), k);
+        l = _mm256_castsi256_si128(y);
+        h = _mm256_extracti128_si256(y, 1);
+
+        // store 12 bytes of each lane with the overlapped 8-bytes stores
+        _mm_storel_epi64((__m128i*)d, l);
+        _mm_storel_epi64((__m128i*)(d + 4), _mm_srli_si128(l, 4));
+        _mm_storel_epi64((__m128i*)(d + 12), h);
+        _mm_storel_epi64((__m128i*)(d + 16), _mm_srli_si128(h, 4));
+        s += 32;
+        d += 24;
+    }
+
+    // convert the left pixels
+    gb_pixmap_simd_convert_tail(d, dl, s, sl, count & 7);
+}
+GB_PIXMAP_SIMD_TARGET("sse2") static tb_void_t gb_pixmap_simd_reduce2x2_sse2(tb_byte_t* d, tb_byte_t const* s0, tb_byte_t const* s1, tb_size_t count)
+{
+    // reduce 4 pixels from the 8 pixels of the two rows
+    __m128i     z = _mm_setzero_si128();
+    __m128i     r = _mm_set1_epi16(2);
+    __m128i     a0;
+    __m128i     a1;
+    __m128i     b0;
+    __m128i     b1;
+    __m128i     l;
+    __m128i     h;
+    tb_byte_t*  e = d + ((count & ~3) << 2);
+    while (d < e)
+    {
+        a0  = _mm_loadu_si128((__m128i const*)s0);
+        a1  = _mm_loadu_si128((__m128i const*)(s0 + 16));
+        b0  = _mm_loadu_si128((__m128i const*)s1);
+        b1  = _mm_loadu_si128((__m128i const*)(s1 + 16));
+
+        // the vertical sums of the 16-bits channels: p0 p1, p2 p3, p4 p5, p6 p7
+        l   = _mm_add_epi16(_mm_unpacklo_epi8(a0, z), _mm_unpacklo_epi8(b0, z));
+        h   = _mm_add_epi16(_mm_unpackhi_epi8(a0, z), _mm_unpackhi_epi8(b0, z));
+        a0  = _mm_unpacklo_epi64(_mm_add_epi16(l, _mm_srli_si128(l, 8)), _mm_add_epi16(h, _mm_srli_si128(h, 8)));
+        l   = _mm_add_epi16(_mm_unpacklo_epi8(a1, z), _mm_unpacklo_epi8(b1, z));
+        h   = _mm_add_epi16(_mm_unpackhi_epi8(a1, z), _mm_unpackhi_epi8(b1, z));
+        a1  = _mm_unpacklo_epi64(_mm_add_epi16(l, _mm_srli_si128(l, 8)), _mm_add_epi16(h, _mm_srli_si128(h, 8)));
+
+        // (sum + 2) / 4
+        a0  = _mm_srli_epi16(_mm_add_epi16(a0, r), 2);
+        a1  = _mm_srli_epi16(_mm_add_epi16(a1, r), 2);
+        _mm_storeu_si128((__m128i*)d, _mm_packus_epi16(a0, a1));
+        s0 += 32;
+        s1 += 32;
+        d  += 16;
+    }
+
+    // reduce the left pixels
+    gb_pixmap_simd_reduce2x2_tail(d, s0, s1, count & 3);
+}
+#endif
+
+#ifdef GB_PIXMAP_SIMD_HAVE_NEON
+static tb_void_t gb_pixmap_simd_rgb32_pixels_fill_neon(tb_pointer_t data, gb_pixel_t pixel, tb_size_t count, tb_byte_t alpha)
+{
+    // transparent?
+    tb_check_return(alpha);
+
+    // the source: s * a for each channel
+    uint8x8_t       ia = vdup_n_u8((tb_byte_t)(256 - alpha));
+    uint16x8_t      sa = vmull_u8(vreinterpret_u8_u32(vdup_n_u32(pixel)), vdup_n_u8(alpha));
+
+    // blend 4 pixels: (s * a + d * (256 - a)) >> 8
+    uint8x16_t      d;
+    uint16x8_t      dl;
+    uint16x8_t      dh;
+    tb_uint32_t*    p = (tb_uint32_t*)data;
+    tb_uint32_t*    e = p + (count & ~3);
+    while (p < e)
+    {
+        d   = vld1q_u8((tb_byte_t const*)p);
+        dl  = vmlal_u8(sa, vget_low_u8(d), ia);
+        dh  = vmlal_u8(sa, vget_high_u8(d), ia);
+        vst1q_u8((tb_byte_t*)p, vcombine_u8(vshrn_n_u16(dl, 8), vshrn_n_u16(dh, 8)));
+        p += 4;
+    }
+
+    // blend the left pixels
+    gb_pixmap_simd_rgb32_pixels_fill_tail(p, pixel, count & 3, alpha);
+}
+static tb_void_t gb_pixmap_simd_rgb565_pixels_fill_neon(tb_pointer_t data, gb_pixel_t pixel, tb_size_t count, tb_byte_t alpha)
+{
+    // transparent?
+    tb_size_t a = alpha >> 3;
+    tb_check_return(a);
+
+    // the source channels
+    int16x8_t       sr = vdupq_n_s16((tb_int16_t)((pixel >> 11) & 0x1f));
+    int16x8_t       sg = vdupq_n_s16((tb_int16_t)((pixel >> 5) & 0x3f));
+    int16x8_t       sb = vdupq_n_s16((tb_int16_t)(pixel & 0x1f));
+    int16x8_t       sa = vdupq_n_s16((tb_int16_t)a);
+    uint16x8_t      m6 = vdupq_n_u16(0x3f);
+    uint16x8_t      m5 = vdupq_n_u16(0x1f);
+
+    // blend 8 pixels: d + ((s - d) * a) >> 5
+    uint16x8_t      d;
+    int16x8_t       dr;
+    int16x8_t       dg;
+    int16x8_t       db;
+    tb_uint16_t*    p = (tb_uint16_t*)data;
+    tb_uint16_t*    e = p + (count & ~7);
+    while (p < e)
+    {
+        d   = vld1q_u16(p);
+        dr  = vreinterpretq_s16_u16(vshrq_n_u16(d, 11));
+        dg  = vreinterpretq_s16_u16(vandq_u16(vshrq_n_u16(d, 5), m6));
+        db  = vreinterpretq_s16_u16(vandq_u16(d, m5));
+        dr  = vaddq_s16(dr, vshrq_n_s16(vmulq_s16(vsubq_s16(sr, dr), sa), 5));
+        dg  = vaddq_s16(dg, vshrq_n_s16(vmulq_s16(vsubq_s16(sg, dg), sa), 5));
+        db  = vaddq_s16(db, vshrq_n_s16(vmulq_s16(vsubq_s16(sb, db), sa), 5));
+        d   = vorrq_u16(vshlq_n_u16(vreinterpretq_u16_s16(dr), 11), vshlq_n_u16(vreinterpretq_u16_s16(dg), 5));
+        vst1q_u16(p, vorrq_u16(d, vreinterpretq_u16_s16(db)));
+        p += 8;
+    }
+
+    // blend the left pixels
+    gb_pixmap_simd_rgb565_pixels_fill_tail(p, pixel, count & 7, a);
+}
+static tb_void_t gb_pixmap_simd_rgb32_convert_neon(tb_byte_t* d, gb_pixmap_simd_layout_t const* dl, tb_byte_t const* s, gb_pixmap_simd_layout_t const* sl, tb_size_t count)
+{
+    // the alpha is moved if both have alpha, otherwise it will be filled with 0xff
+    tb_bool_t       alpha = sl->alpha && dl->alpha;
+
+    // convert 16 pixels with the deinterleaved channels
+    uint8x16x4_t    x;
+    uint8x16x4_t    y;
+    uint8x16_t      xa = vdupq_n_u8(0xff);
+    tb_byte_t*      e = d + ((count & ~15) << 2);
+    while (d < e)
+    {
+        x = vld4q_u8(s);
+        y.val[dl->a] = alpha? x.val[sl->a] : xa;
+        y.val[dl->r] = x.val[sl->r];
+        y.val[dl->g] = x.val[sl->g];
+        y.val[dl->b] = x.val[sl->b];
+        vst4q_u8(d, y);
+        s += 64;
+        d += 64;
+    }
+
+    // convert the left pixels
+    gb_pixmap_simd_convert_tail(d, dl, s, sl, count & 15);
+}
+static tb_void_t gb_pixmap_simd_rgb565_to_rgb32_neon(tb_byte_t* d, gb_pixmap_simd_layout_t const* dl, tb_byte_t const* s, gb_pixmap_simd_layout_t const* sl, tb_size_t count)
+{
+    // convert 8 pixels
+    uint16x8_t      p;
+    uint8x8x4_t     y;
+    uint8x8_t       mr = vdup_n_u8(0xf8);
+    uint8x8_t       mg = vdup_n_u8(0xfc);
+    tb_byte_t*      e = d + ((count & ~7) << 2);
+    while (d < e)
+    {
+        // r: (p >> 8) & 0xf8, g: (p >> 3) & 0xfc, b: (p << 3) & 0xf8
+        p = vld1q_u16((tb_uint16_t const*)s);
+        y.val[dl->a] = vdup_n_u8(0xff);
+        y.val[dl->r] = vand_u8(vshrn_n_u16(p, 8), mr);
+        y.val[dl->g] = vand_u8(vshrn_n_u16(p, 3), mg);
+        y.val[dl->b] = vshl_n_u8(vmovn_u16(p), 3);
+        vst4_u8(d, y);
+        s += 16;
+        d += 32;
+    }
+
+    // convert the left pixels
+    gb_pixmap_simd_convert_tail(d, dl, s, sl, count & 7);
+}
+static tb_void_t gb_pixmap_simd_rgb32_to_rgb565_neon(tb_byte_t* d, gb_pixmap_simd_layout_t const* dl, tb_byte_t const* s, gb_pixmap_simd_layout_t const* sl, tb_size_t count)
+{
+    // convert 8 pixels
+    uint8x8x4_t     x;
+    uint16x8_t      y;
+    uint8x8_t       mr = vdup_n_u8(0xf8);
+    uint8x8_t       mg = vdup_n_u8(0xfc);
+    tb_byte_t*      e = d + ((count & ~7) << 1);
+    while (d < e)
+    {
+        // (r & 0xf8) << 8 | (g & 0xfc) << 3 | (b >> 3)
+        x = vld4_u8(s);
+        y = vorrq_u16(vshlq_n_u16(vmovl_u8(vand_u8(x.val[sl->r], mr)), 8), vshlq_n_u16(vmovl_u8(vand_u8(x.val[sl->g], mg)), 3));
+        y = vorrq_u16(y, vmovl_u8(vshr_n_u8(x.val[sl->b], 3)));
+        vst1q_u16((tb_uint16_t*)d, y);
+        s += 32;
+        d += 16;
+    }
+
+    // convert the left pixels
+    gb_pixmap_simd_convert_tail(d, dl, s, sl, count & 7);
+}
+static tb_void_t gb_pixmap_simd_rgb888_to_rgb32_neon(tb_byte_t* d, gb_pixmap_simd_layout_t const* dl, tb_byte_t const* s, gb_pixmap_simd_layout_t const* sl, tb_size_t count)
+{
+    // convert 16 pixels with the deinterleaved channels
+    uint8x16x3_t    x;
+    uint8x16x4_t    y;
+    tb_byte_t*      e = d + ((count & ~15) << 2);
+    while (d < e)
+    {
+        x = vld3q_u8(s);
+        y.val[dl->a] = vdupq_n_u8(0xff);
+        y.val[dl->r] = x.val[sl->r];
+        y.val[dl->g] = x.val[sl->g];
+        y.val[dl->b] = x.val[sl->b];
+        vst4q_u8(d, y);
+        s += 48;
+        d += 64;
+    }
+
+    // convert the left pixels
+    gb_pixmap_simd_convert_tail(d, dl, s, sl, count & 15);
+}
+static tb_void_t gb_pixmap_simd_rgb32_to_rgb888_neon(tb_byte_t* d, gb_pixmap_simd_layout_t const* dl, tb_byte_t const* s, gb_pixmap_simd_layout_t const* sl, tb_size_t count)
+{
+    // convert 16 pixels with the deinterleaved channels
+    uint8x16x4_t    x;
+    uint8x16x3_t    y;
+    tb_byte_t*      e = d + (count & ~15) * 3;
+    while (d < e)
+    {
+        x = vld4q_u8(s);
+        y.val[dl->r] = x.val[sl->r];
+        y.val[dl->g] = x.val[sl->g];
+        y.val[dl->b] = x.val[sl->b];
+        vst3q_u8(d, y);
+        s += 64;
+        d += 48;
+    }
+
+    // convert the left pixels
+    gb_pixmap_simd_convert_tail(d, dl, s, sl, count & 15);
+}
+static tb_void_t gb_pixmap_simd_reduce2x2_neon(tb_byte_t* d, tb_byte_t const* s0, tb_byte_t const* s1, tb_size_t count)
+{
+    // reduce 4 pixels from the even and odd pixels of the two rows
+    uint8x16_t  ae;
+    uint8x16_t  ao;
+    uint8x16_t  be;
+    uint8x16_t  bo;
+    uint16x8_t  l;
+    uint16x8_t  h;
+    uint32x4x2_t a;
+    uint32x4x2_t b;
+    tb_byte_t*  e = d + ((count & ~3) << 2);
+    while (d < e)
+    {
+        a   = vld2q_u32((uint32_t const*)s0);
+        b   = vld2q_u32((uint32_t const*)s1);
+        ae  = vreinterpretq_u8_u32(a.val[0]);
+        ao  = vreinterpretq_u8_u32(a.val[1]);
+        be  = vreinterpretq_u8_u32(b.val[0]);
+        bo  = vreinterpretq_u8_u32(b.val[1]);
+        l   = vaddq_u16(vaddl_u8(vget_low_u8(ae), vget_low_u8(ao)), vaddl_u8(vget_low_u8(be), vget_low_u8(bo)));
+        h   = vaddq_u16(vaddl_u8(vget_high_u8(ae), vget_high_u8(ao)), vaddl_u8(vget_high_u8(be), vget_high_u8(bo)));
+
+        // (sum + 2) / 4
+        vst1q_u8(d, vcombine_u8(vrshrn_n_u16(l, 2), vrshrn_n_u16(h, 2)));
+        s0 += 32;
+        s1 += 32;
+        d  += 16;
+    }
+
+    // reduce the left pixels
+    gb_pixmap_simd_reduce2x2_tail(d, s0, s1, count & 3);
+}
+#endif
+
+static tb_size_t gb_pixmap_simd(tb_noarg_t)
+{
+    // the detected simd, it's safe to detect it repeatly in the multi-threads
+    static tb_long_t s_simd = -1;
+    if (s_simd < 0)
+    {
+#if defined(GB_PIXMAP_SIMD_HAVE_X86)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) s_simd = GB_PIXMAP_SIMD_AVX2;
+        else if (__builtin_cpu_supports("sse2")) s_simd = GB_PIXMAP_SIMD_SSE2;
+        else s_simd = GB_PIXMAP_SIMD_NONE;
+#elif defined(GB_PIXMAP_SIMD_HAVE_NEON)
+        s_simd = GB_PIXMAP_SIMD_NEON;
+#else
+        s_simd = GB_PIXMAP_SIMD_NONE;
+#endif
+
+        // trace
+        tb_trace_d("simd: %s", gb_pixmap_simd_name());
+    }
+
+    // ok
+    return (tb_size_t)s_simd;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_char_t const* gb_pixmap_simd_name()
+{
+    // the names
+    static tb_char_t const* s_names[] = {tb_null, "sse2", "avx2", "neon"};
+
+    // the simd
+    tb_size_t simd = gb_pixmap_simd();
+    tb_assert_and_check_return_val(simd < tb_arrayn(s_names), tb_null);
+
+    // ok
+    return s_names[simd];
+}
+gb_pixmap_func_pixels_fill_t gb_pixmap_simd_pixels_fill(tb_size_t pixfmt)
+{
+    // only for little endian
+    tb_check_return_val(!GB_PIXFMT_BE(pixfmt), tb_null);
+
+    // done
+    gb_pixmap_func_pixels_fill_t pixels_fill = tb_null;
+    switch (GB_PIXFMT(pixfmt))
+    {
+    case GB_PIXFMT(GB_PIXFMT_ARGB8888):
+    case GB_PIXFMT(GB_PIXFMT_XRGB8888):
+    case GB_PIXFMT(GB_PIXFMT_RGBA8888):
+    case GB_PIXFMT(GB_PIXFMT_RGBX8888):
+    case GB_PIXFMT(GB_PIXFMT_PARGB8888):
+        {
+            switch (gb_pixmap_simd())
+            {
+#ifdef GB_PIXMAP_SIMD_HAVE_X86
+            case GB_PIXMAP_SIMD_AVX2: pixels_fill = gb_pixmap_simd_rgb32_pixels_fill_avx2; break;
+            case GB_PIXMAP_SIMD_SSE2: pixels_fill = gb_pixmap_simd_rgb32_pixels_fill_sse2; break;
+#endif
+#ifdef GB_PIXMAP_SIMD_HAVE_NEON
+            case GB_PIXMAP_SIMD_NEON: pixels_fill = gb_pixmap_simd_rgb32_pixels_fill_neon; break;
+#endif
+            default: break;
+            }
+        }
+        break;
+    case GB_PIXFMT(GB_PIXFMT_RGB565):
+        {
+            switch (gb_pixmap_simd())
+            {
+#ifdef GB_PIXMAP_SIMD_HAVE_X86
+            case GB_PIXMAP_SIMD_AVX2: pixels_fill = gb_pixmap_simd_rgb565_pixels_fill_avx2; break;
+            case GB_PIXMAP_SIMD_SSE2: pixels_fill = gb_pixmap_simd_rgb565_pixels_fill_sse2; break;
+#endif
+#ifdef GB_PIXMAP_SIMD_HAVE_NEON
+            case GB_PIXMAP_SIMD_NEON: pixels_fill = gb_pixmap_simd_rgb565_pixels_fill_neon; break;
+#endif
+            default: break;
+            }
+        }
+        break;
+    default:
+        break;
+    }
+
+    // ok
+    return pixels_fill;
+}
+tb_bool_t gb_pixmap_simd_convert(tb_size_t dst_fmt, tb_pointer_t dst, tb_size_t src_fmt, tb_cpointer_t src, tb_size_t count)
+{
+    // check
+    tb_assert_and_check_return_val(dst && src, tb_false);
+
+#if defined(GB_PIXMAP_SIMD_HAVE_X86) || defined(GB_PIXMAP_SIMD_HAVE_NEON)
+
+    // the converters indexed by dst_kind * 3 + src_kind, only the rgb32 <=> rgb32, rgb565, rgb888 are accelerated
+#   ifdef GB_PIXMAP_SIMD_HAVE_X86
+    static gb_pixmap_simd_func_convert_t const s_converts_sse2[] = 
+    {
+        gb_pixmap_simd_rgb32_convert_sse2,  gb_pixmap_simd_rgb565_to_rgb32_sse2,    tb_null
+    ,   gb_pixmap_simd_rgb32_to_rgb565_sse2, tb_null,                               tb_null
+    ,   tb_null,                            tb_null,                                tb_null
+    };
+    static gb_pixmap_simd_func_convert_t const s_converts_avx2[] = 
+    {
+        gb_pixmap_simd_rgb32_convert_avx2,  gb_pixmap_simd_rgb565_to_rgb32_avx2,    gb_pixmap_simd_rgb888_to_rgb32_avx2
+    ,   gb_pixmap_simd_rgb32_to_rgb565_avx2, tb_null,                               tb_null
+    ,   gb_pixmap_simd_rgb32_to_rgb888_avx2, tb_null,                               tb_null
+    };
+#   endif
+#   ifdef GB_PIXMAP_SIMD_HAVE_NEON
+    static gb_pixmap_simd_func_convert_t const s_converts_neon[] = 
+    {
+        gb_pixmap_simd_rgb32_convert_neon,  gb_pixmap_simd_rgb565_to_rgb32_neon,    gb_pixmap_simd_rgb888_to_rgb32_neon
+    ,   gb_pixmap_simd_rgb32_to_rgb565_neon, tb_null,                               tb_null
+    ,   gb_pixmap_simd_rgb32_to_rgb888_neon, tb_null,                               tb_null
+    };
+#   endif
+
+    // the layouts
+    gb_pixmap_simd_layout_t dl;
+    gb_pixmap_simd_layout_t sl;
+    tb_check_return_val(gb_pixmap_simd_layout(dst_fmt, &dl) && gb_pixmap_simd_layout(src_fmt, &sl), tb_false);
+
+    // the converter
+    gb_pixmap_simd_func_convert_t convert = tb_null;
+    switch (gb_pixmap_simd())
+    {
+#   ifdef GB_PIXMAP_SIMD_HAVE_X86
+    case GB_PIXMAP_SIMD_AVX2: convert = s_converts_avx2[dl.kind * 3 + sl.kind]; break;
+    case GB_PIXMAP_SIMD_SSE2: convert = s_converts_sse2[dl.kind * 3 + sl.kind]; break;
+#   endif
+#   ifdef GB_PIXMAP_SIMD_HAVE_NEON
+    case GB_PIXMAP_SIMD_NEON: convert = s_converts_neon[dl.kind * 3 + sl.kind]; break;
+#   endif
+    default: break;
+    }
+    tb_check_return_val(convert, tb_false);
+
+    // convert it
+    convert((tb_byte_t*)dst, &dl, (tb_byte_t const*)src, &sl, count);
+
+    // ok
+    return tb_true;
+#else
+    // no accelerated converter
+    tb_used(dst_fmt);
+    tb_used(src_fmt);
+    tb_used(count);
+    return tb_false;
+#endif
+}
+tb_bool_t gb_pixmap_simd_reduce2x2(tb_pointer_t dst, tb_cpointer_t src0, tb_cpointer_t src1, tb_size_t count)
+{
+    // check
+    tb_assert_and_check_return_val(dst && src0 && src1, tb_false);
+
+    // reduce it
+    switch (gb_pixmap_simd())
+    {
+#ifdef GB_PIXMAP_SIMD_HAVE_X86
+    case GB_PIXMAP_SIMD_AVX2:
+    case GB_PIXMAP_SIMD_SSE2: 
+        gb_pixmap_simd_reduce2x2_sse2((tb_byte_t*)dst, (tb_byte_t const*)src0, (tb_byte_t const*)src1, count); 
+        return tb_true;
+#endif
+#ifdef GB_PIXMAP_SIMD_HAVE_NEON
+    case GB_PIXMAP_SIMD_NEON: 
+        gb_pixmap_simd_reduce2x2_neon((tb_byte_t*)dst, (tb_byte_t const*)src0, (tb_byte_t const*)src1, count); 
+        return tb_true;
+#endif
+    default: 
+        break;
+    }
+
+    // no accelerated reducer
+    tb_used(count);
+    return tb_false;
+}
@@ -0,0 +1,92 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        pixmap_simd.h
+ * @ingroup     core
+ *
+ */
+#ifndef GB_CORE_IMPL_PIXMAP_SIMD_H
+#define GB_CORE_IMPL_PIXMAP_SIMD_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../pixmap.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* the simd name of the current cpu
+ *
+ * @return                  "avx2", "sse2", "neon" or tb_null if not supported
+ */
+tb_char_t const*            gb_pixmap_simd_name(tb_noarg_t);
+
+/* the accelerated alpha fill func for the given pixel format
+ *
+ * the simd instruction set is detected at the first call,
+ * the blended channel is computed as d + (s - d) * a / 256 (32-bits) or d + (s - d) * (a >> 3) / 32 (rgb565)
+ *
+ * @param pixfmt            the pixel format, only for little endian
+ *
+ * @return                  the pixels fill func or tb_null if no accelerated func for it
+ */
+gb_pixmap_func_pixels_fill_t gb_pixmap_simd_pixels_fill(tb_size_t pixfmt);
+
+/* convert the pixels with the accelerated converter
+ *
+ * only the conversions between the 32-bits formats and from or to rgb565 (little endian) and rgb888 are accelerated,
+ * the result is the same as converting them with the color of the generic pixmaps
+ *
+ * @param dst_fmt           the pixel format of the destination
+ * @param dst               the destination pixels
+ * @param src_fmt           the pixel format of the source
+ * @param src               the source pixels
+ * @param count             the pixel count
+ *
+ * @return                  tb_true if converted, tb_false if no accelerated converter for them
+ */
+tb_bool_t                   gb_pixmap_simd_convert(tb_size_t dst_fmt, tb_pointer_t dst, tb_size_t src_fmt, tb_cpointer_t src, tb_size_t count);
+
+/* reduce the 32-bits pixels of the two rows with the 2x2 box filter
+ *
+ * each byte channel is averaged independently: d[i] = (s0[2i] + s0[2i + 1] + s1[2i] + s1[2i + 1] + 2) / 4,
+ * so it can be used for all opaque 32-bits formats
+ *
+ * @param dst               the destination pixels
+ * @param src0              the pixels of the first source row, 2 * count pixels
+ * @param src1              the pixels of the second source row, 2 * count pixels
+ * @param count             the destination pixel count
+ *
+ * @return                  tb_true if reduced, tb_false if no accelerated reducer
+ */
+tb_bool_t                   gb_pixmap_simd_reduce2x2(tb_pointer_t dst, tb_cpointer_t src0, tb_cpointer_t src1, tb_size_t count);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+#endif
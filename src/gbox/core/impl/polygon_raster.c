@@ -43,12 +43,19 @@
 #   define GB_POLYGON_RASTER_EDGES_GROW     (2048)
 #endif
 
+// the polygon coverage cells grow
+#ifdef __gb_small__
+#   define GB_POLYGON_RASTER_CELLS_GROW     (256)
+#else
+#   define GB_POLYGON_RASTER_CELLS_GROW     (512)
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
 
-// the polygon raster edge type
-typedef struct __gb_polygon_raster_edge_t
+// the polygon raster compact edge type for the small polygon, the edge pool size must be less than 65535
+typedef struct __gb_polygon_raster_compact_edge_t
 {
     /* the winding for rule
      *
@@ -77,7 +84,58 @@ typedef struct __gb_polygon_raster_edge_t
     // the slope of the edge: dx / dy 
     tb_fixed_t      slope;
 
-}gb_polygon_raster_edge_t, *gb_polygon_raster_edge_ref_t;
+}gb_polygon_raster_compact_edge_t, *gb_polygon_raster_compact_edge_ref_t;
+
+// the polygon raster large edge type for the huge polygon with more than 65535 edges
+typedef struct __gb_polygon_raster_large_edge_t
+{
+    // the winding for rule, 1: top => bottom, -1: bottom => top
+    tb_int8_t       winding     : 2;
+
+    // the index of next edge at the edge pool 
+    tb_uint32_t     next;
+
+    // the bottom y-coordinate
+    tb_int32_t      y_bottom;
+
+    // the x-coordinate of the active edge
+    tb_fixed_t      x;
+
+    // the slope of the edge: dx / dy 
+    tb_fixed_t      slope;
+
+}gb_polygon_raster_large_edge_t, *gb_polygon_raster_large_edge_ref_t;
+
+/* the polygon raster coverage edge type
+ *
+ * the edge is kept at the sub-pixel precision: 
+ * [y_top, y_bottom) will be scanned by the pixel rows and the area on the right-hand 
+ * of the edge segment in each row will be accumulated to the coverage cells
+ */
+typedef struct __gb_polygon_raster_coverage_edge_t
+{
+    // the winding, 1: top => bottom, -1: bottom => top
+    tb_int8_t       winding;
+
+    // the index of next edge at the edge pool 
+    tb_uint32_t     next;
+
+    // the x-coordinate at the top of this edge
+    tb_fixed_t      x;
+
+    // the x-coordinate at the bottom of this edge
+    tb_fixed_t      x_bottom;
+
+    // the top y-coordinate
+    tb_fixed_t      y_top;
+
+    // the bottom y-coordinate
+    tb_fixed_t      y_bottom;
+
+    // the slope of the edge: dx / dy, maybe very large for the almost horizontal edge
+    tb_hong_t       slope;
+
+}gb_polygon_raster_coverage_edge_t, *gb_polygon_raster_coverage_edge_ref_t;
 
 /* the polygon raster type
  *
@@ -156,17 +214,20 @@ typedef struct __gb_polygon_raster_edge_t
  */
 typedef struct __gb_polygon_raster_impl_t
 {
-    // the edge pool, tail: 0, index: > 0
-    gb_polygon_raster_edge_ref_t    edge_pool;
+    // the edge layout
+    tb_size_t                       layout;
+
+    // the edge pool of the compact or large edges, tail: 0, index: > 0
+    tb_pointer_t                    edge_pool;
 
     // the edge pool size
     tb_size_t                       edge_pool_size;
    
-    // the edge pool maxn
+    // the edge pool maxn (bytes)
     tb_size_t                       edge_pool_maxn;
     
-    // the edge table
-    tb_uint16_t*                    edge_table;
+    // the edge table of the 16-bit or 32-bit edge indices
+    tb_pointer_t                    edge_table;
 
     // the edge table base for the y-coordinate
     tb_long_t                       edge_table_base;
@@ -175,7 +236,7 @@ typedef struct __gb_polygon_raster_impl_t
     tb_size_t                       edge_table_maxn;
 
     // the active edges
-    tb_uint16_t                     active_edges;
+    tb_uint32_t                     active_edges;
 
     // the top of the polygon bounds
     tb_long_t                       top;
@@ -183,8 +244,61 @@ typedef struct __gb_polygon_raster_impl_t
     // the bottom of the polygon bounds
     tb_long_t                       bottom;
 
+    // the coverage edge pool, tail: 0, index: > 0
+    gb_polygon_raster_coverage_edge_ref_t coverage_edge_pool;
+
+    // the coverage edge pool size
+    tb_size_t                       coverage_edge_pool_size;
+
+    // the coverage edge pool maxn
+    tb_size_t                       coverage_edge_pool_maxn;
+
+    /* the coverage cells of the current scan line
+     *
+     * cells[x] = coverage(x) - coverage(x - 1), 1.0: TB_FIXED_ONE
+     */
+    tb_int32_t*                     coverage_cells;
+
+    // the coverages of the current scan line
+    tb_byte_t*                      coverages;
+
+    // the coverage cells maxn
+    tb_size_t                       coverage_cells_maxn;
+
+    // the left of the polygon bounds for the coverage cells
+    tb_long_t                       left;
+
+    // the right of the polygon bounds for the coverage cells
+    tb_long_t                       right;
+
+    // the top of the band, only scan the lines at [band_top, band_bottom) if band_bottom > band_top
+    tb_long_t                       band_top;
+
+    // the bottom of the band
+    tb_long_t                       band_bottom;
+
 }gb_polygon_raster_impl_t;
 
+// the polygon raster spans type
+typedef struct __gb_polygon_raster_spans_t
+{
+    // the spans
+    gb_polygon_raster_span_ref_t    data;
+
+    // the spans count
+    tb_size_t                       size;
+
+    // the spans maxn
+    tb_size_t                       maxn;
+
+    // the spans func
+    gb_polygon_raster_spans_func_t  func;
+
+    // the private data
+    tb_cpointer_t                   priv;
+
+}gb_polygon_raster_spans_t, *gb_polygon_raster_spans_ref_t;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
@@ -194,7 +308,11 @@ static tb_bool_t gb_polygon_raster_edge_pool_init(gb_polygon_raster_impl_t* impl
     tb_assert(impl);
 
     // init the edge pool
-    if (!impl->edge_pool) impl->edge_pool = tb_nalloc_type(GB_POLYGON_RASTER_EDGES_GROW, gb_polygon_raster_edge_t);
+    if (!impl->edge_pool) 
+    {
+        impl->edge_pool_maxn = GB_POLYGON_RASTER_EDGES_GROW * sizeof(gb_polygon_raster_compact_edge_t);
+        impl->edge_pool = tb_malloc(impl->edge_pool_maxn);
+    }
     tb_assert_and_check_return_val(impl->edge_pool, tb_false);
 
     // init the edge pool size
@@ -212,46 +330,26 @@ static tb_void_t gb_polygon_raster_edge_pool_exit(gb_polygon_raster_impl_t* impl
     if (impl->edge_pool) tb_free(impl->edge_pool);
     impl->edge_pool = tb_null;
 }
-static tb_uint16_t gb_polygon_raster_edge_pool_aloc(gb_polygon_raster_impl_t* impl)
-{
-    // check
-    tb_assert(impl && impl->edge_pool);
-
-    // the new index
-    tb_size_t index = ++impl->edge_pool_size;
-    tb_assert(index < TB_MAXU16);
-
-    // grow the edge pool
-    if (index >= impl->edge_pool_maxn)
-    {
-        impl->edge_pool_maxn = index + GB_POLYGON_RASTER_EDGES_GROW;
-        impl->edge_pool = tb_ralloc_type(impl->edge_pool, impl->edge_pool_maxn, gb_polygon_raster_edge_t);
-        tb_assert_and_check_return_val(impl->edge_pool, 0);
-    }
-
-    // make a new edge from the edge pool
-    return (tb_uint16_t)index;
-}
-static tb_bool_t gb_polygon_raster_edge_table_init(gb_polygon_raster_impl_t* impl, tb_long_t table_base, tb_size_t table_size)
+static tb_bool_t gb_polygon_raster_edge_table_init(gb_polygon_raster_impl_t* impl, tb_long_t table_base, tb_size_t table_size, tb_size_t index_size)
 {
     // check
-    tb_assert(impl && table_size);
+    tb_assert(impl && table_size && index_size <= sizeof(tb_uint32_t));
 
-    // init the edge table
+    // init the edge table, the space is enough for the 16-bit and 32-bit edge indices
     if (!impl->edge_table)
     {
         impl->edge_table_maxn = table_size;
-        impl->edge_table = tb_nalloc_type(impl->edge_table_maxn, tb_uint16_t);
+        impl->edge_table = tb_nalloc_type(impl->edge_table_maxn, tb_uint32_t);
     }
     else if (table_size > impl->edge_table_maxn)
     {
         impl->edge_table_maxn = table_size;
-        impl->edge_table = tb_ralloc_type(impl->edge_table, impl->edge_table_maxn, tb_uint16_t);
+        impl->edge_table = tb_ralloc_type(impl->edge_table, impl->edge_table_maxn, tb_uint32_t);
     }
-    tb_assert_and_check_return_val(impl->edge_table && table_size <= TB_MAXU16, tb_false);
+    tb_assert_and_check_return_val(impl->edge_table, tb_false);
 
     // clear the edge table
-    tb_memset(impl->edge_table, 0, table_size * sizeof(tb_uint16_t));
+    tb_memset(impl->edge_table, 0, table_size * index_size);
 
     // init the edge table base
     impl->edge_table_base = table_base;
@@ -268,29 +366,190 @@ static tb_void_t gb_polygon_raster_edge_table_exit(gb_polygon_raster_impl_t* imp
     if (impl->edge_table) tb_free(impl->edge_table);
     impl->edge_table = tb_null;
 }
-static tb_bool_t gb_polygon_raster_edge_table_make(gb_polygon_raster_impl_t* impl, gb_polygon_ref_t polygon, gb_rect_ref_t bounds)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * the compact layout
+ */
+#define gb_polygon_raster_edge_t            gb_polygon_raster_compact_edge_t
+#define gb_polygon_raster_edge_ref_t        gb_polygon_raster_compact_edge_ref_t
+#define gb_polygon_raster_index_t           tb_uint16_t
+#define gb_polygon_raster_coor_t            tb_int16_t
+#define GB_POLYGON_RASTER_SCAN(name)        gb_polygon_raster_compact_##name
+#include "polygon_raster_scan.h"
+#undef gb_polygon_raster_edge_t
+#undef gb_polygon_raster_edge_ref_t
+#undef gb_polygon_raster_index_t
+#undef gb_polygon_raster_coor_t
+#undef GB_POLYGON_RASTER_SCAN
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * the large layout
+ */
+#define gb_polygon_raster_edge_t            gb_polygon_raster_large_edge_t
+#define gb_polygon_raster_edge_ref_t        gb_polygon_raster_large_edge_ref_t
+#define gb_polygon_raster_index_t           tb_uint32_t
+#define gb_polygon_raster_coor_t            tb_int32_t
+#define GB_POLYGON_RASTER_SCAN(name)        gb_polygon_raster_large_##name
+#include "polygon_raster_scan.h"
+#undef gb_polygon_raster_edge_t
+#undef gb_polygon_raster_edge_ref_t
+#undef gb_polygon_raster_index_t
+#undef gb_polygon_raster_coor_t
+#undef GB_POLYGON_RASTER_SCAN
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_bool_t gb_polygon_raster_need_large(gb_polygon_raster_impl_t* impl, gb_polygon_ref_t polygon, gb_rect_ref_t bounds)
+{
+    // check
+    tb_assert(impl && polygon && polygon->counts && bounds);
+
+    // force to use the large layout?
+    tb_check_return_val(impl->layout != GB_POLYGON_RASTER_LAYOUT_LARGE, tb_true);
+
+    // the y-coordinates overflow for the compact edge?
+    if (gb_round(bounds->y) <= TB_MINS16 || gb_round(bounds->y + bounds->h) >= TB_MAXS16) return tb_true;
+
+    /* the edges count overflow for the compact edge?
+     *
+     * the edges count of each contour is not greater than its points count
+     */
+    tb_size_t       edges   = 0;
+    tb_uint32_t*    counts  = polygon->counts;
+    while (*counts) 
+    {
+        edges += *counts++;
+        if (edges >= TB_MAXU16) return tb_true;
+    }
+
+    // ok, the compact layout is enough
+    return tb_false;
+}
+static tb_bool_t gb_polygon_raster_coverage_edge_pool_init(gb_polygon_raster_impl_t* impl)
+{
+    // check
+    tb_assert(impl);
+
+    // init the coverage edge pool
+    if (!impl->coverage_edge_pool) 
+    {
+        impl->coverage_edge_pool_maxn = GB_POLYGON_RASTER_EDGES_GROW;
+        impl->coverage_edge_pool = tb_nalloc_type(impl->coverage_edge_pool_maxn, gb_polygon_raster_coverage_edge_t);
+    }
+    tb_assert_and_check_return_val(impl->coverage_edge_pool, tb_false);
+
+    // init the coverage edge pool size
+    impl->coverage_edge_pool_size = 0;
+
+    // ok
+    return tb_true;
+}
+static tb_void_t gb_polygon_raster_coverage_edge_pool_exit(gb_polygon_raster_impl_t* impl)
+{
+    // check
+    tb_assert(impl);
+
+    // exit the coverage edge pool
+    if (impl->coverage_edge_pool) tb_free(impl->coverage_edge_pool);
+    impl->coverage_edge_pool = tb_null;
+}
+static tb_uint32_t gb_polygon_raster_coverage_edge_pool_aloc(gb_polygon_raster_impl_t* impl)
+{
+    // check
+    tb_assert(impl && impl->coverage_edge_pool);
+
+    // the new index
+    tb_size_t index = ++impl->coverage_edge_pool_size;
+    tb_assert(index < TB_MAXU32);
+
+    // grow the coverage edge pool
+    if (index >= impl->coverage_edge_pool_maxn)
+    {
+        impl->coverage_edge_pool_maxn = index + GB_POLYGON_RASTER_EDGES_GROW;
+        impl->coverage_edge_pool = tb_ralloc_type(impl->coverage_edge_pool, impl->coverage_edge_pool_maxn, gb_polygon_raster_coverage_edge_t);
+        tb_assert_and_check_return_val(impl->coverage_edge_pool, 0);
+    }
+
+    // make a new edge from the coverage edge pool
+    return (tb_uint32_t)index;
+}
+static tb_bool_t gb_polygon_raster_coverage_cells_init(gb_polygon_raster_impl_t* impl, tb_size_t width)
+{
+    // check
+    tb_assert(impl && width);
+
+    // the cells count, patch two cells for the right-hand of the last pixel
+    tb_size_t count = width + 2;
+
+    // grow the coverage cells and coverages
+    if (count > impl->coverage_cells_maxn)
+    {
+        // exit the old cells and coverages
+        if (impl->coverage_cells) tb_free(impl->coverage_cells);
+        if (impl->coverages) tb_free(impl->coverages);
+
+        // make the new cells and coverages
+        impl->coverage_cells_maxn   = tb_align(count, GB_POLYGON_RASTER_CELLS_GROW);
+        impl->coverage_cells        = tb_nalloc0_type(impl->coverage_cells_maxn, tb_int32_t);
+        impl->coverages             = tb_nalloc_type(impl->coverage_cells_maxn, tb_byte_t);
+    }
+    tb_assert_and_check_return_val(impl->coverage_cells && impl->coverages, tb_false);
+
+    // ok, the cells have been cleared after scanning the last line
+    return tb_true;
+}
+static tb_void_t gb_polygon_raster_coverage_cells_exit(gb_polygon_raster_impl_t* impl)
+{
+    // check
+    tb_assert(impl);
+
+    // exit the coverage cells
+    if (impl->coverage_cells) tb_free(impl->coverage_cells);
+    impl->coverage_cells = tb_null;
+
+    // exit the coverages
+    if (impl->coverages) tb_free(impl->coverages);
+    impl->coverages = tb_null;
+    impl->coverage_cells_maxn = 0;
+}
+static __tb_inline__ tb_bool_t gb_polygon_raster_coverage_edge_in_band(gb_polygon_raster_impl_t* impl, tb_fixed_t yb, tb_fixed_t ye)
+{
+    // no band? 
+    tb_check_return_val(impl->band_bottom > impl->band_top, tb_true);
+
+    // sort the y-coordinates
+    if (yb > ye) tb_swap(tb_fixed_t, yb, ye);
+
+    // the edge covers the lines: [floor(yb), ceil(ye))
+    return tb_fixed_ceil(ye) > impl->band_top && tb_fixed_floor(yb) < impl->band_bottom;
+}
+static tb_bool_t gb_polygon_raster_coverage_edge_table_make(gb_polygon_raster_impl_t* impl, gb_polygon_ref_t polygon, gb_rect_ref_t bounds)
 {
     // empty polygon?
     tb_check_return_val(!gb_near0(bounds->w) && !gb_near0(bounds->h), tb_false);
 
-    // init the edge pool
-    if (!gb_polygon_raster_edge_pool_init(impl)) return tb_false; 
+    // init the coverage edge pool
+    if (!gb_polygon_raster_coverage_edge_pool_init(impl)) return tb_false; 
 
     // init the edge table
-    if (!gb_polygon_raster_edge_table_init(impl, gb_round(bounds->y), gb_round(bounds->h) + 1)) return tb_false;
+    tb_long_t table_base = gb_floor(bounds->y);
+    if (!gb_polygon_raster_edge_table_init(impl, table_base, gb_ceil(bounds->y + bounds->h) - table_base + 1, sizeof(tb_uint32_t))) return tb_false;
  
-    // make the edge table
-    gb_point_t          pb;
+    // make the edge table, the previous point is only used after the first point of each contour
+    gb_point_t          pb          = *polygon->points;
     gb_point_t          pe;
     tb_bool_t           first       = tb_true;
-    tb_long_t           top         = 0;
-    tb_long_t           bottom      = 0;
-    tb_uint16_t         index       = 0;
+    tb_fixed_t          top         = 0;
+    tb_fixed_t          bottom      = 0;
+    tb_fixed_t          left        = 0;
+    tb_fixed_t          right       = 0;
+    tb_uint32_t         index       = 0;
     tb_long_t           table_index = 0;
     gb_point_ref_t      points      = polygon->points;
-    tb_uint16_t*        counts      = polygon->counts;
-    tb_uint16_t         count       = *counts++;
-    tb_uint16_t*        edge_table  = impl->edge_table;
+    tb_uint32_t*        counts      = polygon->counts;
+    tb_uint32_t         count       = *counts++;
+    tb_uint32_t*        edge_table  = (tb_uint32_t*)impl->edge_table;
     while (index < count)
     {
         // the point
@@ -299,29 +558,21 @@ static tb_bool_t gb_polygon_raster_edge_table_make(gb_polygon_raster_impl_t* imp
         // exists edge?
         if (index)
         {
-            // get the integer y-coordinates
-            tb_long_t iyb = gb_round(pb.y);
-            tb_long_t iye = gb_round(pe.y);
-
-            // not horizontal edge?
-            if (iyb != iye)
+            // get the fixed-point coordinates
+            tb_fixed_t xb = gb_float_to_fixed(pb.x);
+            tb_fixed_t yb = gb_float_to_fixed(pb.y);
+            tb_fixed_t xe = gb_float_to_fixed(pe.x);
+            tb_fixed_t ye = gb_float_to_fixed(pe.y);
+
+            // not horizontal edge and intersects the band? the horizontal edge does not cover any area
+            if (yb != ye && gb_polygon_raster_coverage_edge_in_band(impl, yb, ye))
             {
-                // get the fixed-point coordinates
-                tb_fixed6_t xb = gb_float_to_fixed6(pb.x);
-                tb_fixed6_t yb = gb_float_to_fixed6(pb.y);
-                tb_fixed6_t xe = gb_float_to_fixed6(pe.x);
-                tb_fixed6_t ye = gb_float_to_fixed6(pe.y);
-
-                // compute the delta coordinates
-                tb_fixed6_t dx = xe - xb;
-                tb_fixed6_t dy = ye - yb;
-
-                // make a new edge from the edge pool
-                tb_uint16_t edge_index = gb_polygon_raster_edge_pool_aloc(impl);
+                // make a new edge from the coverage edge pool
+                tb_uint32_t edge_index = gb_polygon_raster_coverage_edge_pool_aloc(impl);
                 tb_assert(edge_index);
 
                 // the edge
-                gb_polygon_raster_edge_ref_t edge = impl->edge_pool + edge_index;
+                gb_polygon_raster_coverage_edge_ref_t edge = impl->coverage_edge_pool + edge_index;
 
                 // init the winding
                 edge->winding = 1;
@@ -330,54 +581,50 @@ static tb_bool_t gb_polygon_raster_edge_table_make(gb_polygon_raster_impl_t* imp
                 if (yb > ye)
                 {
                     // reverse the edge points
-                    tb_swap(tb_fixed6_t, xb, xe);
-                    tb_swap(tb_fixed6_t, yb, ye);
-                    tb_swap(tb_long_t, iyb, iye);
+                    tb_swap(tb_fixed_t, xb, xe);
+                    tb_swap(tb_fixed_t, yb, ye);
 
                     // reverse the winding
                     edge->winding = -1;
                 }
 
-                // compute the accurate bounds of the y-coordinate
+                // compute the accurate bounds 
                 if (first)
                 {
-                    top     = iyb;
-                    bottom  = iye;
+                    top     = yb;
+                    bottom  = ye;
+                    left    = tb_min(xb, xe);
+                    right   = tb_max(xb, xe);
                     first   = tb_false;
                 }
                 else
                 {
-                    if (iyb < top)    top = iyb;
-                    if (iye > bottom) bottom = iye;
+                    if (yb < top)       top = yb;
+                    if (ye > bottom)    bottom = ye;
+                    if (xb < left)      left = xb;
+                    if (xe < left)      left = xe;
+                    if (xb > right)     right = xb;
+                    if (xe > right)     right = xe;
                 }
 
-                // check
-                tb_assert(iyb < iye);
+                // init the edge
+                edge->x         = xb;
+                edge->x_bottom  = xe;
+                edge->y_top     = yb;
+                edge->y_bottom  = ye;
+                edge->slope     = (((tb_hong_t)(xe - xb)) << 16) / (ye - yb);
 
-                // compute the slope 
-                edge->slope = tb_fixed6_div(dx, dy);
-
-                /* compute the more accurate start x-coordinate
+                /* the table index, the edge starts at the top of the band if it starts above the band
                  *
-                 * xb + (iyb - yb + 0.5) * dx / dy
-                 * => xb + ((0.5 - yb) % 1) * dx / dy
+                 * the x-coordinates of the edge segment at each line are computed from the top of this edge,
+                 * so the band will be scanned exactly the same as the whole polygon
                  */
-                edge->x = tb_fixed6_to_fixed(xb) + ((edge->slope * ((TB_FIXED6_HALF - yb) & 63)) >> 6);
-
-                // init bottom y-coordinate
-                edge->y_bottom = (tb_int16_t)(iye - 1);
-                tb_assert(iye - 1 > TB_MINS16 && iye - 1 <= TB_MAXS16);
-
-                // the table index
-                table_index = iyb - impl->edge_table_base;
+                table_index = tb_fixed_floor(yb);
+                if (impl->band_bottom > impl->band_top && table_index < impl->band_top) table_index = impl->band_top;
+                table_index -= impl->edge_table_base;
                 tb_assert(table_index >= 0 && table_index < impl->edge_table_maxn);
                 
-                /* insert edge to the head of the edge table
-                 *
-                 * table[index]: => edge => edge => .. => 0
-                 *              |
-                 *            insert
-                 */
+                // insert edge to the head of the edge table
                 edge->next = edge_table[table_index];
                 edge_table[table_index] = edge_index;
             }
@@ -398,598 +645,275 @@ static tb_bool_t gb_polygon_raster_edge_table_make(gb_polygon_raster_impl_t* imp
         }
     }
 
-    // update top and bottom of the polygon
-    impl->top     = top;
-    impl->bottom  = bottom;
-
-    // ok
-    return tb_true;
-}
-static tb_void_t gb_polygon_raster_active_scan_line_convex(gb_polygon_raster_impl_t* impl, tb_long_t y, gb_polygon_raster_func_t func, tb_cpointer_t priv)
-{
-    // check
-    tb_assert(impl && impl->edge_pool && func);
+    // no edges?
+    tb_check_return_val(!first, tb_false);
 
-    // the edge index
-    tb_uint16_t index = impl->active_edges; 
-    tb_check_return(index);
+    // update the bounds of the polygon
+    impl->top     = tb_fixed_floor(top);
+    impl->bottom  = tb_fixed_ceil(bottom);
 
-    // the edge
-    gb_polygon_raster_edge_ref_t edge = impl->edge_pool + index; 
-
-    // the next edge index
-    tb_uint16_t index_next = edge->next; 
-    tb_check_return(index_next);
-
-    // the next edge
-    gb_polygon_raster_edge_ref_t edge_next = impl->edge_pool + index_next; 
-
-    // check
-    tb_assert(edge->x < edge_next->x || tb_fixed_abs(edge->x - edge_next->x) <= TB_FIXED_HALF);
-
-    // trace
-    tb_trace_d("y: %ld, %{fixed} => %{fixed}", y, edge->x, edge_next->x);
+    // clip top and bottom of the polygon by the band
+    if (impl->band_bottom > impl->band_top)
+    {
+        if (impl->top < impl->band_top) impl->top = impl->band_top;
+        if (impl->bottom > impl->band_bottom) impl->bottom = impl->band_bottom;
+    }
 
-    // init the end y-coordinate for the only one line
-    tb_long_t ye = y + 1;
+    // clip top and bottom of the polygon by the lines of the bounds
+    if (impl->top < table_base) impl->top = table_base;
+    if (impl->bottom > gb_ceil(bounds->y + bounds->h)) impl->bottom = gb_ceil(bounds->y + bounds->h);
+    tb_check_return_val(impl->top < impl->bottom, tb_false);
+    impl->left    = tb_fixed_floor(left);
+    impl->right   = tb_fixed_ceil(right);
 
-    /* scan rect region? may be faster
+    // init the coverage cells
+    return gb_polygon_raster_coverage_cells_init(impl, impl->right - impl->left + 1);
+}
+static __tb_inline__ tb_fixed_t gb_polygon_raster_coverage_integral(tb_fixed_t v)
+{
+    /* the integral of clamp(t, 0, 1) at (-oo, v]
      *
-     * |    | 
-     * |    |
-     * |    |
+     * 0:           v <= 0
+     * v * v / 2:   0 < v < 1
+     * v - 1 / 2:   v >= 1
      */
-    if (tb_fixed_abs(edge->slope) <= TB_FIXED_NEAR0 && tb_fixed_abs(edge_next->slope) <= TB_FIXED_NEAR0)        
-    {
-        // get the min and max edge for the y-bottom
-        gb_polygon_raster_edge_ref_t    edge_min    = edge; 
-        gb_polygon_raster_edge_ref_t    edge_max    = edge_next; 
-        tb_uint16_t                     index_max   = index_next;
-        if (edge_min->y_bottom > edge_max->y_bottom)
-        {
-            edge_min    = edge_next; 
-            edge_max    = edge; 
-            index_max   = index;
-        }
-
-        // compute the ye
-        ye = edge_min->y_bottom + 1;
-
-        // clear the active edges, only two edges
-        impl->active_edges = 0;
-
-        // re-insert the max edge to the edge table using the new top-y coordinate
-        if (ye < edge_max->y_bottom)
-        {
-            // check
-            tb_assert(ye >= impl->edge_table_base && ye - impl->edge_table_base < impl->edge_table_maxn);
-
-            /* re-insert to the edge table using the new top-y coordinate
-             *
-             * table[index]: => edge => edge => .. => 0
-             *              |
-             *            insert
-             */
-            edge_max->next = impl->edge_table[ye - impl->edge_table_base];
-            impl->edge_table[ye - impl->edge_table_base] = index_max;
-        }
-    }
-
-    // done it
-    func(tb_fixed_round(edge->x), tb_fixed_round(edge_next->x), y, ye, priv);
+    if (v <= 0) return 0;
+    else if (v >= TB_FIXED_ONE) return v - TB_FIXED_HALF;
+    return (tb_fixed_t)(((tb_hong_t)v * v) >> 17);
 }
-static tb_void_t gb_polygon_raster_active_scan_line_concave(gb_polygon_raster_impl_t* impl, tb_long_t y, tb_size_t rule, gb_polygon_raster_func_t func, tb_cpointer_t priv)
+static tb_void_t gb_polygon_raster_coverage_accumulate(gb_polygon_raster_impl_t* impl, tb_fixed_t xb, tb_fixed_t xe, tb_fixed_t delta, tb_long_t* pmin, tb_long_t* pmax)
 {
     // check
-    tb_assert(impl && impl->edge_pool && func);
+    tb_assert(impl && impl->coverage_cells && pmin && pmax);
 
-    // done
-    tb_long_t                       done            = 0;
-    tb_long_t                       winding         = 0; 
-    tb_uint16_t                     index           = impl->active_edges; 
-    tb_uint16_t                     index_next      = 0; 
-    gb_polygon_raster_edge_ref_t    edge            = tb_null; 
-    gb_polygon_raster_edge_ref_t    edge_next       = tb_null; 
-    gb_polygon_raster_edge_ref_t    edge_cache      = tb_null; 
-    gb_polygon_raster_edge_ref_t    edge_cache_next = tb_null; 
-    gb_polygon_raster_edge_ref_t    edge_pool       = impl->edge_pool;
-    while (index) 
-    { 
-        // the edge
-        edge = edge_pool + index; 
-
-        /* compute the winding
-         *   
-         *    /\
-         *    |            |
-         *    |-1          | +1
-         *    |            |
-         *    |            |
-         *                \/
-         */
-        winding += edge->winding; 
-
-        // the next edge index
-        index_next = edge->next; 
-        tb_check_break(index_next);
-
-        // the next edge
-        edge_next = edge_pool + index_next; 
-
-        // check
-        tb_assert(edge->x <= edge_next->x);
-
-        // compute the rule
-        switch (rule)
-        {
-        case GB_POLYGON_RASTER_RULE_ODD:
-            {
-                /* the odd rule 
-                 *
-                 *    ------------------                 ------------------ 
-                 *  /|\                 |               ||||||||||||||||||||
-                 *   |     --------     |               ||||||||||||||||||||
-                 *   |   /|\       |    |               ||||||        ||||||
-                 * 0 | -1 |   0    | -1 | 0     =>      ||||||        ||||||
-                 *   |    |       \|/   |               ||||||        ||||||
-                 *   |     --------     |               ||||||||||||||||||||
-                 *   |                 \|/              ||||||||||||||||||||
-                 *    ------------------                 ------------------ 
-                 */
-                done = winding & 1;
-            }
-            break;
-        case GB_POLYGON_RASTER_RULE_NONZERO:
-            {
-                /* the non-zero rule 
-                 *
-                 *    ------------------                 ------------------
-                 *  /|\                 |               ||||||||||||||||||||
-                 *   |     --------     |               ||||||||||||||||||||
-                 *   |   /|\       |    |               ||||||||||||||||||||
-                 * 0 | -1 |   -2   | -1 | 0             ||||||||||||||||||||
-                 *   |    |       \|/   |               ||||||||||||||||||||
-                 *   |     --------     |               ||||||||||||||||||||
-                 *   |                 \|/              ||||||||||||||||||||
-                 *    ------------------                 ------------------
-                 */
-                done = winding;
-            }
-            break;
-        default:
-            {
-                // clear it
-                done = 0;
-
-                // trace
-                tb_trace_e("unknown rule: %lu", rule);
-            }
-            break;
-        }
-
-        // trace
-        tb_trace_d("y: %ld, winding: %ld, %{fixed} => %{fixed}", y, winding, edge->x, edge_next->x);
+    // the x-coordinates relative to the left of the cells, x0 <= x1
+    tb_fixed_t x0 = xb - (impl->left << 16);
+    tb_fixed_t x1 = xe - (impl->left << 16);
+    if (x0 > x1) tb_swap(tb_fixed_t, x0, x1);
+    tb_assert(x0 >= 0 && (x1 >> 16) <= impl->right - impl->left);
 
-#if 0
-        // done it for winding?
-        if (done) func(tb_fixed_round(edge->x), tb_fixed_round(edge_next->x), y, y + 1, priv);
-#else
-        // cache the conjoint edges and done them together
-        if (done)
+    /* accumulate the area on the right-hand of the segment to the cells
+     *
+     * the coverage of the pixel column i:
+     *
+     * c(i) = delta * (H(i + 1 - x0) - H(i + 1 - x1)) / (x1 - x0)
+     *
+     * H(v): the integral of clamp(t, 0, 1) at (-oo, v]
+     *
+     * cells[i] += c(i) - c(i - 1)
+     */
+    tb_int32_t* cells   = impl->coverage_cells;
+    tb_long_t   i       = x0 >> 16;
+    tb_long_t   i1      = x1 >> 16;
+    tb_fixed_t  dx      = x1 - x0;
+    if (i == i1 || dx < (TB_FIXED_ONE >> 8))
+    {
+        // the almost vertical segment, only covers two cells
+        tb_fixed_t  xm      = (x0 + x1) >> 1;
+        tb_fixed_t  cover   = 0;
+        i = xm >> 16;
+        cover = (tb_fixed_t)(((tb_hong_t)delta * (((i + 1) << 16) - xm)) >> 16);
+        cells[i]        += cover;
+        cells[i + 1]    += delta - cover;
+        i1 = i;
+    }
+    else
+    {
+        tb_fixed_t  x       = 0;
+        tb_fixed_t  cover   = 0;
+        tb_fixed_t  cover_prev = 0;
+        tb_long_t   k       = i;
+        for (; k <= i1; k++)
         {
-            // no edge cache?
-            if (!edge_cache && !edge_cache_next) 
-            {
-                // init edge cache
-                edge_cache = edge;
-                edge_cache_next = edge_next;
-            }
-            // is conjoint? merge it
-            else if (edge_cache_next && tb_fixed_round(edge_cache_next->x) == tb_fixed_round(edge->x))
-            {
-                // merge the edges to the edge cache
-                edge_cache_next = edge_next;
-            }
-            else
-            {
-                // check
-                tb_assert(edge_cache && edge_cache_next);
-
-                // done edge cache
-                func(tb_fixed_round(edge_cache->x), tb_fixed_round(edge_cache_next->x), y, y + 1, priv);
-
-                // update edge cache
-                edge_cache = edge;
-                edge_cache_next = edge_next;
-            }
+            x = (k + 1) << 16;
+            cover = (tb_fixed_t)(((tb_hong_t)delta * (gb_polygon_raster_coverage_integral(x - x0) - gb_polygon_raster_coverage_integral(x - x1))) / dx);
+            cells[k] += cover - cover_prev;
+            cover_prev = cover;
         }
-#endif
 
-        // the next edge index
-        index = index_next; 
+        // the remaining area for the right-hand cell, the sum of all cells must be delta exactly
+        cells[i1 + 1] += delta - cover_prev;
     }
 
-    // done the left edge cache
-    if (edge_cache && edge_cache_next) func(tb_fixed_round(edge_cache->x), tb_fixed_round(edge_cache_next->x), y, y + 1, priv);
+    // update the range of the touched cells
+    if (i < *pmin) *pmin = i;
+    if (i1 + 1 > *pmax) *pmax = i1 + 1;
 }
-static tb_void_t gb_polygon_raster_active_scan_next(gb_polygon_raster_impl_t* impl, tb_long_t y, tb_size_t* porder)
+static tb_void_t gb_polygon_raster_coverage_scan_line(gb_polygon_raster_impl_t* impl, tb_long_t y, tb_size_t rule, tb_long_t cell_min, tb_long_t cell_max, gb_polygon_raster_coverage_func_t func, tb_cpointer_t priv)
 {
     // check
-    tb_assert(impl && impl->edge_pool && impl->edge_table && y <= impl->bottom);
+    tb_assert(impl && impl->coverage_cells && impl->coverages && func);
+
+    // no touched cells?
+    tb_check_return(cell_min <= cell_max);
 
     // done
-    tb_size_t                       first = 1;
-    tb_size_t                       order = 1;
-    tb_fixed_t                      x_prev = 0;
-    tb_uint16_t                     index_prev = 0;
-    tb_uint16_t                     index = impl->active_edges;
-    gb_polygon_raster_edge_ref_t    edge = tb_null; 
-    gb_polygon_raster_edge_ref_t    edge_prev = tb_null; 
-    gb_polygon_raster_edge_ref_t    edge_pool = impl->edge_pool;
-    tb_uint16_t                     active_edges = impl->active_edges;
-    while (index)
+    tb_long_t   i           = cell_min;
+    tb_long_t   start       = -1;
+    tb_fixed_t  cover       = 0;
+    tb_size_t   value       = 0;
+    tb_int32_t* cells       = impl->coverage_cells;
+    tb_byte_t*  coverages   = impl->coverages;
+    tb_long_t   left        = impl->left;
+    tb_long_t   width       = impl->right - impl->left;
+    for (; i <= cell_max; i++)
     {
-        // the edge
-        edge = edge_pool + index;
-
-        /* remove edge from the active edges if (y >= edge->y_bottom)
-         *            
-         *             .
-         *           .  .
-         *         .     .
-         *       .        .  <- y_bottom: end and no next y for this edge, so remove it
-         *     .           . <- the start y of the next edge
-         *       .        .
-         *          .   .   
-         *            .      <- bottom
-         */
-        if (edge->y_bottom < y + 1)
-        {
-            // the next edge index
-            index = edge->next;
+        // accumulate the cover and clear this cell for the next line
+        cover += cells[i];
+        cells[i] = 0;
 
-            // remove this edge from head
-            if (!index_prev) active_edges = index;
-            else 
+        // only the pixels at [left, right) are covered, the right-hand cells only need to be cleared
+        if (i >= width) value = 0;
+        else
+        {
+            // compute the coverage for rule
+            value = (tb_size_t)tb_abs(cover);
+            if (rule == GB_POLYGON_RASTER_RULE_ODD)
             {
-                // the previous edge 
-                edge_prev = edge_pool + index_prev;
-
-                // remove this edge from the body
-                edge_prev->next = index;
+                value &= 0x1ffff;
+                if (value > TB_FIXED_ONE) value = (TB_FIXED_ONE << 1) - value;
             }
+            else if (value > TB_FIXED_ONE) value = TB_FIXED_ONE;
 
-            // continue 
-            continue;
+            // 1.0 => 255
+            value = (value - (value >> 8)) >> 8;
         }
 
-        // update the x-coordinate
-        edge->x += edge->slope;
+        // save the coverage
+        coverages[i] = (tb_byte_t)value;
 
-        // is order?
-        if (porder)
+        // done the coverages of the previous span if be empty pixel
+        if (!value)
         {
-            if (first) first = 0;
-            else if (order && edge->x < x_prev) order = 0;
+            if (start >= 0) func(left + start, y, coverages + start, i - start, priv);
+            start = -1;
         }
-
-        // update the previous x-coordinate
-        x_prev = edge->x;
-
-        // update the previous edge index
-        index_prev = index;
-
-        // update the edge index
-        index = edge->next;
+        else if (start < 0) start = i;
     }
 
-    // save order
-    if (porder) *porder = order; 
-
-    // update the active edges 
-    impl->active_edges = active_edges;
+    // done the left coverages
+    if (start >= 0) func(left + start, y, coverages + start, i - start, priv);
 }
-static tb_void_t gb_polygon_raster_active_append(gb_polygon_raster_impl_t* impl, tb_uint16_t index)
+static tb_void_t gb_polygon_raster_coverage_scan(gb_polygon_raster_impl_t* impl, tb_size_t rule, gb_polygon_raster_coverage_func_t func, tb_cpointer_t priv)
 {
     // check
-    tb_assert(impl && impl->edge_pool);
+    tb_assert(impl && impl->coverage_edge_pool && impl->edge_table && func);
 
     // done
-    tb_uint16_t                     next = 0;
-    gb_polygon_raster_edge_ref_t    edge = tb_null;
-    gb_polygon_raster_edge_ref_t    edge_pool = impl->edge_pool;
-    tb_uint16_t                     active_edges = impl->active_edges;
-    while (index)
+    tb_long_t                               y;
+    tb_fixed_t                              yt;
+    tb_fixed_t                              yb;
+    tb_fixed_t                              xt;
+    tb_fixed_t                              xb;
+    tb_long_t                               cell_min;
+    tb_long_t                               cell_max;
+    tb_uint32_t                             index;
+    tb_uint32_t                             index_prev;
+    tb_uint32_t                             active_edges = 0;
+    gb_polygon_raster_coverage_edge_ref_t   edge;
+    gb_polygon_raster_coverage_edge_ref_t   edge_pool   = impl->coverage_edge_pool;
+    tb_uint32_t*                            edge_table  = (tb_uint32_t*)impl->edge_table;
+    tb_long_t                               base        = impl->edge_table_base;
+    tb_long_t                               bottom      = impl->bottom;
+    for (y = impl->top; y < bottom; y++)
     {
-        // the edge
-        edge = edge_pool + index;
-
-        // save the next edge index
-        next = edge->next;
-
-        // insert the edge to the head of the active edges
-        edge->next = active_edges;
-        active_edges = index;
-
-        // the next edge index
-        index = next;
-    }
-
-    // update the active edges 
-    impl->active_edges = active_edges;
-}
-static tb_void_t gb_polygon_raster_active_sorted_insert(gb_polygon_raster_impl_t* impl, tb_uint16_t edge_index)
-{
-    // check
-    tb_assert(impl && impl->edge_pool && edge_index);
-
-    // the edge pool
-    gb_polygon_raster_edge_ref_t edge_pool = impl->edge_pool;
-
-    // the edge
-    gb_polygon_raster_edge_ref_t edge = edge_pool + edge_index;
+        // append edges from the edge table, the active edges need not be sorted for accumulating area
+        index = edge_table[y - base];
+        while (index)
+        {
+            edge = edge_pool + index;
+            index_prev = edge->next;
+            edge->next = active_edges;
+            active_edges = index;
+            index = index_prev;
+        }
 
-    // insert edge to the active edges by x in ascending
-    edge->next = 0;
-    if (!impl->active_edges) impl->active_edges = edge_index;
-    else 
-    {
-        // find an inserted position
-        gb_polygon_raster_edge_ref_t    edge_prev       = tb_null;
-        gb_polygon_raster_edge_ref_t    edge_active     = tb_null;
-        tb_uint16_t                     index_active    = impl->active_edges;
-        while (index_active)
+        // accumulate the area of the edge segments at this line
+        cell_min    = impl->right - impl->left + 1;
+        cell_max    = -1;
+        index       = active_edges;
+        index_prev  = 0;
+        while (index)
         {
-            // the active edge
-            edge_active = edge_pool + index_active;
-
-            // check
-            tb_assert(edge_index != index_active);
-
-            /* is this?
-             *
-             * x: 1 2 3     5 6
-             *               |
-             *             4 or 5
-             */
-            if (edge->x <= edge_active->x) 
+            // the edge
+            edge = edge_pool + index;
+
+            // the segment of this edge at [y, y + 1)
+            yt = tb_max(edge->y_top, y << 16);
+            yb = tb_min(edge->y_bottom, (y + 1) << 16);
+            xt = (yt == edge->y_top)? edge->x : edge->x + (tb_fixed_t)((edge->slope * (yt - edge->y_top)) >> 16);
+            xb = (yb == edge->y_bottom)? edge->x_bottom : edge->x + (tb_fixed_t)((edge->slope * (yb - edge->y_top)) >> 16);
+            if (yb > yt) gb_polygon_raster_coverage_accumulate(impl, xt, xb, (yb - yt) * edge->winding, &cell_min, &cell_max);
+
+            // end? remove this edge from the active edges
+            if (yb == edge->y_bottom)
             {
-                /* same vertex?
-                 *
-                 *
-                 * x: 1 2 3     5 6
-                 *               |   .
-                 *               5    .
-                 *             .       .
-                 *           .          .
-                 *         .          active_edge
-                 *       .
-                 *     edge
-                 *
-                 * x: 1 2 3   5         6
-                 *                 .    |
-                 *                  .   5
-                 *                   .    .
-                 *                    .     .
-                 *          active_edge       .
-                 *                              . 
-                 *                                .  
-                 *                                  .
-                 *                                   edge
-                 *
-                 *  x: 1 2 3   5         6
-                 *                 .    |
-                 *                .     5
-                 *              .    .
-                 *            .     .
-                 *  active_edge    .
-                 *                . 
-                 *               .  
-                 *              .
-                 *             edge
-                 *
-                 *
-                 * x: 1 2 3     5 6
-                 *               |   .
-                 *               5      .
-                 *                 .       .
-                 *                   .       active_edge 
-                 *                     .           
-                 *                       .
-                 *                         .
-                 *                           .
-                 *                             .
-                 *                               .
-                 *                                 .
-                 *                                 edge
-                 */
-                if (edge->x == edge_active->x)
-                {
-                    /* the edge is at the left-hand of the active edge?
-                     * 
-                     * x: 1 2 3     5 6    <- active_edges
-                     *               |   .
-                     *               5    .
-                     *             .       .
-                     *           .          .
-                     *         .        active_edge
-                     *       .
-                     *     edge
-                     *
-                     * if (edge->dx / edge->dy < active->dx / active->dy)?
-                     */
-                    if (edge->slope < edge_active->slope) break;
-                }
-                else break;
+                if (index_prev) edge_pool[index_prev].next = edge->next;
+                else active_edges = edge->next;
             }
-            
-            // the previous active edge
-            edge_prev = edge_active;
+            else index_prev = index;
 
-            // the next active edge index
-            index_active = edge_prev->next;
+            // the next edge
+            index = edge->next;
         }
 
-        // insert edge to the active edges: edge_prev -> edge -> edge_active
-        if (!edge_prev)
-        {
-            // insert to the head
-            edge->next          = impl->active_edges;
-            impl->active_edges  = edge_index;
-        }
-        else
-        {
-            // insert to the body
-            edge->next      = index_active;
-            edge_prev->next = edge_index;
-        }
+        // scan line from the coverage cells
+        gb_polygon_raster_coverage_scan_line(impl, y, rule, cell_min, cell_max, func, priv);
     }
 }
-static tb_void_t gb_polygon_raster_active_sorted_append(gb_polygon_raster_impl_t* impl, tb_uint16_t edge_index)
+static __tb_inline__ tb_void_t gb_polygon_raster_spans_append(gb_polygon_raster_spans_ref_t spans, tb_long_t y, tb_long_t x0, tb_long_t x1, tb_byte_t coverage)
 {
     // check
-    tb_assert(impl && impl->edge_pool);
-
-    // done
-    tb_uint16_t                     index_next = 0;
-    gb_polygon_raster_edge_ref_t    edge = tb_null;
-    gb_polygon_raster_edge_ref_t    edge_pool = impl->edge_pool;
-    while (edge_index)
-    {
-        // the edge
-        edge = edge_pool + edge_index;
+    tb_assert(spans && spans->data && spans->size < spans->maxn);
 
-        // save the next edge index
-        index_next = edge->next;
+    // append span
+    gb_polygon_raster_span_ref_t span = spans->data + spans->size++;
+    span->y         = (tb_int32_t)y;
+    span->x0        = (tb_int32_t)x0;
+    span->x1        = (tb_int32_t)x1;
+    span->coverage  = coverage;
 
-        // insert the edge to the active edges
-        gb_polygon_raster_active_sorted_insert(impl, edge_index);
-
-        // the next edge index
-        edge_index = index_next;
-    }
-}
-static tb_void_t gb_polygon_raster_active_sort(gb_polygon_raster_impl_t* impl)
-{
-    // check
-    tb_assert(impl && impl->edge_pool);
-
-    // done
-    tb_uint16_t                     index       = impl->active_edges;
-    tb_uint16_t                     index_next  = 0;
-    gb_polygon_raster_edge_ref_t    edge        = tb_null;
-    gb_polygon_raster_edge_ref_t    edge_next   = tb_null;
-    gb_polygon_raster_edge_t        edge_tmp;
-    gb_polygon_raster_edge_ref_t    edge_pool   = impl->edge_pool;
-    while (index)
+    // full? flush them
+    if (spans->size == spans->maxn) 
     {
-        // the edge
-        edge = edge_pool + index;
-
-        // the next edge index
-        index_next = edge->next;
-        while (index_next)
-        {
-            // the next edge
-            edge_next = edge_pool + index_next;
-
-            // need sort? swap them
-            if (edge->x > edge_next->x || (edge->x == edge_next->x && edge->slope > edge_next->slope))
-            {
-                // save the edge
-                edge_tmp = *edge;
-
-                // swap the edge
-                *edge = *edge_next;
-
-                // restore the next index
-                edge->next = edge_tmp.next;
-                edge_tmp.next = edge_next->next;
-
-                // swap the next edge
-                *edge_next = edge_tmp;
-            }
-        
-            // the next edge index
-            index_next = edge_next->next;
-        }
-
-        // the next edge index
-        index = edge->next;
+        spans->func(spans->data, spans->size, spans->priv);
+        spans->size = 0;
     }
 }
-static tb_void_t gb_polygon_raster_done_convex(gb_polygon_raster_impl_t* impl, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, gb_polygon_raster_func_t func, tb_cpointer_t priv)
+static tb_void_t gb_polygon_raster_spans_func(tb_long_t lx, tb_long_t rx, tb_long_t yb, tb_long_t ye, tb_cpointer_t priv)
 {
     // check
-    tb_assert(impl && polygon && polygon->convex && bounds);
-
-    // init the active edges
-    impl->active_edges = 0;
-
-    // make the edge table
-    if (!gb_polygon_raster_edge_table_make(impl, polygon, bounds)) return ;
-
-    // done scan
-    tb_long_t       y;
-    tb_long_t       top         = impl->top; 
-    tb_long_t       bottom      = impl->bottom; 
-    tb_long_t       base        = impl->edge_table_base; 
-    tb_uint16_t*    edge_table  = impl->edge_table;
-    for (y = top; y < bottom; y++)
-    {
-        // append edges to the sorted active edges by x in ascending
-        gb_polygon_raster_active_sorted_append(impl, edge_table[y - base]); 
+    gb_polygon_raster_spans_ref_t spans = (gb_polygon_raster_spans_ref_t)priv;
+    tb_assert(spans && ye > yb);
 
-        // scan line from the active edges
-        gb_polygon_raster_active_scan_line_convex(impl, y, func, priv); 
+    // empty span?
+    tb_check_return(rx > lx);
 
-        // end?
-        tb_check_break(y < bottom - 1);
-
-        // scan the next line from the active edges
-        gb_polygon_raster_active_scan_next(impl, y, tb_null); 
-    }
+    // split it to the spans of each line
+    for (; yb < ye; yb++) gb_polygon_raster_spans_append(spans, yb, lx, rx, 0xff);
 }
-static tb_void_t gb_polygon_raster_done_concave(gb_polygon_raster_impl_t* impl, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, tb_size_t rule, gb_polygon_raster_func_t func, tb_cpointer_t priv)
+static tb_void_t gb_polygon_raster_spans_coverage_func(tb_long_t x, tb_long_t y, tb_byte_t const* coverages, tb_size_t count, tb_cpointer_t priv)
 {
     // check
-    tb_assert(impl && polygon && !polygon->convex && bounds);
-
-    // init the active edges
-    impl->active_edges = 0;
-
-    // make the edge table
-    if (!gb_polygon_raster_edge_table_make(impl, polygon, bounds)) return ;
-
-    // done scan
-    tb_long_t       y;
-    tb_size_t       order       = 1; 
-    tb_long_t       top         = impl->top; 
-    tb_long_t       bottom      = impl->bottom; 
-    tb_long_t       base        = impl->edge_table_base; 
-    tb_uint16_t*    edge_table  = impl->edge_table;
-    for (y = top; y < bottom; y++)
+    gb_polygon_raster_spans_ref_t spans = (gb_polygon_raster_spans_ref_t)priv;
+    tb_assert(spans && coverages && count);
+
+    // merge the pixels with the same coverage to the span
+    tb_size_t   i = 0;
+    tb_size_t   start = 0;
+    tb_byte_t   coverage = coverages[0];
+    for (i = 1; i < count; i++)
     {
-        // order? append edges to the sorted active edges by x in ascending
-        if (order) gb_polygon_raster_active_sorted_append(impl, edge_table[y - base]); 
-        else
+        if (coverages[i] != coverage)
         {
-            // append edges to the active edges from the edge table
-            gb_polygon_raster_active_append(impl, edge_table[y - base]); 
-
-            // sort by x in ascending at the active edges
-            gb_polygon_raster_active_sort(impl); 
+            gb_polygon_raster_spans_append(spans, y, x + start, x + i, coverage);
+            coverage = coverages[i];
+            start = i;
         }
-
-        // scan line from the active edges
-        gb_polygon_raster_active_scan_line_concave(impl, y, rule, func, priv); 
-
-        // end?
-        tb_check_break(y < bottom - 1);
-
-        // scan the next line from the active edges
-        gb_polygon_raster_active_scan_next(impl, y, &order); 
     }
+
+    // append the last span
+    gb_polygon_raster_spans_append(spans, y, x + start, x + count, coverage);
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -1012,9 +936,34 @@ tb_void_t gb_polygon_raster_exit(gb_polygon_raster_ref_t raster)
     // exit the edge pool
     gb_polygon_raster_edge_pool_exit(impl);
 
+    // exit the coverage edge pool
+    gb_polygon_raster_coverage_edge_pool_exit(impl);
+
+    // exit the coverage cells
+    gb_polygon_raster_coverage_cells_exit(impl);
+
     // exit it
     tb_free(impl);
 }
+tb_void_t gb_polygon_raster_band_set(gb_polygon_raster_ref_t raster, tb_long_t top, tb_long_t bottom)
+{
+    // check
+    gb_polygon_raster_impl_t* impl = (gb_polygon_raster_impl_t*)raster;
+    tb_assert_and_check_return(impl);
+
+    // set the band
+    impl->band_top      = top;
+    impl->band_bottom   = bottom;
+}
+tb_void_t gb_polygon_raster_layout_set(gb_polygon_raster_ref_t raster, tb_size_t layout)
+{
+    // check
+    gb_polygon_raster_impl_t* impl = (gb_polygon_raster_impl_t*)raster;
+    tb_assert_and_check_return(impl);
+
+    // set the edge layout
+    impl->layout = layout;
+}
 tb_void_t gb_polygon_raster_done(gb_polygon_raster_ref_t raster, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, tb_size_t rule, gb_polygon_raster_func_t func, tb_cpointer_t priv)
 {
     // check
@@ -1027,8 +976,8 @@ tb_void_t gb_polygon_raster_done(gb_polygon_raster_ref_t raster, gb_polygon_ref_
         // done
         tb_size_t       index               = 0;
         gb_point_ref_t  points              = polygon->points;
-        tb_uint16_t*    counts              = polygon->counts;
-        tb_uint16_t     contour_counts[2]   = {0, 0};
+        tb_uint32_t*    counts              = polygon->counts;
+        tb_uint32_t     contour_counts[2]   = {0, 0};
         gb_polygon_t    contour             = {tb_null, contour_counts, tb_true};
         while ((contour_counts[0] = *counts++))
         {
@@ -1036,7 +985,9 @@ tb_void_t gb_polygon_raster_done(gb_polygon_raster_ref_t raster, gb_polygon_ref_
             contour.points = points + index;
 
             // done raster for the convex contour, will be faster
-            gb_polygon_raster_done_convex(impl, &contour, bounds, func, priv);
+            if (gb_polygon_raster_need_large(impl, &contour, bounds))
+                gb_polygon_raster_large_done_convex(impl, &contour, bounds, func, priv);
+            else gb_polygon_raster_compact_done_convex(impl, &contour, bounds, func, priv);
 
             // update the contour index
             index += contour_counts[0];
@@ -1045,7 +996,40 @@ tb_void_t gb_polygon_raster_done(gb_polygon_raster_ref_t raster, gb_polygon_ref_
     else
     {
         // done raster for the concave polygon
-        gb_polygon_raster_done_concave(impl, polygon, bounds, rule, func, priv);
+        if (gb_polygon_raster_need_large(impl, polygon, bounds))
+            gb_polygon_raster_large_done_concave(impl, polygon, bounds, rule, func, priv);
+        else gb_polygon_raster_compact_done_concave(impl, polygon, bounds, rule, func, priv);
     }
 }
+tb_void_t gb_polygon_raster_done_coverage(gb_polygon_raster_ref_t raster, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, tb_size_t rule, gb_polygon_raster_coverage_func_t func, tb_cpointer_t priv)
+{
+    // check
+    gb_polygon_raster_impl_t* impl = (gb_polygon_raster_impl_t*)raster;
+    tb_assert_abort_and_check_return(impl && polygon && polygon->points && polygon->counts && bounds && func);
+
+    // make the coverage edge table for all contours
+    if (!gb_polygon_raster_coverage_edge_table_make(impl, polygon, bounds)) return ;
 
+    // done scan, the area accumulation need not distinguish the convex and concave polygon
+    gb_polygon_raster_coverage_scan(impl, polygon->convex? GB_POLYGON_RASTER_RULE_NONZERO : rule, func, priv);
+}
+tb_void_t gb_polygon_raster_done_spans(gb_polygon_raster_ref_t raster, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, tb_size_t rule, tb_bool_t antialiasing, gb_polygon_raster_span_ref_t spans, tb_size_t maxn, gb_polygon_raster_spans_func_t func, tb_cpointer_t priv)
+{
+    // check
+    tb_assert_abort_and_check_return(raster && spans && maxn && func);
+
+    // init the spans batch
+    gb_polygon_raster_spans_t batch;
+    batch.data = spans;
+    batch.size = 0;
+    batch.maxn = maxn;
+    batch.func = func;
+    batch.priv = priv;
+
+    // done raster
+    if (antialiasing) gb_polygon_raster_done_coverage(raster, polygon, bounds, rule, gb_polygon_raster_spans_coverage_func, &batch);
+    else gb_polygon_raster_done(raster, polygon, bounds, rule, gb_polygon_raster_spans_func, &batch);
+
+    // flush the left spans
+    if (batch.size) func(batch.data, batch.size, priv);
+}
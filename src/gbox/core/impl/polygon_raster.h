@@ -47,9 +47,38 @@ typedef enum __gb_polygon_raster_rule_e
 
 }gb_polygon_raster_rule_e;
 
+/* the polygon raster edge layout enum
+ *
+ * the compact layout uses the 16-bit edge indices and keeps the smaller cache footprint,
+ * but it only supports the polygon with less than 65535 edges
+ */
+typedef enum __gb_polygon_raster_layout_e
+{
+    GB_POLYGON_RASTER_LAYOUT_AUTO   = 0 //< the compact layout for the small polygon and the large layout for the huge polygon
+,   GB_POLYGON_RASTER_LAYOUT_LARGE  = 1 //< always use the large layout with the 32-bit edge indices
+
+}gb_polygon_raster_layout_e;
+
 // the polygon raster ref type
 typedef struct{}*       gb_polygon_raster_ref_t;
 
+// the polygon raster span type
+typedef struct __gb_polygon_raster_span_t
+{
+    // the y-coordinate
+    tb_int32_t          y;
+
+    // the left x-coordinate
+    tb_int32_t          x0;
+
+    // the right x-coordinate, the pixels at [x0, x1) will be filled
+    tb_int32_t          x1;
+
+    // the coverage of the pixels, 255: full
+    tb_byte_t           coverage;
+
+}gb_polygon_raster_span_t, *gb_polygon_raster_span_ref_t;
+
 /* the polygon raster func type
  *
  * @param lx            the left x-coordinate
@@ -60,6 +89,24 @@ typedef struct{}*       gb_polygon_raster_ref_t;
  */
 typedef tb_void_t       (*gb_polygon_raster_func_t)(tb_long_t lx, tb_long_t rx, tb_long_t yb, tb_long_t ye, tb_cpointer_t priv);
 
+/* the polygon raster coverage func type
+ *
+ * @param x             the start x-coordinate
+ * @param y             the y-coordinate
+ * @param coverages     the coverages of the pixels at [x, x + count), 0: empty, 255: full 
+ * @param count         the pixels count
+ * @param priv          the private data
+ */
+typedef tb_void_t       (*gb_polygon_raster_coverage_func_t)(tb_long_t x, tb_long_t y, tb_byte_t const* coverages, tb_size_t count, tb_cpointer_t priv);
+
+/* the polygon raster spans func type
+ *
+ * @param spans         the spans
+ * @param count         the spans count
+ * @param priv          the private data
+ */
+typedef tb_void_t       (*gb_polygon_raster_spans_func_t)(gb_polygon_raster_span_ref_t spans, tb_size_t count, tb_cpointer_t priv);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -76,6 +123,25 @@ gb_polygon_raster_ref_t gb_polygon_raster_init(tb_noarg_t);
  */
 tb_void_t               gb_polygon_raster_exit(gb_polygon_raster_ref_t raster);
 
+/* set the edge layout
+ *
+ * @param raster        the raster
+ * @param layout        the edge layout, default: GB_POLYGON_RASTER_LAYOUT_AUTO
+ */
+tb_void_t               gb_polygon_raster_layout_set(gb_polygon_raster_ref_t raster, tb_size_t layout);
+
+/* set the band of the scan lines
+ *
+ * only the lines at [top, bottom) will be rasterized and the spans and coverages of these lines 
+ * are the same as rasterizing the whole polygon, so the bands can be rasterized concurrently 
+ * with the different rasters
+ *
+ * @param raster        the raster
+ * @param top           the top y-coordinate of the band
+ * @param bottom        the bottom y-coordinate of the band, no band if bottom <= top
+ */
+tb_void_t               gb_polygon_raster_band_set(gb_polygon_raster_ref_t raster, tb_long_t top, tb_long_t bottom);
+
 /* done raster
  *
  * @param raster        the raster
@@ -87,6 +153,40 @@ tb_void_t               gb_polygon_raster_exit(gb_polygon_raster_ref_t raster);
  */
 tb_void_t               gb_polygon_raster_done(gb_polygon_raster_ref_t raster, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, tb_size_t rule, gb_polygon_raster_func_t func, tb_cpointer_t priv);
 
+/* done raster with the anti-aliasing coverages
+ *
+ * compute the exact area covered by the polygon for each pixel 
+ * and pass the 8-bit coverages of each scan line to the func
+ *
+ * @param raster        the raster
+ * @param polygon       the polygon
+ * @param bounds        the bounds
+ * @param rule          the raster rule
+ * @param func          the raster coverage func
+ * @param priv          the private data
+ */
+tb_void_t               gb_polygon_raster_done_coverage(gb_polygon_raster_ref_t raster, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, tb_size_t rule, gb_polygon_raster_coverage_func_t func, tb_cpointer_t priv);
+
+/* done raster with the span batches
+ *
+ * the spans will be filled to the given array and passed to the func in chunks,
+ * the span of the multiple lines will be split into the spans of each line.
+ *
+ * the anti-aliasing coverages will be merged to the spans with the same coverage,
+ * and the coverage of all spans is 255 if no anti-aliasing.
+ *
+ * @param raster        the raster
+ * @param polygon       the polygon
+ * @param bounds        the bounds
+ * @param rule          the raster rule
+ * @param antialiasing  enable anti-aliasing?
+ * @param spans         the spans array
+ * @param maxn          the spans array maxn
+ * @param func          the raster spans func
+ * @param priv          the private data
+ */
+tb_void_t               gb_polygon_raster_done_spans(gb_polygon_raster_ref_t raster, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, tb_size_t rule, tb_bool_t antialiasing, gb_polygon_raster_span_ref_t spans, tb_size_t maxn, gb_polygon_raster_spans_func_t func, tb_cpointer_t priv);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -30,37 +30,6 @@
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
-static tb_void_t gb_quad_make_line_impl(gb_point_t const points[3], tb_size_t count, gb_quad_line_func_t func, tb_cpointer_t priv)
-{
-    /* divide it
-     * 
-     *
-     *                  p1
-     *                  .
-     *                .  .
-     *              .     .
-     *            .        .
-     *       o1 . . . . . . . o3
-     *        .      o2      .
-     *      .                 .
-     *    .                    .
-     * p0, o0                p2, o4
-     *
-     */
-    if (count)
-    {
-        // chop the quad at half
-        gb_point_t output[5];
-        gb_quad_chop_at_half(points, output);
-
-        // make line for quad(o0, o1, o2)
-        gb_quad_make_line_impl(output, count - 1, func, priv);
-
-        // make line to quad(o2, o3, o4)
-        gb_quad_make_line_impl(output + 2, count - 1, func, priv);
-    }
-    else func((gb_point_ref_t)&points[2], priv);
-}
 static tb_void_t gb_quad_chop_xy_at(gb_float_t const* xy, gb_float_t* output, gb_float_t factor) 
 {
     // compute the interpolation of p0 => p1
@@ -201,23 +170,31 @@ gb_float_t gb_quad_near_distance(gb_point_t const points[3])
     // compute the more approximate distance
     return (dx > dy)? (dx + gb_half(dy)) : (dy + gb_half(dx));
 }
-tb_size_t gb_quad_divide_line_count(gb_point_t const points[3])
+tb_size_t gb_quad_divide_line_count(gb_point_t const points[3], gb_float_t scale)
 {
     // check
-    tb_assert(points);
+    tb_assert(points && scale >= 0);
 
     // compute the approximate distance
     gb_float_t distance = gb_quad_near_distance(points);
     tb_assert(distance >= 0);
 
-    // get the integer distance
-    tb_size_t idistance = gb_ceil(distance);
-
-    // compute the divided count
-    tb_size_t count = (tb_ilog2i(idistance) >> 1) + 1;
+    /* compute the scaled distance with the tolerance
+     *
+     * the max error of the lines is about distance / 2 and it will be reduced to 1/4 after dividing it once,
+     * so the error is less than 1/4 pixel if 4^count >= (distance * scale / 2) / (1 / 4) = distance * scale * 2,
+     * and n = ceil(distance * scale * 2) for both the fixed and float
+     */
+#ifdef GB_CONFIG_FLOAT_FIXED
+    tb_hize_t n = (tb_hize_t)(((tb_hong_t)distance * scale + (((tb_hong_t)1 << 31) - 1)) >> 31);
+#else
+    gb_float_t f = distance * scale * 2;
+    tb_hize_t n = f < (gb_float_t)(1 << (GB_QUAD_DIVIDED_LINE_MAXN << 1))? (tb_hize_t)gb_ceil(f) : ((tb_hize_t)1 << (GB_QUAD_DIVIDED_LINE_MAXN << 1));
+#endif
 
-    // limit the count
-    if (count > GB_QUAD_DIVIDED_MAXN) count = GB_QUAD_DIVIDED_MAXN;
+    // compute the divided count: ceil(log4(n))
+    tb_size_t count = 0;
+    while (count < GB_QUAD_DIVIDED_LINE_MAXN && ((tb_hize_t)1 << (count << 1)) < n) count++;
 
     // ok
     return count;
@@ -291,15 +268,72 @@ tb_size_t gb_quad_chop_at_max_curvature(gb_point_t const points[3], gb_point_t o
     // the sub-curve count
     return count;
 }
-tb_void_t gb_quad_make_line(gb_point_t const points[3], gb_quad_line_func_t func, tb_cpointer_t priv)
+tb_size_t gb_quad_make_line(gb_point_t const points[3], tb_size_t count, gb_point_ref_t output)
 {
     // check
-    tb_assert(func && points);
+    tb_assert(points && output && count <= GB_QUAD_DIVIDED_LINE_MAXN);
 
-    // compute the divided count first
-    tb_size_t count = gb_quad_divide_line_count(points);
+    /* make the points at t = i / n by the forward differencing, n = 2^count
+     *
+     * they are the same as the end points of the sub-curves after chopping it at half for count times
+     *
+     * X(t) = x0 + b * t + a * t^2
+     * a = x0 - 2 * x1 + x2
+     * b = 2 * (x1 - x0)
+     *
+     * X(i) * n^2 = x0 * n^2 + b * n * i + a * i^2
+     * => d1(0) = b * n + a
+     * => d2 = 2 * a
+     */
+    tb_size_t i = 1;
+    tb_size_t n = (tb_size_t)1 << count;
+#ifdef GB_CONFIG_FLOAT_FIXED
+    // compute them exactly with the integers scaled by n^2
+    tb_size_t shift = count << 1;
+    tb_hong_t round = shift? ((tb_hong_t)1 << (shift - 1)) : 0;
+    tb_hong_t ax    = (tb_hong_t)points[0].x - ((tb_hong_t)points[1].x << 1) + points[2].x;
+    tb_hong_t ay    = (tb_hong_t)points[0].y - ((tb_hong_t)points[1].y << 1) + points[2].y;
+    tb_hong_t x     = (tb_hong_t)points[0].x << shift;
+    tb_hong_t y     = (tb_hong_t)points[0].y << shift;
+    tb_hong_t d1x   = ((((tb_hong_t)points[1].x - points[0].x) << 1) << count) + ax;
+    tb_hong_t d1y   = ((((tb_hong_t)points[1].y - points[0].y) << 1) << count) + ay;
+    tb_hong_t d2x   = ax << 1;
+    tb_hong_t d2y   = ay << 1;
+    for (; i < n; i++, output++)
+    {
+        x   += d1x;
+        y   += d1y;
+        d1x += d2x;
+        d1y += d2y;
+        output->x = (gb_float_t)((x + round) >> shift);
+        output->y = (gb_float_t)((y + round) >> shift);
+    }
+#else
+    // the step
+    gb_float_t h    = 1.0f / (gb_float_t)n;
+    gb_float_t hh   = h * h;
+    gb_float_t ax   = points[0].x - points[1].x - points[1].x + points[2].x;
+    gb_float_t ay   = points[0].y - points[1].y - points[1].y + points[2].y;
+    gb_float_t x    = points[0].x;
+    gb_float_t y    = points[0].y;
+    gb_float_t d1x  = (points[1].x - points[0].x) * 2 * h + ax * hh;
+    gb_float_t d1y  = (points[1].y - points[0].y) * 2 * h + ay * hh;
+    gb_float_t d2x  = ax * hh * 2;
+    gb_float_t d2y  = ay * hh * 2;
+    for (; i < n; i++, output++)
+    {
+        x   += d1x;
+        y   += d1y;
+        d1x += d2x;
+        d1y += d2y;
+        output->x = x;
+        output->y = y;
+    }
+#endif
 
-    // make line
-    gb_quad_make_line_impl(points, count, func, priv);
-}
+    // the last point is the end point exactly
+    *output = points[2];
 
+    // the points count
+    return n;
+}
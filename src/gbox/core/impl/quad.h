@@ -41,16 +41,8 @@ __tb_extern_c_enter__
 // the max quadratic curve divided count
 #define GB_QUAD_DIVIDED_MAXN          (5)
 
-/* //////////////////////////////////////////////////////////////////////////////////////
- * types
- */
-
-/* the quad line func type
- * 
- * @param point     the point 
- * @param priv      the user private data
- */
-typedef tb_void_t   (*gb_quad_line_func_t)(gb_point_ref_t point, tb_cpointer_t priv);
+// the max divided count for making line-to points, the curve will be divided into 2^count lines at most
+#define GB_QUAD_DIVIDED_LINE_MAXN     (8)
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
@@ -78,12 +70,16 @@ typedef tb_void_t   (*gb_quad_line_func_t)(gb_point_ref_t point, tb_cpointer_t p
 gb_float_t          gb_quad_near_distance(gb_point_t const points[3]);
 
 /* compute the approximate divided count for approaching the line-to
+ *
+ * the curve is divided into 2^count lines and the flattening error is less than 1/4 pixel
+ * after the points are transformed by the matrix with the given scale
  *
  * @param points    the points
+ * @param scale     the scale of the matrix for drawing, the distance of the path is scaled to pixels by it
  *
  * @return          the approximate divided count
  */
-tb_size_t           gb_quad_divide_line_count(gb_point_t const points[3]);
+tb_size_t           gb_quad_divide_line_count(gb_point_t const points[3], gb_float_t scale);
 
 /* chop the quad curve at the given position
  *
@@ -142,12 +138,17 @@ tb_void_t           gb_quad_chop_at_half(gb_point_t const points[3], gb_point_t
 tb_size_t           gb_quad_chop_at_max_curvature(gb_point_t const points[3], gb_point_t output[5]);
 
 /* make line-to points for the quadratic curve
+ *
+ * the curve is divided into 2^count lines by the forward differencing without recursion,
+ * and the end points of these lines are written to the output, the start point is not included.
  *
  * @param points    the points
- * @param func      the make func
- * @param priv      the make func private data for user
+ * @param count     the divided count, e.g. gb_quad_divide_line_count()
+ * @param output    the output points, the size must be at least 2^count
+ *
+ * @return          the output points count: 2^count
  */
-tb_void_t           gb_quad_make_line(gb_point_t const points[3], gb_quad_line_func_t func, tb_cpointer_t priv);
+tb_size_t           gb_quad_make_line(gb_point_t const points[3], tb_size_t count, gb_point_ref_t output);
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
@@ -1908,8 +1908,8 @@ tb_void_t gb_stroker_add_polygon(gb_stroker_ref_t stroker, gb_polygon_ref_t poly
     gb_point_ref_t  first = tb_null;
     gb_point_ref_t  point = tb_null;
     gb_point_ref_t  points = polygon->points;
-    tb_uint16_t*    counts = polygon->counts;
-    tb_uint16_t     count = *counts++;
+    tb_uint32_t*    counts = polygon->counts;
+    tb_uint32_t     count = *counts++;
     tb_size_t       index = 0;
     while (index < count)
     {
@@ -41,6 +41,9 @@
 // the default rule
 #define GB_PAINT_DEFAULT_RULE               GB_PAINT_FILL_RULE_ODD
 
+// the default blend
+#define GB_PAINT_DEFAULT_BLEND              GB_PAINT_BLEND_SRC_OVER
+
 // the default width
 #define GB_PAINT_DEFAULT_WIDTH              GB_ONE
 
@@ -72,6 +75,9 @@ typedef struct __gb_paint_impl_t
     // the fill rule
     tb_uint32_t         rule    : 1;
 
+    // the blend mode
+    tb_uint32_t         blend   : 4;
+
     // the paint color
     gb_color_t          color;
 
@@ -147,6 +153,7 @@ tb_void_t gb_paint_clear(gb_paint_ref_t paint)
     impl->cap           = GB_PAINT_DEFAULT_CAP;
     impl->join          = GB_PAINT_DEFAULT_JOIN;
     impl->rule          = GB_PAINT_DEFAULT_RULE;
+    impl->blend         = GB_PAINT_DEFAULT_BLEND;
     impl->width         = GB_PAINT_DEFAULT_WIDTH;
     impl->color         = GB_COLOR_DEFAULT;
     impl->alpha         = GB_PAINT_DEFAULT_ALPHA;
@@ -338,6 +345,24 @@ tb_void_t gb_paint_fill_rule_set(gb_paint_ref_t paint, tb_size_t rule)
     // done
     impl->rule = (tb_uint32_t)rule;
 }
+tb_size_t gb_paint_blend(gb_paint_ref_t paint)
+{
+    // check
+    gb_paint_impl_t* impl = (gb_paint_impl_t*)paint;
+    tb_assert_and_check_return_val(impl, GB_PAINT_DEFAULT_BLEND);
+
+    // the blend mode
+    return impl->blend;
+}
+tb_void_t gb_paint_blend_set(gb_paint_ref_t paint, tb_size_t blend)
+{
+    // check
+    gb_paint_impl_t* impl = (gb_paint_impl_t*)paint;
+    tb_assert_and_check_return(impl && blend < GB_PAINT_BLEND_MAXN);
+
+    // done
+    impl->blend = (tb_uint32_t)blend;
+}
 gb_shader_ref_t gb_paint_shader(gb_paint_ref_t paint)
 {
     // check
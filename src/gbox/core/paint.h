@@ -83,6 +83,28 @@ typedef enum __gb_paint_fill_rule_e
 
 }gb_paint_fill_rule_e;
 
+/*! the paint blend mode enum
+ *
+ * the porter-duff modes and the separable blend modes, 
+ * all formulas use the premultiplied colors: S is the source and D is the destination
+ *
+ * the bitmap device supports the modes for the 32-bits rgb formats and rgb565 only, 
+ * nothing will be drawn with the other modes for the other formats,
+ * and the layer with alpha should be pargb8888 for the fastest src-over
+ */
+typedef enum __gb_paint_blend_e
+{
+    GB_PAINT_BLEND_SRC_OVER     = 0 //!< S + D * (1 - Sa), the default mode
+,   GB_PAINT_BLEND_SRC          = 1 //!< S
+,   GB_PAINT_BLEND_DST_IN       = 2 //!< D * Sa
+,   GB_PAINT_BLEND_DST_OUT      = 3 //!< D * (1 - Sa)
+,   GB_PAINT_BLEND_MULTIPLY     = 4 //!< S * (1 - Da) + D * (1 - Sa) + S * D
+,   GB_PAINT_BLEND_SCREEN       = 5 //!< S + D - S * D
+,   GB_PAINT_BLEND_PLUS         = 6 //!< min(S + D, 1)
+,   GB_PAINT_BLEND_MAXN         = 7
+
+}gb_paint_blend_e;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -267,6 +289,21 @@ tb_size_t           gb_paint_fill_rule(gb_paint_ref_t paint);
  */
 tb_void_t           gb_paint_fill_rule_set(gb_paint_ref_t paint, tb_size_t rule);
 
+/*! the paint blend mode
+ *
+ * @param paint     the paint 
+ *
+ * @return          the paint blend mode
+ */
+tb_size_t           gb_paint_blend(gb_paint_ref_t paint);
+
+/*! set the paint blend mode
+ *
+ * @param paint     the paint 
+ * @param blend     the paint blend mode
+ */
+tb_void_t           gb_paint_blend_set(gb_paint_ref_t paint, tb_size_t blend);
+
 /*! the paint shader
  *
  * @param paint     the paint 
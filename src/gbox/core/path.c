@@ -50,6 +50,28 @@
 // the point step for code
 #define gb_path_point_step(code)    ((code) < 1? 1 : (code) - 1)
 
+// the cached polygons count for the different scales
+#ifdef __gb_small__
+#   define GB_PATH_POLYGON_CACHE_MAXN       (2)
+#else
+#   define GB_PATH_POLYGON_CACHE_MAXN       (4)
+#endif
+
+// the scale level range of the cached polygon: [2^-8, 2^8]
+#define GB_PATH_POLYGON_LEVEL_MAXN          (8)
+
+// the invalid scale level of the cached polygon
+#define GB_PATH_POLYGON_LEVEL_NONE          (TB_MAXS32)
+
+// the path data magic: "gbph"
+#define GB_PATH_DATA_MAGIC                  (0x67627068)
+
+// the path data version
+#define GB_PATH_DATA_VERSION                (1)
+
+// the path data align
+#define GB_PATH_DATA_ALIGN                  (4)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -66,9 +88,124 @@ typedef enum __gb_path_flag_e
 ,   GB_PATH_FLAG_CONVEX                 = 32    //< all contours are convex polygon?
 ,   GB_PATH_FLAG_CLOSED                 = 64    //< the contour is closed now?
 ,   GB_PATH_FLAG_SINGLE                 = 128   //< single contour?
+,   GB_PATH_FLAG_DATA_MASK              = GB_PATH_FLAG_CURVE | GB_PATH_FLAG_CONVEX | GB_PATH_FLAG_CLOSED | GB_PATH_FLAG_SINGLE
 
 }gb_path_flag_e;
 
+// the path polygon cache type, the curves are flattened for the scale: 2^level
+typedef struct __gb_path_polygon_cache_t
+{
+    // the polygon
+    gb_polygon_t        polygon;
+
+    // the polygon points, gb_point_t[]
+    tb_vector_ref_t     points;
+
+    // the polygon counts, tb_uint32_t[]
+    tb_vector_ref_t     counts;
+
+    // the scale level, GB_PATH_POLYGON_LEVEL_NONE if it is not made
+    tb_long_t           level;
+
+    // the last used time
+    tb_size_t           time;
+
+    // the code index of the last flattened contour
+    tb_size_t           contour_code;
+
+    // the point index of the last flattened contour
+    tb_size_t           contour_point;
+
+    // the polygon points count before the last flattened contour
+    tb_size_t           contour_size;
+
+    // the polygon counts count before the last flattened contour
+    tb_size_t           contour_count;
+
+    // are the curves flattened?
+    tb_uint8_t          curve : 1;
+
+    // need update the last flattened contour and the appended contours?
+    tb_uint8_t          dirty : 1;
+
+}gb_path_polygon_cache_t;
+
+/* the path data head type, all fields are native-endian
+ *
+ * data: head, codes, points, [polygon counts], [polygon points]
+ *
+ * the codes are padded to four bytes, the polygon points are not saved
+ * if the path has no curves, because the polygon uses the points of the path directly
+ */
+typedef struct __gb_path_data_head_t
+{
+    // the magic, GB_PATH_DATA_MAGIC
+    tb_uint32_t         magic;
+
+    // the version, GB_PATH_DATA_VERSION
+    tb_uint16_t         version;
+
+    // the data flag, gb_path_data_flag_e
+    tb_uint8_t          flag;
+
+    // the path flag, GB_PATH_FLAG_DATA_MASK
+    tb_uint8_t          path_flag;
+
+    // is the fixed float type?
+    tb_uint8_t          fixed;
+
+    // the reserved bytes
+    tb_uint8_t          reserved[3];
+
+    // the codes count
+    tb_uint32_t         codes_count;
+
+    // the points count
+    tb_uint32_t         points_count;
+
+    // the bounds if GB_PATH_DATA_FLAG_BOUNDS
+    gb_rect_t           bounds;
+
+    // the scale level of the polygon if GB_PATH_DATA_FLAG_POLYGON
+    tb_sint32_t         polygon_level;
+
+    // the polygon counts count with the tail count
+    tb_uint32_t         polygon_counts;
+
+    // the polygon points count, it is zero if the polygon uses the points of the path
+    tb_uint32_t         polygon_points;
+
+}gb_path_data_head_t;
+
+/* the path storage type
+ *
+ * the storage is shared by the copied paths and copied only if one of them is modified
+ */
+typedef struct __gb_path_storage_t
+{
+    // the reference count
+    tb_atomic_t         refn;
+
+    // the codes, tb_uint8_t[], it is null if the storage only wraps the read-only data
+    tb_vector_ref_t     codes;
+
+    // the points, gb_point_t[], it is null if the storage only wraps the read-only data
+    tb_vector_ref_t     points;
+
+    // the wrapped codes of the read-only data
+    tb_uint8_t const*   data_codes;
+
+    // the wrapped points of the read-only data
+    gb_point_ref_t      data_points;
+
+    // the wrapped codes count of the read-only data
+    tb_size_t           data_codes_count;
+
+    // the wrapped points count of the read-only data
+    tb_size_t           data_points_count;
+
+}gb_path_storage_t;
+
 // the path impl type
 typedef struct __gb_path_impl_t
 {
@@ -81,9 +218,6 @@ typedef struct __gb_path_impl_t
     // the hint shape
     gb_shape_t          hint;
 
-    // the polygon
-    gb_polygon_t        polygon;
-
     // the bounds
     gb_rect_t           bounds;
 
@@ -93,31 +227,175 @@ typedef struct __gb_path_impl_t
     // the itor item
     gb_path_item_t      item;
 
-    // the codes, tb_uint8_t[]
-    tb_vector_ref_t     codes;
+    // the storage of the codes and points, it is shared with the copied paths
+    gb_path_storage_t*  storage;
 
-    // the points, gb_point_t[]
-    tb_vector_ref_t     points;
+    // the polygons for the different scales
+    gb_path_polygon_cache_t polygons[GB_PATH_POLYGON_CACHE_MAXN];
 
-    // the polygon points, gb_point_t[]
-    tb_vector_ref_t     polygon_points;
+    // the used time of the polygons
+    tb_size_t           polygons_time;
+
+    // the first modified code index for the polygons, the contours before it are not modified
+    tb_size_t           polygons_dirty;
 
-    // the polygon counts, gb_uint16_t[]
-    tb_vector_ref_t     polygon_counts;
+    // the points count of the made bounds, the bounds only need be grown for the appended points
+    tb_size_t           bounds_count;
 
 }gb_path_impl_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
+static __tb_inline__ tb_size_t gb_path_codes_size(gb_path_impl_t* impl)
+{
+    gb_path_storage_t* storage = impl->storage;
+    return storage->codes? tb_vector_size(storage->codes) : storage->data_codes_count;
+}
+static __tb_inline__ tb_uint8_t const* gb_path_codes_data(gb_path_impl_t* impl)
+{
+    gb_path_storage_t* storage = impl->storage;
+    return storage->codes? (tb_uint8_t const*)tb_vector_data(storage->codes) : storage->data_codes;
+}
+static __tb_inline__ tb_size_t gb_path_points_size(gb_path_impl_t* impl)
+{
+    gb_path_storage_t* storage = impl->storage;
+    return storage->points? tb_vector_size(storage->points) : storage->data_points_count;
+}
+static __tb_inline__ gb_point_ref_t gb_path_points_data(gb_path_impl_t* impl)
+{
+    gb_path_storage_t* storage = impl->storage;
+    return storage->points? (gb_point_ref_t)tb_vector_data(storage->points) : storage->data_points;
+}
+static __tb_inline__ tb_size_t gb_path_codes_last(gb_path_impl_t* impl)
+{
+    // the codes count
+    tb_size_t count = gb_path_codes_size(impl);
+
+    // the last code, the move-to code if no codes
+    return count? gb_path_codes_data(impl)[count - 1] : GB_PATH_CODE_MOVE;
+}
+static tb_void_t gb_path_make_head(gb_path_impl_t* impl)
+{
+    // check
+    tb_assert(impl);
+
+    // find the move-to point of the last contour
+    tb_size_t           code_index  = gb_path_codes_size(impl);
+    tb_size_t           point_index = gb_path_points_size(impl);
+    tb_uint8_t const*   codes       = gb_path_codes_data(impl);
+    while (code_index--)
+    {
+        point_index -= gb_path_point_step(codes[code_index]);
+        if (codes[code_index] == GB_PATH_CODE_MOVE) break;
+    }
+
+    // save the head
+    if (point_index < gb_path_points_size(impl)) impl->head = gb_path_points_data(impl)[point_index];
+}
+static tb_void_t gb_path_storage_exit(gb_path_storage_t* storage)
+{
+    // check
+    tb_assert_and_check_return(storage);
+
+    // be still shared?
+    tb_check_return(!tb_atomic_dec_and_fetch(&storage->refn));
+
+    // exit points
+    if (storage->points) tb_vector_exit(storage->points);
+    storage->points = tb_null;
+
+    // exit codes
+    if (storage->codes) tb_vector_exit(storage->codes);
+    storage->codes = tb_null;
+
+    // exit it
+    tb_free(storage);
+}
+static gb_path_storage_t* gb_path_storage_init(tb_noarg_t)
+{
+    // done
+    tb_bool_t           ok = tb_false;
+    gb_path_storage_t*  storage = tb_null;
+    do
+    {
+        // make storage
+        storage = tb_malloc0_type(gb_path_storage_t);
+        tb_assert_and_check_break(storage);
+
+        // init reference count
+        tb_atomic_set(&storage->refn, 1);
+
+        // init codes
+        storage->codes = tb_vector_init(GB_PATH_POINTS_GROW >> 1, tb_element_uint8());
+        tb_assert_and_check_break(storage->codes);
+
+        // init points
+        storage->points = tb_vector_init(GB_PATH_POINTS_GROW, tb_element_mem(sizeof(gb_point_t), tb_null, tb_null));
+        tb_assert_and_check_break(storage->points);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (storage) gb_path_storage_exit(storage);
+        storage = tb_null;
+    }
+
+    // ok?
+    return storage;
+}
+static tb_bool_t gb_path_storage_detach(gb_path_impl_t* impl)
+{
+    // check
+    tb_assert_and_check_return_val(impl && impl->storage, tb_false);
+
+    // the storage has been writable and not shared?
+    gb_path_storage_t* storage = impl->storage;
+    tb_check_return_val(!storage->codes || tb_atomic_get(&storage->refn) > 1, tb_true);
+
+    // only wrap the read-only data?
+    tb_bool_t wrapped = storage->codes? tb_false : tb_true;
+
+    // make a new storage
+    gb_path_storage_t* storage_new = gb_path_storage_init();
+    tb_assert_and_check_return_val(storage_new, tb_false);
+
+    // copy the codes and points
+    tb_size_t codes_size    = gb_path_codes_size(impl);
+    tb_size_t points_size   = gb_path_points_size(impl);
+    if (    !tb_vector_resize(storage_new->codes, codes_size)
+        ||  !tb_vector_resize(storage_new->points, points_size))
+    {
+        gb_path_storage_exit(storage_new);
+        return tb_false;
+    }
+    if (codes_size) tb_memcpy(tb_vector_data(storage_new->codes), gb_path_codes_data(impl), codes_size);
+    if (points_size) tb_memcpy(tb_vector_data(storage_new->points), gb_path_points_data(impl), points_size * sizeof(gb_point_t));
+
+    // update the storage
+    impl->storage = storage_new;
+    gb_path_storage_exit(storage);
+
+    // make the head of the current contour if the read-only data was wrapped
+    if (wrapped) gb_path_make_head(impl);
+
+    // ok
+    return tb_true;
+}
 static tb_size_t gb_path_itor_size(tb_iterator_ref_t iterator)
 {
     // check
     gb_path_impl_t* impl = (gb_path_impl_t*)iterator;
-    tb_assert_return_val(impl && impl->codes, 0);
+    tb_assert_return_val(impl, 0);
 
     // size
-    return tb_vector_size(impl->codes);
+    return gb_path_codes_size(impl);
 }
 static tb_size_t gb_path_itor_head(tb_iterator_ref_t iterator)
 {
@@ -131,18 +409,18 @@ static tb_size_t gb_path_itor_last(tb_iterator_ref_t iterator)
     tb_assert_return_val(impl, 0);
 
     // the last code index
-    tb_size_t code_last = tb_vector_size(impl->codes);
+    tb_size_t code_last = gb_path_codes_size(impl);
     if (code_last) code_last--;
     
     // the last code
-    tb_long_t code = (tb_long_t)tb_iterator_item(impl->codes, code_last);
+    tb_long_t code = (tb_long_t)gb_path_codes_last(impl);
     tb_assert(code >= 0 && code < GB_PATH_CODE_MAXN);
 
     // the last point step
     tb_size_t point_step = gb_path_point_step(code);
 
     // the last point index
-    tb_size_t point_last = tb_vector_size(impl->points);
+    tb_size_t point_last = gb_path_points_size(impl);
     if (point_last >= point_step) point_last -= point_step;
 
     // last
@@ -152,11 +430,11 @@ static tb_size_t gb_path_itor_tail(tb_iterator_ref_t iterator)
 {
     // check
     gb_path_impl_t* impl = (gb_path_impl_t*)iterator;
-    tb_assert_return_val(impl && impl->codes && impl->points, 0);
+    tb_assert_return_val(impl, 0);
 
     // the code and point tail
-    tb_size_t code_tail     = tb_vector_size(impl->codes);
-    tb_size_t point_tail    = tb_vector_size(impl->points);
+    tb_size_t code_tail     = gb_path_codes_size(impl);
+    tb_size_t point_tail    = gb_path_points_size(impl);
     tb_assert(code_tail <= TB_MAXU16 && point_tail <= TB_MAXU16);
 
     // tail
@@ -166,10 +444,10 @@ static tb_size_t gb_path_itor_next(tb_iterator_ref_t iterator, tb_size_t itor)
 {
     // check
     gb_path_impl_t* impl = (gb_path_impl_t*)iterator;
-    tb_assert_return_val(impl && impl->codes, 0);
+    tb_assert_return_val(impl, 0);
 
     // the code
-    tb_long_t code = (tb_long_t)tb_iterator_item(impl->codes, itor >> 16);
+    tb_long_t code = (tb_long_t)gb_path_codes_data(impl)[itor >> 16];
     tb_assert(code >= 0 && code < GB_PATH_CODE_MAXN);
 
     /* the next
@@ -183,13 +461,13 @@ static tb_size_t gb_path_itor_prev(tb_iterator_ref_t iterator, tb_size_t itor)
 {
     // check
     gb_path_impl_t* impl = (gb_path_impl_t*)iterator;
-    tb_assert_return_val(impl && impl->codes, 0);
+    tb_assert_return_val(impl, 0);
 
     // check the code index
     tb_assert(itor >> 16);
 
     // the code
-    tb_long_t code = (tb_size_t)tb_iterator_item(impl->codes, (itor >> 16) - 1);
+    tb_long_t code = (tb_long_t)gb_path_codes_data(impl)[(itor >> 16) - 1];
     tb_assert(code >= 0 && code < GB_PATH_CODE_MAXN);
 
     // check the point index
@@ -206,28 +484,88 @@ static tb_pointer_t gb_path_itor_item(tb_iterator_ref_t iterator, tb_size_t itor
 {
     // check
     gb_path_impl_t* impl = (gb_path_impl_t*)iterator;
-    tb_assert_return_val(impl && impl->codes && impl->points, tb_null);
+    tb_assert_return_val(impl, tb_null);
     
     // the code and point index
     tb_size_t code_index    = itor >> 16;
     tb_size_t point_index   = itor & 0xffff;
 
     // the code
-    tb_size_t code = (tb_size_t)tb_iterator_item(impl->codes, code_index);
+    tb_size_t code = gb_path_codes_data(impl)[code_index];
     tb_assert(code < 1 || point_index);
 
     // init item
     impl->item.code     = code;
-    impl->item.points   = (gb_point_ref_t)tb_iterator_item(impl->points, code < 1? point_index : point_index - 1);
+    impl->item.points   = gb_path_points_data(impl) + (code < 1? point_index : point_index - 1);
     tb_assert(impl->item.points);
 
     // data
     return &impl->item;
 }
+static gb_path_impl_t* gb_path_init_impl(tb_noarg_t)
+{
+    // make path
+    gb_path_impl_t* impl = tb_malloc0_type(gb_path_impl_t);
+    tb_assert_and_check_return_val(impl, tb_null);
+
+    // init hint
+    impl->hint.type = GB_SHAPE_TYPE_NONE;
+
+    // init flag
+    impl->flag = GB_PATH_FLAG_DIRTY_ALL | GB_PATH_FLAG_CLOSED | GB_PATH_FLAG_SINGLE;
+
+    // init iterator
+    impl->itor.mode = TB_ITERATOR_MODE_FORWARD | TB_ITERATOR_MODE_REVERSE | TB_ITERATOR_MODE_READONLY;
+    impl->itor.priv = tb_null;
+    impl->itor.step = sizeof(gb_path_item_t);
+    impl->itor.size = gb_path_itor_size;
+    impl->itor.head = gb_path_itor_head;
+    impl->itor.last = gb_path_itor_last;
+    impl->itor.tail = gb_path_itor_tail;
+    impl->itor.next = gb_path_itor_next;
+    impl->itor.prev = gb_path_itor_prev;
+    impl->itor.item = gb_path_itor_item;
+
+    // init polygons, no polygon is made
+    tb_size_t i = 0;
+    for (i = 0; i < GB_PATH_POLYGON_CACHE_MAXN; i++) impl->polygons[i].level = GB_PATH_POLYGON_LEVEL_NONE;
+
+    // ok
+    return impl;
+}
+static tb_void_t gb_path_mark_appended(gb_path_impl_t* impl)
+{
+    // check
+    tb_assert(impl && impl->storage && impl->storage->codes && impl->storage->points);
+
+    // the contours before the appended code are not modified
+    tb_size_t code_index = tb_vector_size(impl->storage->codes);
+    if (code_index < impl->polygons_dirty) impl->polygons_dirty = code_index;
+
+    // the bounds have been made? only grow it for the appended points
+    if (!(impl->flag & GB_PATH_FLAG_DIRTY_BOUNDS)) impl->bounds_count = tb_vector_size(impl->storage->points);
+
+    // mark dirty
+    impl->flag |= GB_PATH_FLAG_DIRTY_ALL;
+}
+static tb_void_t gb_path_mark_modified(gb_path_impl_t* impl, tb_size_t code_index)
+{
+    // check
+    tb_assert(impl);
+
+    // the contours before the modified code are not modified
+    if (code_index < impl->polygons_dirty) impl->polygons_dirty = code_index;
+
+    // the bounds need be remade from all points
+    impl->bounds_count = 0;
+
+    // mark dirty
+    impl->flag |= GB_PATH_FLAG_DIRTY_ALL;
+}
 static tb_bool_t gb_path_make_hint(gb_path_impl_t* impl)
 { 
     // check
-    tb_assert_and_check_return_val(impl && impl->codes && impl->points, tb_false);
+    tb_assert_and_check_return_val(impl, tb_false);
 
     // clear hint first
     impl->hint.type = GB_SHAPE_TYPE_NONE;
@@ -236,15 +574,15 @@ static tb_bool_t gb_path_make_hint(gb_path_impl_t* impl)
     if (!(impl->flag & GB_PATH_FLAG_CURVE))
     {
         // the codes 
-        tb_uint8_t const* codes = (tb_uint8_t const*)tb_vector_data(impl->codes);
+        tb_uint8_t const* codes = gb_path_codes_data(impl);
         tb_assert_and_check_return_val(codes, tb_false);
 
         // the points 
-        gb_point_ref_t points = (gb_point_ref_t)tb_vector_data(impl->points);
+        gb_point_ref_t points = gb_path_points_data(impl);
         tb_assert_and_check_return_val(points, tb_false);
 
         // the points count
-        tb_size_t count = tb_vector_size(impl->points);
+        tb_size_t count = gb_path_points_size(impl);
 
         // rect?
         if (    count == 5
@@ -329,7 +667,7 @@ static tb_bool_t gb_path_make_hint(gb_path_impl_t* impl)
 static tb_bool_t gb_path_make_convex(gb_path_impl_t* impl)
 {
     // check
-    tb_assert_and_check_return_val(impl && impl->codes && impl->points, tb_false);
+    tb_assert_and_check_return_val(impl, tb_false);
 
     // clear convex first
     impl->flag &= ~GB_PATH_FLAG_CONVEX;
@@ -357,7 +695,7 @@ static tb_bool_t gb_path_make_convex(gb_path_impl_t* impl)
     if (    !(impl->flag & GB_PATH_FLAG_CONVEX) 
         &&  (impl->flag & GB_PATH_FLAG_SINGLE)
         &&  (impl->flag & GB_PATH_FLAG_CLOSED)
-        &&  tb_vector_size(impl->codes) > 3)
+        &&  gb_path_codes_size(impl) > 3)
     {
         // init flag first
         impl->flag |= GB_PATH_FLAG_CONVEX;
@@ -524,10 +862,10 @@ static tb_bool_t gb_path_make_convex(gb_path_impl_t* impl)
             case GB_PATH_CODE_CLOS:
                 {
                     // the points
-                    gb_point_ref_t points = (gb_point_ref_t)tb_vector_data(impl->points);
+                    gb_point_ref_t points = gb_path_points_data(impl);
 
                     // check
-                    tb_assert(points && tb_vector_size(impl->points) > 1);
+                    tb_assert(points && gb_path_points_size(impl) > 1);
                     tb_assert(points[0].x == item->points[0].x && points[0].y == item->points[0].y);
 
                     // update the points
@@ -594,83 +932,108 @@ static tb_void_t gb_path_make_quad_for_add_arc(gb_point_ref_t ctrl, gb_point_ref
     // append point
     ctrl? gb_path_quad_to((gb_path_ref_t)priv, ctrl, point) : gb_path_move_to((gb_path_ref_t)priv, point);
 }
-static tb_void_t gb_path_make_line_for_curve_to(gb_point_ref_t point, tb_cpointer_t priv)
+static tb_long_t gb_path_polygon_level(gb_matrix_ref_t matrix)
 {
-    // check
-    tb_value_t* values = (tb_value_t*)priv;
-    tb_assert(values && point);
+    // no matrix? the scale is one
+    tb_check_return_val(matrix, 0);
 
-    // the polygon points
-    tb_vector_ref_t polygon_points = (tb_vector_ref_t)values[0].ptr;
-    tb_assert(polygon_points);
+    /* the approximate scale of the matrix
+     *
+     * the scaled length of the vector is not larger than it for the L-infinity distance
+     */
+    gb_float_t sx = gb_abs(matrix->sx) + gb_abs(matrix->kx);
+    gb_float_t sy = gb_abs(matrix->ky) + gb_abs(matrix->sy);
+    gb_float_t scale = tb_max(sx, sy);
 
-    // append point
-    tb_vector_insert_tail(polygon_points, point);
+    // the scale level: 2^(level - 1) < scale <= 2^level
+    tb_long_t level = 0;
+    for (; scale > GB_ONE && level < GB_PATH_POLYGON_LEVEL_MAXN; level++) scale = gb_half(scale);
+    for (; scale <= GB_HALF && level > -GB_PATH_POLYGON_LEVEL_MAXN; level--) scale = gb_lsh(scale, 1);
 
-    // update the points count
-    values[1].u16++;
+    // ok
+    return level;
 }
-static tb_bool_t gb_path_make_python(gb_path_impl_t* impl)
+static tb_bool_t gb_path_make_python(gb_path_impl_t* impl, gb_path_polygon_cache_t* cache, tb_long_t level)
 { 
     // check
-    tb_assert_and_check_return_val(impl && impl->codes && impl->points, tb_false);
+    tb_assert_and_check_return_val(impl && cache, tb_false);
 
     // make polygon counts
-    if (!impl->polygon_counts) impl->polygon_counts = tb_vector_init(8, tb_element_uint16());
-    tb_assert_and_check_return_val(impl->polygon_counts, tb_false);
+    if (!cache->counts) cache->counts = tb_vector_init(8, tb_element_uint32());
+    tb_assert_and_check_return_val(cache->counts, tb_false);
+
+    /* remove the counts of the last flattened contour and the tail count, 
+     * the previous contours are not modified and need not be flattened again
+     */
+    if (!tb_vector_resize(cache->counts, cache->contour_count)) return tb_false;
 
     // have curve?
     if (impl->flag & GB_PATH_FLAG_CURVE)
     {
         // make polygon points
-        if (!impl->polygon_points) impl->polygon_points = tb_vector_init(tb_vector_size(impl->points), tb_element_mem(sizeof(gb_point_t), tb_null, tb_null));
-        tb_assert_and_check_return_val(impl->polygon_points, tb_false);
+        if (!cache->points) cache->points = tb_vector_init(gb_path_points_size(impl), tb_element_mem(sizeof(gb_point_t), tb_null, tb_null));
+        tb_assert_and_check_return_val(cache->points, tb_false);
 
-        // clear polygon points and counts
-        tb_vector_clear(impl->polygon_points);
-        tb_vector_clear(impl->polygon_counts);
+        // remove the points of the last flattened contour
+        if (!tb_vector_resize(cache->points, cache->contour_size)) return tb_false;
 
-        // init values
-        tb_value_t values[2];
-        values[0].ptr = impl->polygon_points;
-        values[1].u16 = 0;
+        // the scale of this level
+        gb_float_t scale = level >= 0? gb_lsh(GB_ONE, level) : gb_rsh(GB_ONE, -level);
 
-        // done
-        tb_for_all_if (gb_path_item_ref_t, item, (gb_path_ref_t)impl, item)
+        // done, flatten it from the last flattened contour
+        tb_size_t   size = 0;
+        tb_uint32_t count = 0;
+        tb_for (gb_path_item_ref_t, item, (cache->contour_code << 16) | cache->contour_point, tb_iterator_tail((tb_iterator_ref_t)impl), (gb_path_ref_t)impl)
         {
             switch (item->code)
             {
             case GB_PATH_CODE_MOVE:
                 {
                     // append count
-                    if (values[1].u16) tb_vector_insert_tail(impl->polygon_counts, tb_u2p(values[1].u16));
+                    if (count) tb_vector_insert_tail(cache->counts, tb_u2p(count));
+
+                    // save the last contour
+                    cache->contour_code     = item_itor >> 16;
+                    cache->contour_point    = item_itor & 0xffff;
+                    cache->contour_size     = tb_vector_size(cache->points);
+                    cache->contour_count    = tb_vector_size(cache->counts);
 
                     // make point
-                    tb_vector_insert_tail(impl->polygon_points, &item->points[0]);
+                    tb_vector_insert_tail(cache->points, &item->points[0]);
 
                     // init the points count
-                    values[1].u16 = 1;
+                    count = 1;
                 }
                 break;
             case GB_PATH_CODE_LINE:
                 {
                     // make point
-                    tb_vector_insert_tail(impl->polygon_points, &item->points[1]);
+                    tb_vector_insert_tail(cache->points, &item->points[1]);
 
                     // update the points count
-                    values[1].u16++;
+                    count++;
                 }
                 break;
             case GB_PATH_CODE_QUAD:
                 {
-                    // make quad points
-                    gb_quad_make_line(item->points, gb_path_make_line_for_curve_to, values);
+                    // grow the polygon points for the divided lines
+                    tb_size_t divided = gb_quad_divide_line_count(item->points, scale);
+                    size = tb_vector_size(cache->points);
+                    if (!tb_vector_resize(cache->points, size + ((tb_size_t)1 << divided))) return tb_false;
+
+                    // make quad points to the polygon points directly
+                    count += (tb_uint32_t)gb_quad_make_line(item->points, divided, (gb_point_ref_t)tb_vector_data(cache->points) + size);
                 }
                 break;
             case GB_PATH_CODE_CUBIC:
                 {
-                    // make cubic points
-                    gb_cubic_make_line(item->points, gb_path_make_line_for_curve_to, values);
+                    // grow the polygon points for the divided lines
+                    tb_size_t divided = gb_cubic_divide_line_count(item->points, scale);
+                    size = tb_vector_size(cache->points);
+                    if (!tb_vector_resize(cache->points, size + ((tb_size_t)1 << divided))) return tb_false;
+
+                    // make cubic points to the polygon points directly
+                    count += (tb_uint32_t)gb_cubic_make_line(item->points, divided, (gb_point_ref_t)tb_vector_data(cache->points) + size);
                 }
                 break;
             case GB_PATH_CODE_CLOS:
@@ -680,65 +1043,111 @@ static tb_bool_t gb_path_make_python(gb_path_impl_t* impl)
         }
 
         // append the last count
-        if (values[1].u16)
-        {
-            tb_vector_insert_tail(impl->polygon_counts, tb_u2p(values[1].u16));
-            values[1].u16 = 0;
-        }
+        if (count) tb_vector_insert_tail(cache->counts, tb_u2p(count));
 
         // append the tail count
-        tb_vector_insert_tail(impl->polygon_counts, (tb_cpointer_t)0);
+        tb_vector_insert_tail(cache->counts, (tb_cpointer_t)0);
 
         // init polygon
-        impl->polygon.points = (gb_point_ref_t)tb_vector_data(impl->polygon_points);
-        impl->polygon.counts = (tb_uint16_t*)tb_vector_data(impl->polygon_counts);
+        cache->polygon.points = (gb_point_ref_t)tb_vector_data(cache->points);
+        cache->polygon.counts = (tb_uint32_t*)tb_vector_data(cache->counts);
     }
     // only move-to and line-to? using the points directly
     else
     {
-        // init polygon counts
-        tb_uint16_t count = 0;
-        tb_vector_clear(impl->polygon_counts);
-        tb_for_all (tb_long_t, code, impl->codes)
+        // init polygon counts, count them from the last flattened contour
+        tb_size_t           code = 0;
+        tb_uint32_t         count = 0;
+        tb_size_t           point = cache->contour_point;
+        tb_size_t           index = cache->contour_code;
+        tb_size_t           size = gb_path_codes_size(impl);
+        tb_uint8_t const*   codes = gb_path_codes_data(impl);
+        for (; index < size; index++)
         {
-            // check
-            tb_assert(code >= 0 && code < GB_PATH_CODE_MAXN);
+            // the code
+            code = codes[index];
+            tb_assert(code < GB_PATH_CODE_MAXN);
 
             // append count
             if (code == GB_PATH_CODE_MOVE) 
             {
-                if (count) tb_vector_insert_tail(impl->polygon_counts, tb_u2p(count));
+                if (count) tb_vector_insert_tail(cache->counts, tb_u2p(count));
                 count = 0;
+
+                // save the last contour
+                cache->contour_code     = index;
+                cache->contour_point    = point;
+                cache->contour_size     = point;
+                cache->contour_count    = tb_vector_size(cache->counts);
             }
 
             // update count
-            count += (tb_uint16_t)gb_path_point_step(code);
+            count += (tb_uint32_t)gb_path_point_step(code);
+            point += gb_path_point_step(code);
         }
 
         // append the last count
         if (count)
         {
-            tb_vector_insert_tail(impl->polygon_counts, tb_u2p(count));
+            tb_vector_insert_tail(cache->counts, tb_u2p(count));
             count = 0;
         }
 
         // append the tail count
-        tb_vector_insert_tail(impl->polygon_counts, (tb_cpointer_t)0);
+        tb_vector_insert_tail(cache->counts, (tb_cpointer_t)0);
 
         // init polygon
-        impl->polygon.points = (gb_point_ref_t)tb_vector_data(impl->points);
-        impl->polygon.counts = (tb_uint16_t*)tb_vector_data(impl->polygon_counts);
+        cache->polygon.points = gb_path_points_data(impl);
+        cache->polygon.counts = (tb_uint32_t*)tb_vector_data(cache->counts);
     }
 
     // check
-    tb_assert_and_check_return_val(impl->polygon.points && impl->polygon.counts, tb_false);
+    tb_assert_and_check_return_val(cache->polygon.points && cache->polygon.counts, tb_false);
+
+    // save the flattened mode
+    cache->curve = (impl->flag & GB_PATH_FLAG_CURVE)? 1 : 0;
 
     // is convex polygon?
-    impl->polygon.convex = gb_path_convex((gb_path_ref_t)impl);
+    cache->polygon.convex = gb_path_convex((gb_path_ref_t)impl);
 
     // ok
     return tb_true;
 }
+static tb_bool_t gb_path_data_check(gb_path_data_head_t const* head, tb_uint8_t const* codes, tb_uint32_t const* polygon_counts)
+{
+    // check
+    tb_assert_and_check_return_val(head && codes, tb_false);
+
+    // check the codes and the points stepped by them, the first code must be move-to
+    tb_size_t i = 0;
+    tb_size_t points = 0;
+    for (i = 0; i < head->codes_count; i++)
+    {
+        // the code
+        tb_size_t code = codes[i];
+        tb_check_return_val(code < GB_PATH_CODE_MAXN, tb_false);
+        tb_check_return_val(i || code == GB_PATH_CODE_MOVE, tb_false);
+
+        // step the points
+        points += gb_path_point_step(code);
+    }
+    tb_check_return_val(points == head->points_count, tb_false);
+
+    // no saved polygon? ok
+    tb_check_return_val((head->flag & GB_PATH_DATA_FLAG_POLYGON) && head->polygon_counts, tb_true);
+
+    // check the polygon level
+    tb_check_return_val(head->polygon_level >= -GB_PATH_POLYGON_LEVEL_MAXN && head->polygon_level <= GB_PATH_POLYGON_LEVEL_MAXN, tb_false);
+
+    // check the polygon counts, they must be non-zero and cover all polygon points before the tail count
+    tb_hize_t count = 0;
+    for (i = 0; i + 1 < head->polygon_counts; i++)
+    {
+        tb_check_return_val(polygon_counts[i], tb_false);
+        count += polygon_counts[i];
+    }
+    return count == (head->polygon_points? head->polygon_points : head->points_count);
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
@@ -751,34 +1160,12 @@ gb_path_ref_t gb_path_init()
     do
     {
         // make path
-        impl = tb_malloc0_type(gb_path_impl_t);
+        impl = gb_path_init_impl();
         tb_assert_and_check_break(impl);
 
-        // init hint
-        impl->hint.type = GB_SHAPE_TYPE_NONE;
-
-        // init flag
-        impl->flag = GB_PATH_FLAG_DIRTY_ALL | GB_PATH_FLAG_CLOSED | GB_PATH_FLAG_SINGLE;
-
-        // init codes
-        impl->codes = tb_vector_init(GB_PATH_POINTS_GROW >> 1, tb_element_uint8());
-        tb_assert_and_check_break(impl->codes);
-
-        // init points
-        impl->points = tb_vector_init(GB_PATH_POINTS_GROW, tb_element_mem(sizeof(gb_point_t), tb_null, tb_null));
-        tb_assert_and_check_break(impl->points);
-
-        // init iterator
-        impl->itor.mode = TB_ITERATOR_MODE_FORWARD | TB_ITERATOR_MODE_REVERSE | TB_ITERATOR_MODE_READONLY;
-        impl->itor.priv = tb_null;
-        impl->itor.step = sizeof(gb_path_item_t);
-        impl->itor.size = gb_path_itor_size;
-        impl->itor.head = gb_path_itor_head;
-        impl->itor.last = gb_path_itor_last;
-        impl->itor.tail = gb_path_itor_tail;
-        impl->itor.next = gb_path_itor_next;
-        impl->itor.prev = gb_path_itor_prev;
-        impl->itor.item = gb_path_itor_item;
+        // init storage
+        impl->storage = gb_path_storage_init();
+        tb_assert_and_check_break(impl->storage);
 
         // ok
         ok = tb_true;
@@ -796,27 +1183,141 @@ gb_path_ref_t gb_path_init()
     // ok?
     return (gb_path_ref_t)impl;
 }
+gb_path_ref_t gb_path_init_from_data(tb_byte_t const* data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(data && size >= sizeof(gb_path_data_head_t), tb_null);
+    tb_assert_and_check_return_val(!((tb_size_t)data & (GB_PATH_DATA_ALIGN - 1)), tb_null);
+
+    // the head
+    gb_path_data_head_t const* head = (gb_path_data_head_t const*)data;
+
+    // check the head
+    if (head->magic != GB_PATH_DATA_MAGIC || head->version != GB_PATH_DATA_VERSION)
+    {
+        // trace
+        tb_trace_e("invalid path data: magic: %x, version: %u", head->magic, head->version);
+        return tb_null;
+    }
+
+    // check the float type
+#ifdef GB_CONFIG_FLOAT_FIXED
+    if (!head->fixed)
+#else
+    if (head->fixed)
+#endif
+    {
+        // trace
+        tb_trace_e("the path data is saved for the other float type!");
+        return tb_null;
+    }
+
+    // check the codes and points count for the path iterator
+    tb_assert_and_check_return_val(head->codes_count <= TB_MAXU16 && head->points_count <= TB_MAXU16, tb_null);
+    tb_assert_and_check_return_val(!head->codes_count == !head->points_count, tb_null);
+
+    // check the polygon counts and points 
+    tb_size_t left = size - sizeof(gb_path_data_head_t);
+    tb_assert_and_check_return_val(head->polygon_counts <= left / sizeof(tb_uint32_t), tb_null);
+    tb_assert_and_check_return_val(head->polygon_points <= left / sizeof(gb_point_t), tb_null);
+
+    // check the data size
+    tb_size_t codes_size            = tb_align4(head->codes_count);
+    tb_size_t points_size           = head->points_count * sizeof(gb_point_t);
+    tb_size_t polygon_counts_size   = head->polygon_counts * sizeof(tb_uint32_t);
+    tb_size_t polygon_points_size   = head->polygon_points * sizeof(gb_point_t);
+    tb_assert_and_check_return_val(codes_size + points_size + polygon_counts_size + polygon_points_size <= left, tb_null);
+
+    // check the tail count of the saved polygon
+    tb_uint32_t const* polygon_counts = (tb_uint32_t const*)(data + sizeof(gb_path_data_head_t) + codes_size + points_size);
+    tb_assert_and_check_return_val(!head->polygon_counts || !polygon_counts[head->polygon_counts - 1], tb_null);
+
+    // check the codes, points and the saved polygon
+    if (!gb_path_data_check(head, data + sizeof(gb_path_data_head_t), polygon_counts))
+    {
+        // trace
+        tb_trace_e("invalid path data: codes: %u, points: %u, polygon: %u, %u", head->codes_count, head->points_count, head->polygon_counts, head->polygon_points);
+        return tb_null;
+    }
+
+    // make storage
+    gb_path_storage_t* storage = tb_malloc0_type(gb_path_storage_t);
+    tb_assert_and_check_return_val(storage, tb_null);
+
+    // init reference count
+    tb_atomic_set(&storage->refn, 1);
+
+    // wrap the codes and points
+    data += sizeof(gb_path_data_head_t);
+    storage->data_codes         = data;
+    storage->data_codes_count   = head->codes_count;
+    data += codes_size;
+    storage->data_points        = (gb_point_ref_t)data;
+    storage->data_points_count  = head->points_count;
+    data += points_size;
+
+    // make path
+    gb_path_impl_t* impl = gb_path_init_impl();
+    if (!impl)
+    {
+        gb_path_storage_exit(storage);
+        return tb_null;
+    }
+
+    // init storage
+    impl->storage = storage;
+
+    // skip the polygon counts
+    data += polygon_counts_size;
+
+    // init flag, the convex has been made
+    impl->flag = (head->path_flag & GB_PATH_FLAG_DATA_MASK) | GB_PATH_FLAG_DIRTY_HINT;
+
+    // init bounds
+    if (head->flag & GB_PATH_DATA_FLAG_BOUNDS) impl->bounds = head->bounds;
+    else impl->flag |= GB_PATH_FLAG_DIRTY_BOUNDS;
+
+    // wrap the saved polygon
+    if ((head->flag & GB_PATH_DATA_FLAG_POLYGON) && head->polygon_counts)
+    {
+        // the polygon cache, the vectors are made when the path is modified
+        gb_path_polygon_cache_t* cache = &impl->polygons[0];
+        cache->polygon.counts   = (tb_uint32_t*)polygon_counts;
+        cache->polygon.points   = head->polygon_points? (gb_point_ref_t)data : storage->data_points;
+        cache->polygon.convex   = (impl->flag & GB_PATH_FLAG_CONVEX)? tb_true : tb_false;
+        cache->level            = head->polygon_level;
+        cache->curve            = (impl->flag & GB_PATH_FLAG_CURVE)? 1 : 0;
+
+        // no dirty polygon
+        impl->polygons_dirty = TB_MAXU32;
+    }
+    else impl->flag |= GB_PATH_FLAG_DIRTY_POLYGON;
+
+    // ok
+    return (gb_path_ref_t)impl;
+}
 tb_void_t gb_path_exit(gb_path_ref_t path)
 {
     // check
     gb_path_impl_t* impl = (gb_path_impl_t*)path;
     tb_assert_and_check_return(impl);
 
-    // exit polygon points
-    if (impl->polygon_points) tb_vector_exit(impl->polygon_points);
-    impl->polygon_points = tb_null;
-
-    // exit polygon counts
-    if (impl->polygon_counts) tb_vector_exit(impl->polygon_counts);
-    impl->polygon_counts = tb_null;
+    // exit polygons
+    tb_size_t i = 0;
+    for (i = 0; i < GB_PATH_POLYGON_CACHE_MAXN; i++)
+    {
+        // exit polygon points
+        if (impl->polygons[i].points) tb_vector_exit(impl->polygons[i].points);
+        impl->polygons[i].points = tb_null;
 
-    // exit points
-    if (impl->points) tb_vector_exit(impl->points);
-    impl->points = tb_null;
+        // exit polygon counts
+        if (impl->polygons[i].counts) tb_vector_exit(impl->polygons[i].counts);
+        impl->polygons[i].counts = tb_null;
+    }
 
-    // exit codes
-    if (impl->codes) tb_vector_exit(impl->codes);
-    impl->codes = tb_null;
+    // exit storage
+    if (impl->storage) gb_path_storage_exit(impl->storage);
+    impl->storage = tb_null;
 
     // exit it
     tb_free(impl);
@@ -825,24 +1326,39 @@ tb_void_t gb_path_clear(gb_path_ref_t path)
 {
     // check
     gb_path_impl_t* impl = (gb_path_impl_t*)path;
-    tb_assert_and_check_return(impl && impl->codes && impl->points);
+    tb_assert_and_check_return(impl && impl->storage);
 
     // mark dirty
     impl->flag = GB_PATH_FLAG_DIRTY_ALL | GB_PATH_FLAG_SINGLE;
+    gb_path_mark_modified(impl, 0);
+
+    // the storage is shared or only wraps the read-only data? use a new empty storage instead of copying it
+    gb_path_storage_t* storage = impl->storage;
+    if (!storage->codes || tb_atomic_get(&storage->refn) > 1)
+    {
+        // make a new storage
+        gb_path_storage_t* storage_new = gb_path_storage_init();
+        tb_assert_and_check_return(storage_new);
 
-    // clear codes
-    tb_vector_clear(impl->codes);
+        // update the storage
+        impl->storage = storage_new;
+        gb_path_storage_exit(storage);
+    }
+    else
+    {
+        // clear codes
+        tb_vector_clear(storage->codes);
 
-    // clear points
-    tb_vector_clear(impl->points);
+        // clear points
+        tb_vector_clear(storage->points);
+    }
 }
 tb_void_t gb_path_copy(gb_path_ref_t path, gb_path_ref_t copied)
 {
     // check
     gb_path_impl_t* impl        = (gb_path_impl_t*)path;
     gb_path_impl_t* impl_copied = (gb_path_impl_t*)copied;
-    tb_assert_and_check_return(impl && impl->codes && impl->points);
-    tb_assert_and_check_return(impl_copied && impl_copied->codes && impl_copied->points);
+    tb_assert_and_check_return(impl && impl->storage && impl_copied && impl_copied->storage);
 
     // null? clear it
     if (gb_path_null(copied)) 
@@ -851,15 +1367,21 @@ tb_void_t gb_path_copy(gb_path_ref_t path, gb_path_ref_t copied)
         return ;
     }
 
-    // copy codes
-    tb_vector_copy(impl->codes, impl_copied->codes);
-
-    // copy points
-    tb_vector_copy(impl->points, impl_copied->points);
+    // share the storage of the copied path, it will be copied when one of them is modified
+    if (impl->storage != impl_copied->storage)
+    {
+        tb_atomic_fetch_and_inc(&impl_copied->storage->refn);
+        gb_path_storage_exit(impl->storage);
+        impl->storage = impl_copied->storage;
+    }
 
     // copy flag
     impl->flag = impl_copied->flag | GB_PATH_FLAG_DIRTY_POLYGON;
 
+    // all polygons need be remade
+    impl->polygons_dirty = 0;
+    impl->bounds_count = 0;
+
     // copy hint
     impl->hint = impl_copied->hint;
 
@@ -869,20 +1391,110 @@ tb_void_t gb_path_copy(gb_path_ref_t path, gb_path_ref_t copied)
     // copy bounds
     impl->bounds = impl_copied->bounds;
 }
+tb_size_t gb_path_save(gb_path_ref_t path, tb_byte_t* data, tb_size_t maxn, tb_size_t flag)
+{
+    // check
+    gb_path_impl_t* impl = (gb_path_impl_t*)path;
+    tb_assert_and_check_return_val(impl, 0);
+
+    // init head
+    gb_path_data_head_t head;
+    tb_memset(&head, 0, sizeof(gb_path_data_head_t));
+    head.magic          = GB_PATH_DATA_MAGIC;
+    head.version        = GB_PATH_DATA_VERSION;
+    head.flag           = (tb_uint8_t)(flag & (GB_PATH_DATA_FLAG_BOUNDS | GB_PATH_DATA_FLAG_POLYGON));
+    head.codes_count    = (tb_uint32_t)gb_path_codes_size(impl);
+    head.points_count   = (tb_uint32_t)gb_path_points_size(impl);
+#ifdef GB_CONFIG_FLOAT_FIXED
+    head.fixed          = 1;
+#endif
+
+    // make convex first, it is saved in the path flag
+    gb_path_convex(path);
+    head.path_flag = impl->flag & GB_PATH_FLAG_DATA_MASK;
+
+    // save bounds?
+    if (head.flag & GB_PATH_DATA_FLAG_BOUNDS)
+    {
+        gb_rect_ref_t bounds = gb_path_bounds(path);
+        if (bounds) head.bounds = *bounds;
+        else head.flag &= ~GB_PATH_DATA_FLAG_BOUNDS;
+    }
+
+    // save polygon?
+    gb_polygon_ref_t polygon = tb_null;
+    if (head.flag & GB_PATH_DATA_FLAG_POLYGON)
+    {
+        // make polygon for the scale one
+        polygon = gb_path_polygon(path);
+        if (polygon)
+        {
+            // the counts count and points count
+            tb_uint32_t const*  counts = polygon->counts;
+            tb_uint32_t         points = 0;
+            while (*counts) points += *counts++;
+            head.polygon_level  = 0;
+            head.polygon_counts = (tb_uint32_t)(counts - polygon->counts) + 1;
+            head.polygon_points = (impl->flag & GB_PATH_FLAG_CURVE)? points : 0;
+        }
+        else head.flag &= ~GB_PATH_DATA_FLAG_POLYGON;
+    }
+
+    // the data size
+    tb_size_t codes_size            = tb_align4(head.codes_count);
+    tb_size_t points_size           = head.points_count * sizeof(gb_point_t);
+    tb_size_t polygon_counts_size   = head.polygon_counts * sizeof(tb_uint32_t);
+    tb_size_t polygon_points_size   = head.polygon_points * sizeof(gb_point_t);
+    tb_size_t size                  = sizeof(gb_path_data_head_t) + codes_size + points_size + polygon_counts_size + polygon_points_size;
+
+    // only get the data size?
+    tb_check_return_val(data, size);
+
+    // check
+    tb_assert_and_check_return_val(maxn >= size && !((tb_size_t)data & (GB_PATH_DATA_ALIGN - 1)), 0);
+
+    // save head
+    tb_memcpy(data, &head, sizeof(gb_path_data_head_t));
+    data += sizeof(gb_path_data_head_t);
+
+    // save codes and pad them
+    if (head.codes_count) tb_memcpy(data, gb_path_codes_data(impl), head.codes_count);
+    tb_memset(data + head.codes_count, 0, codes_size - head.codes_count);
+    data += codes_size;
+
+    // save points
+    if (points_size) tb_memcpy(data, gb_path_points_data(impl), points_size);
+    data += points_size;
+
+    // save polygon
+    if (polygon)
+    {
+        // save counts
+        tb_memcpy(data, polygon->counts, polygon_counts_size);
+        data += polygon_counts_size;
+
+        // save points
+        if (polygon_points_size) tb_memcpy(data, polygon->points, polygon_points_size);
+        data += polygon_points_size;
+    }
+
+    // ok
+    return size;
+}
 tb_bool_t gb_path_null(gb_path_ref_t path)
 {
     // check
     gb_path_impl_t* impl = (gb_path_impl_t*)path;
-    tb_assert_and_check_return_val(impl && impl->codes, tb_true);
+    tb_assert_and_check_return_val(impl, tb_true);
 
     // null?
-    return tb_vector_size(impl->codes)? tb_false : tb_true;
+    return gb_path_codes_size(impl)? tb_false : tb_true;
 }
 gb_rect_ref_t gb_path_bounds(gb_path_ref_t path)
 {
     // check
     gb_path_impl_t* impl = (gb_path_impl_t*)path;
-    tb_assert_and_check_return_val(impl && impl->points, tb_null);
+    tb_assert_and_check_return_val(impl, tb_null);
 
     // null?
     if (gb_path_null(path)) return tb_null;
@@ -941,14 +1553,29 @@ gb_rect_ref_t gb_path_bounds(gb_path_ref_t path)
         if (impl->flag & GB_PATH_FLAG_DIRTY_BOUNDS)
         {
             // the points
-            gb_point_ref_t points = (gb_point_ref_t)tb_vector_data(impl->points);
+            gb_point_ref_t points = gb_path_points_data(impl);
             tb_assert_and_check_return_val(points, tb_null);
 
-            // make bounds
-            gb_bounds_make(&impl->bounds, points, tb_vector_size(impl->points));
+            // the points count
+            tb_size_t count = gb_path_points_size(impl);
 
-            // trace
-            tb_trace_d("make: bounds: %{rect} from points", &impl->bounds);
+            // only the points are appended? grow bounds for them
+            if (impl->bounds_count && impl->bounds_count <= count)
+            {
+                // grow bounds
+                gb_bounds_grow(&impl->bounds, points + impl->bounds_count, count - impl->bounds_count);
+
+                // trace
+                tb_trace_d("make: bounds: %{rect} from %lu appended points", &impl->bounds, count - impl->bounds_count);
+            }
+            else
+            {
+                // make bounds
+                gb_bounds_make(&impl->bounds, points, count);
+
+                // trace
+                tb_trace_d("make: bounds: %{rect} from points", &impl->bounds);
+            }
 
             // remove dirty
             impl->flag &= ~GB_PATH_FLAG_DIRTY_BOUNDS;
@@ -1000,8 +1627,9 @@ tb_bool_t gb_path_last(gb_path_ref_t path, gb_point_ref_t point)
     tb_assert_and_check_return_val(impl && point, tb_false);
 
     // the last point
-    gb_point_ref_t last = tb_null;
-    if (tb_vector_size(impl->points)) last = (gb_point_ref_t)tb_vector_last(impl->points);
+    gb_point_ref_t  last = tb_null;
+    tb_size_t       count = gb_path_points_size(impl);
+    if (count) last = gb_path_points_data(impl) + count - 1;
 
     // save it
     if (last) *point = *last;
@@ -1015,13 +1643,27 @@ tb_void_t gb_path_last_set(gb_path_ref_t path, gb_point_ref_t point)
     gb_path_impl_t* impl = (gb_path_impl_t*)path;
     tb_assert_and_check_return(impl && point);
 
+    // make the path writable
+    if (!gb_path_storage_detach(impl)) return ;
+
     // the last point
     gb_point_ref_t last = tb_null;
-    if (tb_vector_size(impl->points)) last = (gb_point_ref_t)tb_vector_last(impl->points);
+    if (tb_vector_size(impl->storage->points)) last = (gb_point_ref_t)tb_vector_last(impl->storage->points);
     tb_assert(last);
 
     // save it
-    if (last) *last = *point;
+    if (last) 
+    {
+        // the code index of the last point, the close code has no point
+        tb_size_t code_index = tb_vector_size(impl->storage->codes) - 1;
+        if (code_index && tb_vector_last(impl->storage->codes) == (tb_cpointer_t)GB_PATH_CODE_CLOS) code_index--;
+
+        // mark the last contour modified
+        gb_path_mark_modified(impl, code_index);
+
+        // save it
+        *last = *point;
+    }
 }
 gb_shape_ref_t gb_path_hint(gb_path_ref_t path)
 {
@@ -1046,6 +1688,10 @@ gb_shape_ref_t gb_path_hint(gb_path_ref_t path)
     return impl->hint.type != GB_SHAPE_TYPE_NONE? &impl->hint : tb_null;
 }
 gb_polygon_ref_t gb_path_polygon(gb_path_ref_t path)
+{
+    return gb_path_polygon_for_matrix(path, tb_null);
+}
+gb_polygon_ref_t gb_path_polygon_for_matrix(gb_path_ref_t path, gb_matrix_ref_t matrix)
 {
     // check
     gb_path_impl_t* impl = (gb_path_impl_t*)path;
@@ -1054,51 +1700,127 @@ gb_polygon_ref_t gb_path_polygon(gb_path_ref_t path)
     // null?
     if (gb_path_null(path)) return tb_null;
 
-    // polygon dirty? remake it
+    // polygon dirty? update all cached polygons
+    tb_size_t i = 0;
     if (impl->flag & GB_PATH_FLAG_DIRTY_POLYGON)
     {
-        // make polygon
-        if (!gb_path_make_python(impl)) return tb_null; 
+        // done
+        gb_path_polygon_cache_t* cache = tb_null;
+        for (i = 0; i < GB_PATH_POLYGON_CACHE_MAXN; i++)
+        {
+            // the cache
+            cache = &impl->polygons[i];
+            tb_check_continue(cache->level != GB_PATH_POLYGON_LEVEL_NONE);
+
+            /* the flattened contours have been modified or the first curve is added? clear it
+             *
+             * otherwise, only the last flattened contour is modified or some contours are appended,
+             * we need only flatten them again
+             */
+            if (impl->polygons_dirty < cache->contour_code || (!cache->curve && (impl->flag & GB_PATH_FLAG_CURVE)))
+                cache->level = GB_PATH_POLYGON_LEVEL_NONE;
+            else cache->dirty = 1;
+        }
 
         // remove dirty
+        impl->polygons_dirty = TB_MAXU32;
         impl->flag &= ~GB_PATH_FLAG_DIRTY_POLYGON;
     }
 
+    // the scale level, only the curves need be flattened for the scale
+    tb_long_t level = (impl->flag & GB_PATH_FLAG_CURVE)? gb_path_polygon_level(matrix) : 0;
+
+    // find the polygon of this level, otherwise reuse the least recently used polygon
+    gb_path_polygon_cache_t* cache = &impl->polygons[0];
+    for (i = 0; i < GB_PATH_POLYGON_CACHE_MAXN; i++)
+    {
+        // found?
+        if (impl->polygons[i].level == level)
+        {
+            cache = &impl->polygons[i];
+            break;
+        }
+
+        // the least recently used or unused polygon
+        if (impl->polygons[i].time < cache->time) cache = &impl->polygons[i];
+    }
+
+    // not found? make it
+    if (cache->level != level)
+    {
+        // make polygon from the first contour
+        cache->level            = GB_PATH_POLYGON_LEVEL_NONE;
+        cache->contour_code     = 0;
+        cache->contour_point    = 0;
+        cache->contour_size     = 0;
+        cache->contour_count    = 0;
+        if (!gb_path_make_python(impl, cache, level)) return tb_null; 
+
+        // save the level
+        cache->level = level;
+        cache->dirty = 0;
+    }
+    // dirty? make the modified and appended contours
+    else if (cache->dirty)
+    {
+        // make polygon from the last flattened contour
+        if (!gb_path_make_python(impl, cache, level)) 
+        {
+            cache->level = GB_PATH_POLYGON_LEVEL_NONE;
+            return tb_null; 
+        }
+
+        // remove dirty
+        cache->dirty = 0;
+    }
+
+    // update the used time
+    cache->time = ++impl->polygons_time;
+
     // ok?
-    return &impl->polygon;
+    return &cache->polygon;
 }
 tb_void_t gb_path_apply(gb_path_ref_t path, gb_matrix_ref_t matrix)
 {
     // check
     gb_path_impl_t* impl = (gb_path_impl_t*)path;
-    tb_assert_and_check_return(impl && impl->points && matrix);
+    tb_assert_and_check_return(impl && matrix);
 
     // empty?
     tb_check_return(!gb_path_null(path));
 
+    // make the path writable
+    if (!gb_path_storage_detach(impl)) return ;
+
     // done
-    tb_for_all_if (gb_point_ref_t, point, impl->points, point)
+    tb_for_all_if (gb_point_ref_t, point, impl->storage->points, point)
     {
         // apply it
         gb_point_apply(point, matrix);
     }
+
+    // mark all contours modified
+    gb_path_mark_modified(impl, 0);
 }
 tb_void_t gb_path_clos(gb_path_ref_t path)
 {
     // check
     gb_path_impl_t* impl = (gb_path_impl_t*)path;
-    tb_assert_and_check_return(impl && impl->codes && impl->points);
+    tb_assert_and_check_return(impl);
 
     // close it for avoiding be double closed
-    if (tb_vector_size(impl->points) > 2 && tb_vector_size(impl->codes) && tb_vector_last(impl->codes) != (tb_cpointer_t)GB_PATH_CODE_CLOS) 
+    if (gb_path_points_size(impl) > 2 && gb_path_codes_size(impl) && gb_path_codes_last(impl) != GB_PATH_CODE_CLOS) 
     {
+        // make the path writable
+        if (!gb_path_storage_detach(impl)) return ;
+
         // patch a line segment if the current point is not equal to the first point of the contour
         gb_point_t last = {0};
         if (gb_path_last(path, &last) && (last.x != impl->head.x || last.y != impl->head.y))
             gb_path_line_to(path, &impl->head);
 
         // append code
-        tb_vector_insert_tail(impl->codes, (tb_cpointer_t)GB_PATH_CODE_CLOS);
+        tb_vector_insert_tail(impl->storage->codes, (tb_cpointer_t)GB_PATH_CODE_CLOS);
     }
 
     // mark closed
@@ -1108,25 +1830,34 @@ tb_void_t gb_path_move_to(gb_path_ref_t path, gb_point_ref_t point)
 {
     // check
     gb_path_impl_t* impl = (gb_path_impl_t*)path;
-    tb_assert_and_check_return(impl && impl->codes && impl->points && point);
+    tb_assert_and_check_return(impl && point);
+
+    // make the path writable
+    if (!gb_path_storage_detach(impl)) return ;
 
     // replace the last point for avoiding one lone move-to point
-    if (tb_vector_size(impl->codes) && tb_vector_last(impl->codes) == (tb_cpointer_t)GB_PATH_CODE_MOVE) 
+    if (tb_vector_size(impl->storage->codes) && tb_vector_last(impl->storage->codes) == (tb_cpointer_t)GB_PATH_CODE_MOVE) 
     {
+        // mark the last contour modified
+        gb_path_mark_modified(impl, tb_vector_size(impl->storage->codes) - 1);
+
         // replace point
-        tb_vector_replace_last(impl->points, point);
+        tb_vector_replace_last(impl->storage->points, point);
     }
     // move-to
     else
     {
+        // mark appended
+        gb_path_mark_appended(impl);
+
         // append code
-        tb_vector_insert_tail(impl->codes, (tb_cpointer_t)GB_PATH_CODE_MOVE);
+        tb_vector_insert_tail(impl->storage->codes, (tb_cpointer_t)GB_PATH_CODE_MOVE);
 
         // append point
-        tb_vector_insert_tail(impl->points, point);
+        tb_vector_insert_tail(impl->storage->points, point);
 
         // clear single if the contour count > 1
-        if (tb_vector_size(impl->codes) > 1) impl->flag &= ~GB_PATH_FLAG_SINGLE;
+        if (tb_vector_size(impl->storage->codes) > 1) impl->flag &= ~GB_PATH_FLAG_SINGLE;
     }
 
     // save point
@@ -1134,9 +1865,6 @@ tb_void_t gb_path_move_to(gb_path_ref_t path, gb_point_ref_t point)
 
     // clear closed
     impl->flag &= ~GB_PATH_FLAG_CLOSED;
-
-    // mark dirty
-    impl->flag |= GB_PATH_FLAG_DIRTY_ALL;
 }
 tb_void_t gb_path_move2_to(gb_path_ref_t path, gb_float_t x, gb_float_t y)
 {
@@ -1160,7 +1888,10 @@ tb_void_t gb_path_line_to(gb_path_ref_t path, gb_point_ref_t point)
 {
     // check
     gb_path_impl_t* impl = (gb_path_impl_t*)path;
-    tb_assert_and_check_return(impl && impl->codes && impl->points && point);
+    tb_assert_and_check_return(impl && point);
+
+    // make the path writable
+    if (!gb_path_storage_detach(impl)) return ;
 
     // closed? patch one move-to point first using the last point
     if (impl->flag & GB_PATH_FLAG_CLOSED)
@@ -1171,14 +1902,14 @@ tb_void_t gb_path_line_to(gb_path_ref_t path, gb_point_ref_t point)
         gb_path_move_to((gb_path_ref_t)path, &last);
     }
 
+    // mark appended
+    gb_path_mark_appended(impl);
+
     // append code
-    tb_vector_insert_tail(impl->codes, (tb_cpointer_t)GB_PATH_CODE_LINE);
+    tb_vector_insert_tail(impl->storage->codes, (tb_cpointer_t)GB_PATH_CODE_LINE);
 
     // append point
-    tb_vector_insert_tail(impl->points, point);
-
-    // mark dirty
-    impl->flag |= GB_PATH_FLAG_DIRTY_ALL;
+    tb_vector_insert_tail(impl->storage->points, point);
 }
 tb_void_t gb_path_line2_to(gb_path_ref_t path, gb_float_t x, gb_float_t y)
 {
@@ -1202,7 +1933,10 @@ tb_void_t gb_path_quad_to(gb_path_ref_t path, gb_point_ref_t ctrl, gb_point_ref_
 {
     // check
     gb_path_impl_t* impl = (gb_path_impl_t*)path;
-    tb_assert_and_check_return(impl && impl->codes && impl->points && ctrl && point);
+    tb_assert_and_check_return(impl && ctrl && point);
+
+    // make the path writable
+    if (!gb_path_storage_detach(impl)) return ;
 
     // closed? patch one move-to point first using the last point
     if (impl->flag & GB_PATH_FLAG_CLOSED)
@@ -1213,15 +1947,18 @@ tb_void_t gb_path_quad_to(gb_path_ref_t path, gb_point_ref_t ctrl, gb_point_ref_
         gb_path_move_to((gb_path_ref_t)path, &last);
     }
 
+    // mark appended
+    gb_path_mark_appended(impl);
+
     // append code
-    tb_vector_insert_tail(impl->codes, (tb_cpointer_t)GB_PATH_CODE_QUAD);
+    tb_vector_insert_tail(impl->storage->codes, (tb_cpointer_t)GB_PATH_CODE_QUAD);
 
     // append points
-    tb_vector_insert_tail(impl->points, ctrl);
-    tb_vector_insert_tail(impl->points, point);
+    tb_vector_insert_tail(impl->storage->points, ctrl);
+    tb_vector_insert_tail(impl->storage->points, point);
 
-    // mark dirty and curve
-    impl->flag |= GB_PATH_FLAG_DIRTY_ALL | GB_PATH_FLAG_CURVE;
+    // mark curve
+    impl->flag |= GB_PATH_FLAG_CURVE;
 }
 tb_void_t gb_path_quad2_to(gb_path_ref_t path, gb_float_t cx, gb_float_t cy, gb_float_t x, gb_float_t y)
 {
@@ -1253,7 +1990,10 @@ tb_void_t gb_path_cubic_to(gb_path_ref_t path, gb_point_ref_t ctrl0, gb_point_re
 {
     // check
     gb_path_impl_t* impl = (gb_path_impl_t*)path;
-    tb_assert_and_check_return(impl && impl->codes && impl->points && ctrl0 && ctrl1 && point);
+    tb_assert_and_check_return(impl && ctrl0 && ctrl1 && point);
+
+    // make the path writable
+    if (!gb_path_storage_detach(impl)) return ;
 
     // closed? patch one move-to point first using the last point
     if (impl->flag & GB_PATH_FLAG_CLOSED)
@@ -1264,16 +2004,19 @@ tb_void_t gb_path_cubic_to(gb_path_ref_t path, gb_point_ref_t ctrl0, gb_point_re
         gb_path_move_to((gb_path_ref_t)path, &last);
     }
 
+    // mark appended
+    gb_path_mark_appended(impl);
+
     // append code
-    tb_vector_insert_tail(impl->codes, (tb_cpointer_t)GB_PATH_CODE_CUBIC);
+    tb_vector_insert_tail(impl->storage->codes, (tb_cpointer_t)GB_PATH_CODE_CUBIC);
 
     // append points
-    tb_vector_insert_tail(impl->points, ctrl0);
-    tb_vector_insert_tail(impl->points, ctrl1);
-    tb_vector_insert_tail(impl->points, point);
+    tb_vector_insert_tail(impl->storage->points, ctrl0);
+    tb_vector_insert_tail(impl->storage->points, ctrl1);
+    tb_vector_insert_tail(impl->storage->points, point);
 
-    // mark dirty and curve
-    impl->flag |= GB_PATH_FLAG_DIRTY_ALL | GB_PATH_FLAG_CURVE;
+    // mark curve
+    impl->flag |= GB_PATH_FLAG_CURVE;
 }
 tb_void_t gb_path_cubic2_to(gb_path_ref_t path, gb_float_t cx0, gb_float_t cy0, gb_float_t cx1, gb_float_t cy1, gb_float_t x, gb_float_t y)
 {
@@ -1577,7 +2320,7 @@ tb_void_t gb_path_add_arc(gb_path_ref_t path, gb_arc_ref_t arc)
 {
     // check
     gb_path_impl_t* impl = (gb_path_impl_t*)path;
-    tb_assert_and_check_return(impl && impl->codes && impl->points && arc);
+    tb_assert_and_check_return(impl && arc);
 
     // ellipse? add it
     if (arc->an >= GB_DEGREE_360 || arc->an <= -GB_DEGREE_360)
@@ -71,6 +71,15 @@ typedef struct __gb_path_item_t
 
 }gb_path_item_t, *gb_path_item_ref_t;
 
+/// the path data flag enum for saving path
+typedef enum __gb_path_data_flag_e
+{
+    GB_PATH_DATA_FLAG_NONE      = 0 //!< only save the codes and points
+,   GB_PATH_DATA_FLAG_BOUNDS    = 1 //!< save the bounds
+,   GB_PATH_DATA_FLAG_POLYGON   = 2 //!< save the polygon flattened for the scale one
+
+}gb_path_data_flag_e;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -81,6 +90,22 @@ typedef struct __gb_path_item_t
  */
 gb_path_ref_t       gb_path_init(tb_noarg_t);
 
+/*! init path from the data saved by gb_path_save
+ *
+ * the codes, points and the saved polygon are wrapped read-only without copying,
+ * so only the touched data are loaded if the data is mapped from the file.
+ * they are copied to the path only if it is modified.
+ *
+ * the codes and the saved polygon counts are validated when loading,
+ * but the point values are used as they are.
+ *
+ * @param data      the data, it must be aligned by four bytes and be kept until the path and its copies are exited
+ * @param size      the data size
+ *
+ * @return          the path, return tb_null if the data is invalid or saved for the other float type
+ */
+gb_path_ref_t       gb_path_init_from_data(tb_byte_t const* data, tb_size_t size);
+
 /*! exit path
  *
  * @param path      the path
@@ -94,12 +119,28 @@ tb_void_t           gb_path_exit(gb_path_ref_t path);
 tb_void_t           gb_path_clear(gb_path_ref_t path);
 
 /*! copy path
+ *
+ * the codes and points are shared with the copied path without copying them,
+ * and they are copied only if one of these paths is modified.
  *
  * @param path      the path
  * @param copied    the copied path
  */
 tb_void_t           gb_path_copy(gb_path_ref_t path, gb_path_ref_t copied);
 
+/*! save path to the data
+ *
+ * the data are native-endian and versioned, it can be loaded by gb_path_init_from_data 
+ *
+ * @param path      the path
+ * @param data      the data, it must be aligned by four bytes, only return the data size if be null
+ * @param maxn      the data maxn
+ * @param flag      the data flag, e.g. GB_PATH_DATA_FLAG_BOUNDS | GB_PATH_DATA_FLAG_POLYGON
+ *
+ * @return          the data size, return 0 if failed
+ */
+tb_size_t           gb_path_save(gb_path_ref_t path, tb_byte_t* data, tb_size_t maxn, tb_size_t flag);
+
 /*! is null path?
  *
  * @param path      the path
@@ -164,6 +205,18 @@ gb_shape_ref_t      gb_path_hint(gb_path_ref_t path);
  */
 gb_polygon_ref_t    gb_path_polygon(gb_path_ref_t path);
 
+/*! the path polygon for drawing it with the given matrix
+ *
+ * the curves are flattened for the scale of the matrix, so the zoomed-in curves are smoother
+ * and the zoomed-out curves have fewer lines. the polygons of the recent scales are cached.
+ *
+ * @param path      the path
+ * @param matrix    the matrix for drawing, the scale is one if be null
+ *
+ * @return          the polygon, it's valid until the path is modified or the polygon of another scale is made
+ */
+gb_polygon_ref_t    gb_path_polygon_for_matrix(gb_path_ref_t path, gb_matrix_ref_t matrix);
+
 /*! apply the matrix to the path 
  *
  * @param path      the path
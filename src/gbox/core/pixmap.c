@@ -25,6 +25,7 @@
  * includes
  */
 #include "pixmap.h"
+#include "paint.h"
 #include "pixmap/pal8.h"
 #include "pixmap/rgb565.h"
 #include "pixmap/rgb888.h"
@@ -40,6 +41,25 @@
 #include "pixmap/rgbx4444.h"
 #include "pixmap/rgba8888.h"
 #include "pixmap/rgbx8888.h"
+#include "pixmap/pargb8888.h"
+#include "pixmap/composite_storage.h"
+#include "impl/pixmap_simd.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * the compositing pixmaps
+ */
+GB_PIXMAP_COMPOSITE_STORAGE(l, argb8888,    rgb32,  32, GB_PIXFMT_ARGB8888,                         STRAIGHT)
+GB_PIXMAP_COMPOSITE_STORAGE(b, argb8888,    rgb32,  32, GB_PIXFMT_ARGB8888 | GB_PIXFMT_BENDIAN,     STRAIGHT)
+GB_PIXMAP_COMPOSITE_STORAGE(l, xrgb8888,    rgb32,  32, GB_PIXFMT_XRGB8888,                         OPAQUE)
+GB_PIXMAP_COMPOSITE_STORAGE(b, xrgb8888,    rgb32,  32, GB_PIXFMT_XRGB8888 | GB_PIXFMT_BENDIAN,     OPAQUE)
+GB_PIXMAP_COMPOSITE_STORAGE(l, rgba8888,    rgb32,  32, GB_PIXFMT_RGBA8888,                         STRAIGHT)
+GB_PIXMAP_COMPOSITE_STORAGE(b, rgba8888,    rgb32,  32, GB_PIXFMT_RGBA8888 | GB_PIXFMT_BENDIAN,     STRAIGHT)
+GB_PIXMAP_COMPOSITE_STORAGE(l, rgbx8888,    rgb32,  32, GB_PIXFMT_RGBX8888,                         OPAQUE)
+GB_PIXMAP_COMPOSITE_STORAGE(b, rgbx8888,    rgb32,  32, GB_PIXFMT_RGBX8888 | GB_PIXFMT_BENDIAN,     OPAQUE)
+GB_PIXMAP_COMPOSITE_STORAGE(l, rgb565,      rgb16,  16, GB_PIXFMT_RGB565,                           OPAQUE)
+GB_PIXMAP_COMPOSITE_STORAGE(b, rgb565,      rgb16,  16, GB_PIXFMT_RGB565 | GB_PIXFMT_BENDIAN,       OPAQUE)
+GB_PIXMAP_COMPOSITE_STORAGE(l, pargb8888,   rgb32,  32, GB_PIXFMT_PARGB8888,                        PREMULTIPLIED)
+GB_PIXMAP_COMPOSITE_STORAGE(b, pargb8888,   rgb32,  32, GB_PIXFMT_PARGB8888 | GB_PIXFMT_BENDIAN,    PREMULTIPLIED)
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * globals 
@@ -79,6 +99,8 @@ static gb_pixmap_ref_t g_pixmaps_lo[] =
 ,	tb_null
 ,	tb_null
 
+,	&g_pixmap_lo_pargb8888
+
 };
 
 // the pixmaps for opaque and big endian
@@ -115,6 +137,8 @@ static gb_pixmap_ref_t g_pixmaps_bo[] =
 ,	tb_null
 ,	tb_null
 
+,	&g_pixmap_bo_pargb8888
+
 };
 
 // the pixmaps for alpha and little endian
@@ -151,6 +175,8 @@ static gb_pixmap_ref_t g_pixmaps_la[] =
 ,	tb_null
 ,	tb_null
 
+,	&g_pixmap_la_pargb8888
+
 };
 
 // the pixmaps for alpha and big endian
@@ -187,8 +213,132 @@ static gb_pixmap_ref_t g_pixmaps_ba[] =
 ,	tb_null
 ,	tb_null
 
+,	&g_pixmap_ba_pargb8888
+
+};
+
+// the compositing pixmaps of all blend modes for little endian
+static gb_pixmap_ref_t g_pixmaps_composite_l[] =
+{
+	tb_null
+,	gb_pixmap_composite_l_rgb565_pixmaps
+,	tb_null
+,	tb_null
+,	tb_null
+,	tb_null
+,	tb_null
+,	gb_pixmap_composite_l_argb8888_pixmaps
+,	gb_pixmap_composite_l_xrgb8888_pixmaps
+,	tb_null
+,	tb_null
+,	tb_null
+,	tb_null
+,	gb_pixmap_composite_l_rgba8888_pixmaps
+,	gb_pixmap_composite_l_rgbx8888_pixmaps
+,	tb_null
+,	tb_null
+,	tb_null
+,	tb_null
+,	tb_null
+,	tb_null
+,	tb_null
+,	tb_null
+,	tb_null
+,	tb_null
+,	tb_null
+,	tb_null
+,	tb_null
+,	tb_null
+
+,	gb_pixmap_composite_l_pargb8888_pixmaps
+};
+
+// the compositing pixmaps of all blend modes for big endian
+static gb_pixmap_ref_t g_pixmaps_composite_b[] =
+{
+	tb_null
+,	gb_pixmap_composite_b_rgb565_pixmaps
+,	tb_null
+,	tb_null
+,	tb_null
+,	tb_null
+,	tb_null
+,	gb_pixmap_composite_b_argb8888_pixmaps
+,	gb_pixmap_composite_b_xrgb8888_pixmaps
+,	tb_null
+,	tb_null
+,	tb_null
+,	tb_null
+,	gb_pixmap_composite_b_rgba8888_pixmaps
+,	gb_pixmap_composite_b_rgbx8888_pixmaps
+,	tb_null
+,	tb_null
+,	tb_null
+,	tb_null
+,	tb_null
+,	tb_null
+,	tb_null
+,	tb_null
+,	tb_null
+,	tb_null
+,	tb_null
+,	tb_null
+,	tb_null
+,	tb_null
+
+,	gb_pixmap_composite_b_pargb8888_pixmaps
 };
 
+// the accelerated pixmaps for alpha and little endian
+static gb_pixmap_t          g_pixmaps_la_simd[tb_arrayn(g_pixmaps_la)];
+
+// the best pixmaps for alpha and little endian on the current cpu
+static gb_pixmap_ref_t      g_pixmaps_la_best[tb_arrayn(g_pixmaps_la)];
+
+// the state of the best pixmaps, 0: no init, 1: initing, 2: inited
+static tb_atomic_t          g_pixmaps_la_state = 0;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static gb_pixmap_ref_t gb_pixmap_la(tb_size_t pixfmt)
+{
+    // check
+    tb_assert(pixfmt && (pixfmt - 1) < tb_arrayn(g_pixmaps_la));
+
+    // init the best pixmaps at the first time
+    if (tb_atomic_get(&g_pixmaps_la_state) != 2)
+    {
+        // be initing in the other thread? use the generic pixmap now
+        if (tb_atomic_fetch_and_pset(&g_pixmaps_la_state, 0, 1)) return g_pixmaps_la[pixfmt - 1];
+
+        // select the accelerated pixels fill for the current cpu
+        tb_size_t                       i = 0;
+        gb_pixmap_func_pixels_fill_t    pixels_fill = tb_null;
+        for (i = 0; i < tb_arrayn(g_pixmaps_la); i++)
+        {
+            // the generic pixmap
+            g_pixmaps_la_best[i] = g_pixmaps_la[i];
+            tb_check_continue(g_pixmaps_la[i]);
+
+            // no accelerated pixels fill?
+            pixels_fill = gb_pixmap_simd_pixels_fill(g_pixmaps_la[i]->pixfmt);
+            tb_check_continue(pixels_fill);
+
+            // init the accelerated pixmap
+            g_pixmaps_la_simd[i] = *g_pixmaps_la[i];
+            g_pixmaps_la_simd[i].pixels_fill = pixels_fill;
+            g_pixmaps_la_best[i] = &g_pixmaps_la_simd[i];
+        }
+
+        // inited
+        tb_atomic_set(&g_pixmaps_la_state, 2);
+    }
+
+    // ok
+    return g_pixmaps_la_best[pixfmt - 1];
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementions
  */
@@ -217,10 +367,83 @@ gb_pixmap_ref_t gb_pixmap(tb_size_t pixfmt, tb_byte_t alpha)
 		tb_assert(pixfmt && (pixfmt - 1) < tb_arrayn(g_pixmaps_la));
 
         // ok
-		return bendian? g_pixmaps_ba[pixfmt - 1] : g_pixmaps_la[pixfmt - 1];
+		return bendian? g_pixmaps_ba[pixfmt - 1] : gb_pixmap_la(pixfmt);
 	}
 
 	// transparent
 	return tb_null;
 }
+gb_pixmap_ref_t gb_pixmap_composite(tb_size_t pixfmt, tb_size_t blend)
+{
+    // check
+    tb_assert_and_check_return_val(blend < GB_PAINT_BLEND_MAXN, tb_null);
+
+    // big endian?
+    tb_size_t bendian = GB_PIXFMT_BE(pixfmt); 
+
+    // the pixfmt
+    pixfmt = GB_PIXFMT(pixfmt);
+    tb_assert_and_check_return_val(pixfmt && (pixfmt - 1) < tb_arrayn(g_pixmaps_composite_l), tb_null);
+
+    // the compositing pixmaps of this pixfmt
+    gb_pixmap_ref_t pixmaps = bendian? g_pixmaps_composite_b[pixfmt - 1] : g_pixmaps_composite_l[pixfmt - 1];
+
+    // ok? 
+    return pixmaps? &pixmaps[blend] : tb_null;
+}
+tb_bool_t gb_pixmap_palette_set(gb_color_t const* colors, tb_size_t count)
+{
+    // set it
+    return gb_pixmap_pal8_palette_set(colors, count);
+}
+gb_color_t const* gb_pixmap_palette(tb_size_t* pcount)
+{
+    // the count
+    if (pcount) *pcount = g_pixmap_pal8_palette.count;
+
+    // the colors
+    return g_pixmap_pal8_palette.count? g_pixmap_pal8_palette.colors : tb_null;
+}
+gb_pixel_t gb_pixmap_palette_dither(gb_color_t color, tb_size_t x, tb_size_t y)
+{
+    // dither it
+    return gb_pixmap_pal8_pixel_dither(color, x, y);
+}
+tb_bool_t gb_pixmap_convert(tb_size_t dst_fmt, tb_pointer_t dst, tb_size_t src_fmt, tb_cpointer_t src, tb_size_t count)
+{
+    // check
+    tb_assert_and_check_return_val(dst && src, tb_false);
+    tb_check_return_val(count, tb_true);
 
+    // the opaque pixmaps
+    tb_size_t dst_pixfmt = GB_PIXFMT(dst_fmt);
+    tb_size_t src_pixfmt = GB_PIXFMT(src_fmt);
+    tb_assert_and_check_return_val(dst_pixfmt && (dst_pixfmt - 1) < tb_arrayn(g_pixmaps_lo), tb_false);
+    tb_assert_and_check_return_val(src_pixfmt && (src_pixfmt - 1) < tb_arrayn(g_pixmaps_lo), tb_false);
+    gb_pixmap_ref_t dst_pixmap = GB_PIXFMT_BE(dst_fmt)? g_pixmaps_bo[dst_pixfmt - 1] : g_pixmaps_lo[dst_pixfmt - 1];
+    gb_pixmap_ref_t src_pixmap = GB_PIXFMT_BE(src_fmt)? g_pixmaps_bo[src_pixfmt - 1] : g_pixmaps_lo[src_pixfmt - 1];
+    tb_check_return_val(dst_pixmap && src_pixmap, tb_false);
+
+    // the same format? copy it
+    if (dst_pixmap == src_pixmap)
+    {
+        tb_memcpy(dst, src, count * dst_pixmap->btp);
+        return tb_true;
+    }
+
+    // no palette for converting the pal8 pixels?
+    tb_check_return_val(g_pixmap_pal8_palette.count || (dst_pixfmt != GB_PIXFMT(GB_PIXFMT_PAL8) && src_pixfmt != GB_PIXFMT(GB_PIXFMT_PAL8)), tb_false);
+
+    // convert it with the accelerated converter
+    if (gb_pixmap_simd_convert(dst_fmt, dst, src_fmt, src, count)) return tb_true;
+
+    // convert it with the color
+    tb_byte_t*          d = (tb_byte_t*)dst;
+    tb_byte_t const*    s = (tb_byte_t const*)src;
+    tb_size_t           dst_btp = dst_pixmap->btp;
+    tb_size_t           src_btp = src_pixmap->btp;
+    for (; count; count--, d += dst_btp, s += src_btp) dst_pixmap->color_set(d, src_pixmap->color_get(s));
+
+    // ok
+    return tb_true;
+}
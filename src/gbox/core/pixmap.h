@@ -157,6 +157,65 @@ typedef gb_pixmap_t const*      gb_pixmap_ref_t;
  */
 gb_pixmap_ref_t 		gb_pixmap(tb_size_t pixfmt, tb_byte_t alpha);
 
+/*! get the compositing pixmap of the blend mode from the pixel format 
+ *
+ * the pixel is composited with the premultiplied alpha and the alpha of the pixel format is respected,
+ * the pixel of pixel_set and pixels_fill is the opaque pixel and the alpha argument is the alpha of the source,
+ * only the 32-bits rgb formats and rgb565 are supported now, 
+ * and pargb8888 keeps the premultiplied pixels without converting them
+ *
+ * @param pixfmt        the pixfmt with endian
+ * @param blend         the blend mode, see gb_paint_blend_e
+ *
+ * @return              the pixmap or tb_null if not supported
+ */
+gb_pixmap_ref_t 		gb_pixmap_composite(tb_size_t pixfmt, tb_size_t blend);
+
+/*! set the palette of the pal8 pixel format
+ *
+ * the inverse color lookup table is built once for the palette, so mapping the color to the index is O(1),
+ * it's shared by all pal8 pixmaps and should be set before drawing
+ *
+ * @param colors        the colors
+ * @param count         the colors count, clear the palette if be zero
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               gb_pixmap_palette_set(gb_color_t const* colors, tb_size_t count);
+
+/*! the palette of the pal8 pixel format
+ *
+ * @param pcount        the colors count, optional
+ *
+ * @return              the colors or tb_null if no palette
+ */
+gb_color_t const*       gb_pixmap_palette(tb_size_t* pcount);
+
+/*! map the color to the palette index with the ordered dithering
+ *
+ * @param color         the color
+ * @param x             the x-coordinate of the pixel
+ * @param y             the y-coordinate of the pixel
+ *
+ * @return              the palette index
+ */
+gb_pixel_t              gb_pixmap_palette_dither(gb_color_t color, tb_size_t x, tb_size_t y);
+
+/*! convert the pixels to the other pixel format
+ *
+ * the conversions between the 32-bits formats and from or to rgb565 and rgb888 are accelerated with simd if possible,
+ * the alpha is kept only if both formats have alpha, otherwise it is opaque
+ *
+ * @param dst_fmt       the pixfmt with endian of the destination
+ * @param dst           the destination pixels, must not overlap the source
+ * @param src_fmt       the pixfmt with endian of the source
+ * @param src           the source pixels
+ * @param count         the pixel count
+ *
+ * @return              tb_true or tb_false if not supported
+ */
+tb_bool_t 		        gb_pixmap_convert(tb_size_t dst_fmt, tb_pointer_t dst, tb_size_t src_fmt, tb_cpointer_t src, tb_size_t count);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -0,0 +1,256 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        composite.h
+ * @ingroup     core
+ *
+ * the compositing kernels of the blend modes
+ *
+ * all kernels work on the premultiplied argb color: a << 24 | r << 16 | g << 8 | b and r, g, b <= a,
+ * the pargb8888 pixels are stored in this color directly, the other pixels with the straight alpha 
+ * are premultiplied after loading and unpremultiplied before storing.
+ *
+ */
+#ifndef GB_CORE_PIXMAP_COMPOSITE_H
+#define GB_CORE_PIXMAP_COMPOSITE_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the stored pixel of the format => the premultiplied color
+#define GB_PIXMAP_COMPOSITE_LOAD_STRAIGHT(format, pixel)            gb_pixmap_composite_load(gb_pixmap_##format##_color(pixel))
+#define GB_PIXMAP_COMPOSITE_LOAD_OPAQUE(format, pixel)              (gb_color_pixel(gb_pixmap_##format##_color(pixel)) | 0xff000000)
+#define GB_PIXMAP_COMPOSITE_LOAD_PREMULTIPLIED(format, pixel)       (pixel)
+
+// the premultiplied color => the stored pixel of the format, the opaque pixel keeps the color over the opaque black
+#define GB_PIXMAP_COMPOSITE_STORE_STRAIGHT(format, c)               gb_pixmap_##format##_pixel(gb_pixmap_composite_unpremultiply(c))
+#define GB_PIXMAP_COMPOSITE_STORE_OPAQUE(format, c)                 gb_pixmap_##format##_pixel(gb_pixel_color((c) | 0xff000000))
+#define GB_PIXMAP_COMPOSITE_STORE_PREMULTIPLIED(format, c)          (c)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the reciprocals for unpremultiplying the color: (255 << 16) / a 
+static tb_uint32_t const g_pixmap_composite_unpremultiply[256] = 
+{
+    0x000000, 0xff0000, 0x7f8000, 0x550000, 0x3fc000, 0x330000, 0x2a8000, 0x246db7,
+    0x1fe000, 0x1c5555, 0x198000, 0x172e8c, 0x154000, 0x139d8a, 0x1236db, 0x110000,
+    0x0ff000, 0x0f0000, 0x0e2aab, 0x0d6bca, 0x0cc000, 0x0c2492, 0x0b9746, 0x0b1643,
+    0x0aa000, 0x0a3333, 0x09cec5, 0x0971c7, 0x091b6e, 0x08cb09, 0x088000, 0x0839ce,
+    0x07f800, 0x07ba2f, 0x078000, 0x074925, 0x071555, 0x06e453, 0x06b5e5, 0x0689d9,
+    0x066000, 0x063832, 0x061249, 0x05ee24, 0x05cba3, 0x05aaab, 0x058b21, 0x056cf0,
+    0x055000, 0x05343f, 0x05199a, 0x050000, 0x04e762, 0x04cfb3, 0x04b8e4, 0x04a2e9,
+    0x048db7, 0x047943, 0x046584, 0x045271, 0x044000, 0x042e2a, 0x041ce7, 0x040c31,
+    0x03fc00, 0x03ec4f, 0x03dd17, 0x03ce54, 0x03c000, 0x03b216, 0x03a492, 0x039770,
+    0x038aab, 0x037e3f, 0x03722a, 0x036666, 0x035af3, 0x034fcb, 0x0344ec, 0x033a54,
+    0x033000, 0x0325ed, 0x031c19, 0x031282, 0x030925, 0x030000, 0x02f712, 0x02ee58,
+    0x02e5d1, 0x02dd7c, 0x02d555, 0x02cd5d, 0x02c591, 0x02bdef, 0x02b678, 0x02af28,
+    0x02a800, 0x02a0fd, 0x029a1f, 0x029365, 0x028ccd, 0x028656, 0x028000, 0x0279c9,
+    0x0273b1, 0x026db7, 0x0267d9, 0x026218, 0x025c72, 0x0256e6, 0x025174, 0x024c1c,
+    0x0246db, 0x0241b3, 0x023ca2, 0x0237a7, 0x0232c2, 0x022df3, 0x022938, 0x022492,
+    0x022000, 0x021b81, 0x021715, 0x0212bb, 0x020e74, 0x020a3d, 0x020618, 0x020204,
+    0x01fe00, 0x01fa0c, 0x01f627, 0x01f252, 0x01ee8c, 0x01ead4, 0x01e72a, 0x01e38e,
+    0x01e000, 0x01dc7f, 0x01d90b, 0x01d5a4, 0x01d249, 0x01cefb, 0x01cbb8, 0x01c881,
+    0x01c555, 0x01c235, 0x01bf20, 0x01bc15, 0x01b915, 0x01b61f, 0x01b333, 0x01b051,
+    0x01ad79, 0x01aaab, 0x01a7e5, 0x01a529, 0x01a276, 0x019fcc, 0x019d2a, 0x019a91,
+    0x019800, 0x019577, 0x0192f7, 0x01907e, 0x018e0c, 0x018ba3, 0x018941, 0x0186e6,
+    0x018492, 0x018246, 0x018000, 0x017dc1, 0x017b89, 0x017957, 0x01772c, 0x017507,
+    0x0172e9, 0x0170d0, 0x016ebe, 0x016cb1, 0x016aab, 0x0168aa, 0x0166ae, 0x0164b9,
+    0x0162c8, 0x0160dd, 0x015ef8, 0x015d17, 0x015b3c, 0x015966, 0x015794, 0x0155c8,
+    0x015400, 0x01523d, 0x01507f, 0x014ec5, 0x014d10, 0x014b5f, 0x0149b2, 0x01480a,
+    0x014666, 0x0144c7, 0x01432b, 0x014194, 0x014000, 0x013e70, 0x013ce5, 0x013b5d,
+    0x0139d9, 0x013858, 0x0136db, 0x013562, 0x0133ed, 0x01327b, 0x01310c, 0x012fa1,
+    0x012e39, 0x012cd4, 0x012b73, 0x012a15, 0x0128ba, 0x012762, 0x01260e, 0x0124bc,
+    0x01236e, 0x012222, 0x0120d9, 0x011f94, 0x011e51, 0x011d11, 0x011bd3, 0x011a99,
+    0x011961, 0x01182c, 0x0116f9, 0x0115ca, 0x01149c, 0x011371, 0x011249, 0x011123,
+    0x011000, 0x010edf, 0x010dc1, 0x010ca4, 0x010b8a, 0x010a73, 0x01095e, 0x01084b,
+    0x01073a, 0x01062b, 0x01051f, 0x010414, 0x01030c, 0x010206, 0x010102, 0x010000
+};
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * inlines
+ */
+
+// v / 255 with the rounding for v <= 255 * 255
+static __tb_inline__ tb_uint32_t gb_pixmap_composite_div255(tb_uint32_t v)
+{
+    v += 128;
+    return (v + (v >> 8)) >> 8;
+}
+
+// c * a / 255 for all channels of c with the rounding
+static __tb_inline__ tb_uint32_t gb_pixmap_composite_scale(tb_uint32_t c, tb_uint32_t a)
+{
+    tb_uint32_t rb = (c & 0x00ff00ff) * a + 0x00800080;
+    tb_uint32_t ag = ((c >> 8) & 0x00ff00ff) * a + 0x00800080;
+    rb = ((rb + ((rb >> 8) & 0x00ff00ff)) >> 8) & 0x00ff00ff;
+    ag = (ag + ((ag >> 8) & 0x00ff00ff)) & 0xff00ff00;
+    return ag | rb;
+}
+
+// x * y / 255 for each channel
+static __tb_inline__ tb_uint32_t gb_pixmap_composite_mul(tb_uint32_t x, tb_uint32_t y)
+{
+    return      (gb_pixmap_composite_div255((x >> 24) * (y >> 24)) << 24)
+            |   (gb_pixmap_composite_div255(((x >> 16) & 0xff) * ((y >> 16) & 0xff)) << 16)
+            |   (gb_pixmap_composite_div255(((x >> 8) & 0xff) * ((y >> 8) & 0xff)) << 8)
+            |   (gb_pixmap_composite_div255((x & 0xff) * (y & 0xff)));
+}
+
+// the straight color with the alpha a => the premultiplied color, the alpha of c will be ignored
+static __tb_inline__ tb_uint32_t gb_pixmap_composite_premultiply(tb_uint32_t c, tb_uint32_t a)
+{
+    return (a << 24) | (gb_pixmap_composite_scale(c, a) & 0x00ffffff);
+}
+
+// the straight color => the premultiplied color
+static __tb_inline__ tb_uint32_t gb_pixmap_composite_load(gb_color_t color)
+{
+    return color.a == 0xff? gb_color_pixel(color) : gb_pixmap_composite_premultiply(gb_color_pixel(color), color.a);
+}
+
+// the premultiplied color => the straight color
+static __tb_inline__ gb_color_t gb_pixmap_composite_unpremultiply(tb_uint32_t c)
+{
+    // the alpha
+    tb_uint32_t a = c >> 24;
+
+    // opaque? ok
+    if (a == 0xff) return gb_pixel_color(c);
+
+    // transparent? clear it
+    if (!a) return gb_pixel_color(0);
+
+    // the reciprocal of the alpha
+    tb_uint32_t s = g_pixmap_composite_unpremultiply[a];
+
+    // the color
+    tb_uint32_t r = ((((c >> 16) & 0xff) * s) + 0x8000) >> 16;
+    tb_uint32_t g = ((((c >> 8) & 0xff) * s) + 0x8000) >> 16;
+    tb_uint32_t b = (((c & 0xff) * s) + 0x8000) >> 16;
+    return gb_color_make((tb_byte_t)a, (tb_byte_t)tb_min(r, 0xff), (tb_byte_t)tb_min(g, 0xff), (tb_byte_t)tb_min(b, 0xff));
+}
+
+// src: S
+static __tb_inline__ tb_uint32_t gb_pixmap_composite_src(tb_uint32_t s, tb_uint32_t d)
+{
+    return s;
+}
+
+// the result of src is always the source
+static __tb_inline__ tb_bool_t gb_pixmap_composite_src_replace(tb_byte_t alpha)
+{
+    return tb_true;
+}
+
+// src-over: S + D * (1 - Sa)
+static __tb_inline__ tb_uint32_t gb_pixmap_composite_src_over(tb_uint32_t s, tb_uint32_t d)
+{
+    return s + gb_pixmap_composite_scale(d, 0xff - (s >> 24));
+}
+
+// the result of src-over is the source for the opaque source
+static __tb_inline__ tb_bool_t gb_pixmap_composite_src_over_replace(tb_byte_t alpha)
+{
+    return alpha == 0xff;
+}
+
+// dst-in: D * Sa
+static __tb_inline__ tb_uint32_t gb_pixmap_composite_dst_in(tb_uint32_t s, tb_uint32_t d)
+{
+    return gb_pixmap_composite_scale(d, s >> 24);
+}
+static __tb_inline__ tb_bool_t gb_pixmap_composite_dst_in_replace(tb_byte_t alpha)
+{
+    return tb_false;
+}
+
+// dst-out: D * (1 - Sa)
+static __tb_inline__ tb_uint32_t gb_pixmap_composite_dst_out(tb_uint32_t s, tb_uint32_t d)
+{
+    return gb_pixmap_composite_scale(d, 0xff - (s >> 24));
+}
+static __tb_inline__ tb_bool_t gb_pixmap_composite_dst_out_replace(tb_byte_t alpha)
+{
+    return tb_false;
+}
+
+// multiply: S * (1 - Da) + D * (1 - Sa) + S * D
+static __tb_inline__ tb_uint32_t gb_pixmap_composite_multiply(tb_uint32_t s, tb_uint32_t d)
+{
+    // the inverse alphas
+    tb_uint32_t isa = 0xff - (s >> 24);
+    tb_uint32_t ida = 0xff - (d >> 24);
+
+    // the channels
+    tb_uint32_t sa = s >> 24;
+    tb_uint32_t sr = (s >> 16) & 0xff;
+    tb_uint32_t sg = (s >> 8) & 0xff;
+    tb_uint32_t sb = s & 0xff;
+    tb_uint32_t da = d >> 24;
+    tb_uint32_t dr = (d >> 16) & 0xff;
+    tb_uint32_t dg = (d >> 8) & 0xff;
+    tb_uint32_t db = d & 0xff;
+
+    // done
+    return      (gb_pixmap_composite_div255(sa * ida + da * isa + sa * da) << 24)
+            |   (gb_pixmap_composite_div255(sr * ida + dr * isa + sr * dr) << 16)
+            |   (gb_pixmap_composite_div255(sg * ida + dg * isa + sg * dg) << 8)
+            |   (gb_pixmap_composite_div255(sb * ida + db * isa + sb * db));
+}
+static __tb_inline__ tb_bool_t gb_pixmap_composite_multiply_replace(tb_byte_t alpha)
+{
+    return tb_false;
+}
+
+// screen: S + D - S * D = S + D * (1 - S)
+static __tb_inline__ tb_uint32_t gb_pixmap_composite_screen(tb_uint32_t s, tb_uint32_t d)
+{
+    return s + gb_pixmap_composite_mul(d, ~s);
+}
+static __tb_inline__ tb_bool_t gb_pixmap_composite_screen_replace(tb_byte_t alpha)
+{
+    return tb_false;
+}
+
+// plus: min(S + D, 1)
+static __tb_inline__ tb_uint32_t gb_pixmap_composite_plus(tb_uint32_t s, tb_uint32_t d)
+{
+    // add the channels, the carry of each channel is saved in the 9th bit
+    tb_uint32_t rb = (s & 0x00ff00ff) + (d & 0x00ff00ff);
+    tb_uint32_t ag = ((s >> 8) & 0x00ff00ff) + ((d >> 8) & 0x00ff00ff);
+
+    // saturate the overflowed channels to 0xff
+    rb |= 0x01000100 - ((rb >> 8) & 0x00010001);
+    ag |= 0x01000100 - ((ag >> 8) & 0x00010001);
+    return ((ag & 0x00ff00ff) << 8) | (rb & 0x00ff00ff);
+}
+static __tb_inline__ tb_bool_t gb_pixmap_composite_plus_replace(tb_byte_t alpha)
+{
+    return tb_false;
+}
+
+#endif
@@ -0,0 +1,104 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        composite_blend.h
+ * @ingroup     core
+ *
+ * the compositing kernels of the blend modes
+ *
+ * GB_PIXMAP_COMPOSITE_BLEND(prefix, blend, endian, storage, btp) defines the operations of one blend mode 
+ * for the storage of composite_storage.h, it needs:
+ *
+ * - prefix##_load(pixel):                  the stored pixel => the premultiplied color
+ * - prefix##_store(c):                     the premultiplied color => the stored pixel
+ * - gb_pixmap_composite_##blend(s, d):     the kernel for the premultiplied source s and destination d
+ * - gb_pixmap_composite_##blend##_replace: the result is the source only for the source alpha?
+ *
+ * the pixel of pixel_set and pixels_fill is the opaque paint pixel and the alpha argument is the source alpha,
+ * the copied pixel of pixel_cpy is loaded with its stored alpha and scaled by the alpha argument.
+ */
+#ifndef GB_CORE_PIXMAP_COMPOSITE_BLEND_H
+#define GB_CORE_PIXMAP_COMPOSITE_BLEND_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+#define GB_PIXMAP_COMPOSITE_BLEND(prefix, blend, endian, storage, btp) \
+static __tb_inline__ tb_void_t prefix##_##blend##_done(tb_pointer_t data, tb_uint32_t s) \
+{ \
+    gb_pixmap_##storage##_pixel_set_##endian##o(data, prefix##_store(gb_pixmap_composite_##blend(s, prefix##_load(gb_pixmap_##storage##_pixel_get_##endian(data)))), 0xff); \
+} \
+static __tb_inline__ tb_void_t prefix##_##blend##_pixel_set(tb_pointer_t data, gb_pixel_t pixel, tb_byte_t alpha) \
+{ \
+    prefix##_##blend##_done(data, gb_pixmap_composite_scale(prefix##_load(pixel), alpha)); \
+} \
+static __tb_inline__ tb_void_t prefix##_##blend##_pixel_cpy(tb_pointer_t data, tb_cpointer_t source, tb_byte_t alpha) \
+{ \
+    prefix##_##blend##_done(data, gb_pixmap_composite_scale(prefix##_load(gb_pixmap_##storage##_pixel_get_##endian(source)), alpha)); \
+} \
+static __tb_inline__ tb_void_t prefix##_##blend##_color_set(tb_pointer_t data, gb_color_t color) \
+{ \
+    prefix##_##blend##_done(data, gb_pixmap_composite_load(color)); \
+} \
+static __tb_inline__ tb_void_t prefix##_##blend##_pixels_fill(tb_pointer_t data, gb_pixel_t pixel, tb_size_t count, tb_byte_t alpha) \
+{ \
+    /* check */ \
+    tb_check_return(count); \
+ \
+    /* the premultiplied source */ \
+    tb_uint32_t s = gb_pixmap_composite_scale(prefix##_load(pixel), alpha); \
+ \
+    /* the result is the source only? fill it */ \
+    if (gb_pixmap_composite_##blend##_replace(alpha)) \
+    { \
+        gb_pixmap_##storage##_pixels_fill_##endian##o(data, prefix##_store(s), count, 0xff); \
+        return ; \
+    } \
+ \
+    /* composite the first pixel \
+     * \
+     * the destination pixels are often the same, e.g. the background of the layer, \
+     * so we reuse the last result for the same destination pixel \
+     */ \
+    tb_byte_t*  p = (tb_byte_t*)data; \
+    tb_byte_t*  e = p + count * (btp); \
+    gb_pixel_t  last = gb_pixmap_##storage##_pixel_get_##endian(p); \
+    gb_pixel_t  result = prefix##_store(gb_pixmap_composite_##blend(s, prefix##_load(last))); \
+    gb_pixmap_##storage##_pixel_set_##endian##o(p, result, 0xff); \
+ \
+    /* composite the other pixels */ \
+    gb_pixel_t  dest; \
+    for (p += (btp); p < e; p += (btp)) \
+    { \
+        /* the destination pixel */ \
+        dest = gb_pixmap_##storage##_pixel_get_##endian(p); \
+ \
+        /* composite it if changed */ \
+        if (dest != last) \
+        { \
+            last    = dest; \
+            result  = prefix##_store(gb_pixmap_composite_##blend(s, prefix##_load(dest))); \
+        } \
+ \
+        /* save it */ \
+        gb_pixmap_##storage##_pixel_set_##endian##o(p, result, 0xff); \
+    } \
+}
+
+#endif
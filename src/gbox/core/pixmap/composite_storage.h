@@ -0,0 +1,97 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        composite_storage.h
+ * @ingroup     core
+ *
+ * the compositing kernels of the blend modes
+ *
+ * GB_PIXMAP_COMPOSITE_STORAGE(endian, format, storage, bpp, pixfmt, kind) defines the compositing pixmaps 
+ * of all blend modes for one pixel format: gb_pixmap_composite_##endian##_##format##_pixmaps,
+ *
+ * - endian:    l or b
+ * - format:    the pixel format, e.g. argb8888, uses gb_pixmap_##format##_pixel, _color and _color_get_##endian
+ * - storage:   the pixel storage, rgb32 or rgb16, uses gb_pixmap_##storage##_pixel_get_##endian, _pixel_set_##endian##o, ...
+ * - bpp:       the bits per pixel
+ * - pixfmt:    the pixfmt with endian
+ * - kind:      how to load and store the premultiplied color: STRAIGHT, OPAQUE or PREMULTIPLIED
+ */
+#ifndef GB_CORE_PIXMAP_COMPOSITE_STORAGE_H
+#define GB_CORE_PIXMAP_COMPOSITE_STORAGE_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "composite.h"
+#include "composite_blend.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the compositing pixmap entry of the blend mode
+#define GB_PIXMAP_COMPOSITE_ENTRY(prefix, blend, endian, format, storage, bpp, pixfmt) \
+{ \
+    #format \
+,   bpp \
+,   (bpp) >> 3 \
+,   pixfmt \
+,   gb_pixmap_##format##_pixel \
+,   gb_pixmap_##format##_color \
+,   gb_pixmap_##storage##_pixel_get_##endian \
+,   prefix##_##blend##_pixel_set \
+,   prefix##_##blend##_pixel_cpy \
+,   gb_pixmap_##format##_color_get_##endian \
+,   prefix##_##blend##_color_set \
+,   prefix##_##blend##_pixels_fill \
+}
+
+// the compositing pixmaps of all blend modes for the given prefix
+#define GB_PIXMAP_COMPOSITE_PIXMAPS(prefix, endian, format, storage, bpp, pixfmt, kind) \
+static __tb_inline__ tb_uint32_t prefix##_load(gb_pixel_t pixel) \
+{ \
+    return GB_PIXMAP_COMPOSITE_LOAD_##kind(format, pixel); \
+} \
+static __tb_inline__ gb_pixel_t prefix##_store(tb_uint32_t c) \
+{ \
+    return GB_PIXMAP_COMPOSITE_STORE_##kind(format, c); \
+} \
+GB_PIXMAP_COMPOSITE_BLEND(prefix, src_over, endian, storage, (bpp) >> 3) \
+GB_PIXMAP_COMPOSITE_BLEND(prefix, src, endian, storage, (bpp) >> 3) \
+GB_PIXMAP_COMPOSITE_BLEND(prefix, dst_in, endian, storage, (bpp) >> 3) \
+GB_PIXMAP_COMPOSITE_BLEND(prefix, dst_out, endian, storage, (bpp) >> 3) \
+GB_PIXMAP_COMPOSITE_BLEND(prefix, multiply, endian, storage, (bpp) >> 3) \
+GB_PIXMAP_COMPOSITE_BLEND(prefix, screen, endian, storage, (bpp) >> 3) \
+GB_PIXMAP_COMPOSITE_BLEND(prefix, plus, endian, storage, (bpp) >> 3) \
+static gb_pixmap_t const prefix##_pixmaps[] = \
+{ \
+    GB_PIXMAP_COMPOSITE_ENTRY(prefix, src_over, endian, format, storage, bpp, pixfmt) \
+,   GB_PIXMAP_COMPOSITE_ENTRY(prefix, src, endian, format, storage, bpp, pixfmt) \
+,   GB_PIXMAP_COMPOSITE_ENTRY(prefix, dst_in, endian, format, storage, bpp, pixfmt) \
+,   GB_PIXMAP_COMPOSITE_ENTRY(prefix, dst_out, endian, format, storage, bpp, pixfmt) \
+,   GB_PIXMAP_COMPOSITE_ENTRY(prefix, multiply, endian, format, storage, bpp, pixfmt) \
+,   GB_PIXMAP_COMPOSITE_ENTRY(prefix, screen, endian, format, storage, bpp, pixfmt) \
+,   GB_PIXMAP_COMPOSITE_ENTRY(prefix, plus, endian, format, storage, bpp, pixfmt) \
+};
+
+// the compositing pixmaps of all blend modes in the order of gb_paint_blend_e: gb_pixmap_composite_##endian##_##format##_pixmaps
+#define GB_PIXMAP_COMPOSITE_STORAGE(endian, format, storage, bpp, pixfmt, kind) \
+        GB_PIXMAP_COMPOSITE_PIXMAPS(gb_pixmap_composite_##endian##_##format, endian, format, storage, bpp, pixfmt, kind)
+
+#endif
@@ -30,18 +30,196 @@
 #include "prefix.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
- * interfaces
+ * macros
+ */
+
+// the bits of each channel for the inverse color lookup table: 15-bits or 18-bits
+#ifdef __gb_small__
+#   define GB_PIXMAP_PAL8_INVERSE_BITS      (5)
+#else
+#   define GB_PIXMAP_PAL8_INVERSE_BITS      (6)
+#endif
+
+// the size of the inverse color lookup table
+#define GB_PIXMAP_PAL8_INVERSE_SIZE         (1 << (GB_PIXMAP_PAL8_INVERSE_BITS * 3))
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
  */
 
+// the pal8 palette type
+typedef struct __gb_pixmap_pal8_palette_t
+{
+    // the colors
+    gb_color_t          colors[256];
+
+    // the colors count
+    tb_size_t           count;
+
+    /* the inverse color lookup table
+     *
+     * the index of the nearest color for the cell of the top GB_PIXMAP_PAL8_INVERSE_BITS bits of r, g and b,
+     * so mapping the color to the index is O(1) and need not search the palette
+     */
+    tb_byte_t*          inverse;
+
+    // the spread of the ordered dithering, about the distance between the neighbouring colors
+    tb_size_t           spread;
+
+}gb_pixmap_pal8_palette_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private globals
+ */
+
+// the palette
+static gb_pixmap_pal8_palette_t g_pixmap_pal8_palette = {{{0}}, 0, tb_null, 0};
+
+// the 4x4 bayer matrix for the ordered dithering
+static tb_byte_t const          g_pixmap_pal8_bayer[4][4] = 
+{
+    { 0,  8,  2, 10}
+,   {12,  4, 14,  6}
+,   { 3, 11,  1,  9}
+,   {15,  7, 13,  5}
+};
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_byte_t gb_pixmap_pal8_index(tb_size_t r, tb_size_t g, tb_size_t b)
+{
+    // no palette?
+    tb_byte_t const* inverse = g_pixmap_pal8_palette.inverse;
+    tb_check_return_val(inverse, 0);
+
+    // the index of the nearest color
+    return inverse[     ((r >> (8 - GB_PIXMAP_PAL8_INVERSE_BITS)) << (GB_PIXMAP_PAL8_INVERSE_BITS << 1))
+                    |   ((g >> (8 - GB_PIXMAP_PAL8_INVERSE_BITS)) << GB_PIXMAP_PAL8_INVERSE_BITS)
+                    |   (b >> (8 - GB_PIXMAP_PAL8_INVERSE_BITS))];
+}
+static __tb_inline__ tb_byte_t gb_pixmap_pal8_blend(tb_size_t d, gb_color_t s, tb_long_t a)
+{
+    // blend the colors of the palette and map it to the palette again
+    gb_color_t c = g_pixmap_pal8_palette.colors[d & 0xff];
+    return gb_pixmap_pal8_index(   ((a * (s.r - c.r)) >> 8) + c.r
+                                ,   ((a * (s.g - c.g)) >> 8) + c.g
+                                ,   ((a * (s.b - c.b)) >> 8) + c.b);
+}
+static tb_bool_t gb_pixmap_pal8_palette_set(gb_color_t const* colors, tb_size_t count)
+{
+    // check
+    tb_assert_and_check_return_val(count <= 256 && (colors || !count), tb_false);
+
+    // the palette
+    gb_pixmap_pal8_palette_t* palette = &g_pixmap_pal8_palette;
+
+    // clear it?
+    if (!count)
+    {
+        if (palette->inverse) tb_free(palette->inverse);
+        palette->inverse    = tb_null;
+        palette->count      = 0;
+        palette->spread     = 0;
+        return tb_true;
+    }
+
+    // init the inverse color lookup table
+    if (!palette->inverse) palette->inverse = tb_nalloc_type(GB_PIXMAP_PAL8_INVERSE_SIZE, tb_byte_t);
+    tb_assert_and_check_return_val(palette->inverse, tb_false);
+
+    // init the squared distances of the cells
+    tb_uint32_t* distances = tb_nalloc_type(GB_PIXMAP_PAL8_INVERSE_SIZE, tb_uint32_t);
+    tb_assert_and_check_return_val(distances, tb_false);
+    tb_memset_u32(distances, 0xffffffff, GB_PIXMAP_PAL8_INVERSE_SIZE);
+
+    // init the colors
+    tb_memcpy(palette->colors, colors, count * sizeof(gb_color_t));
+    palette->count = count;
+
+    /* make the inverse color lookup table
+     *
+     * visit all cells for each color and keep the nearest one, 
+     * the squared distance of the next cell along b is computed with the forward differences:
+     *
+     * d(b + step) - d(b) = 2 * step * (b - cb) + step^2
+     */
+    tb_long_t   n = 1 << GB_PIXMAP_PAL8_INVERSE_BITS;
+    tb_long_t   step = 1 << (8 - GB_PIXMAP_PAL8_INVERSE_BITS);
+    tb_long_t   half = step >> 1;
+    tb_long_t   i = 0;
+    tb_long_t   r = 0;
+    tb_long_t   g = 0;
+    tb_long_t   b = 0;
+    tb_long_t   dr = 0;
+    tb_long_t   dg = 0;
+    tb_long_t   db = 0;
+    tb_uint32_t d = 0;
+    tb_uint32_t dd = 0;
+    tb_uint32_t* p = tb_null;
+    tb_byte_t*   q = tb_null;
+    for (i = 0; i < (tb_long_t)count; i++)
+    {
+        p = distances;
+        q = palette->inverse;
+        for (r = 0; r < n; r++)
+        {
+            dr = r * step + half - colors[i].r;
+            for (g = 0; g < n; g++)
+            {
+                dg  = g * step + half - colors[i].g;
+                db  = half - colors[i].b;
+                d   = (tb_uint32_t)(dr * dr + dg * dg + db * db);
+                dd  = (tb_uint32_t)(2 * step * db + step * step);
+                for (b = 0; b < n; b++, p++, q++)
+                {
+                    if (d < *p)
+                    {
+                        *p = d;
+                        *q = (tb_byte_t)i;
+                    }
+                    d   += dd;
+                    dd  += (tb_uint32_t)(2 * step * step);
+                }
+            }
+        }
+    }
+
+    // exit the distances
+    tb_free(distances);
+
+    // the spread of the dithering: 256 / k for the k^3 colors cube
+    tb_size_t k = 1;
+    while (k * k * k < count) k++;
+    palette->spread = 256 / k;
+
+    // ok
+    return tb_true;
+}
+static __tb_inline__ gb_pixel_t gb_pixmap_pal8_pixel_dither(gb_color_t color, tb_size_t x, tb_size_t y)
+{
+    // the bias of the ordered dithering: [-spread / 2, spread / 2)
+    tb_long_t bias = (((tb_long_t)g_pixmap_pal8_bayer[y & 3][x & 3] << 1) - 15) * (tb_long_t)g_pixmap_pal8_palette.spread / 32;
+
+    // the dithered channels
+    tb_long_t r = tb_max(tb_min((tb_long_t)color.r + bias, 255), 0);
+    tb_long_t g = tb_max(tb_min((tb_long_t)color.g + bias, 255), 0);
+    tb_long_t b = tb_max(tb_min((tb_long_t)color.b + bias, 255), 0);
+
+    // the index of the nearest color
+    return gb_pixmap_pal8_index(r, g, b);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
 static gb_pixel_t gb_pixmap_pal8_pixel(gb_color_t color)
 {
-    tb_trace_noimpl();
-    return 0;
+    return gb_pixmap_pal8_index(color.r, color.g, color.b);
 }
 static gb_color_t gb_pixmap_pal8_color(gb_pixel_t pixel)
 {
-    tb_trace_noimpl();
-    return GB_COLOR_DEFAULT;
+    return g_pixmap_pal8_palette.colors[pixel & 0xff];
 }
 static gb_pixel_t gb_pixmap_pal8_pixel_get(tb_cpointer_t data)
 {
@@ -53,7 +231,7 @@ static tb_void_t gb_pixmap_pal8_pixel_set_o(tb_pointer_t data, gb_pixel_t pixel,
 }
 static tb_void_t gb_pixmap_pal8_pixel_set_a(tb_pointer_t data, gb_pixel_t pixel, tb_byte_t alpha)
 {
-    ((tb_byte_t*)data)[0] = (tb_byte_t)(pixel & 0xff);
+    ((tb_byte_t*)data)[0] = gb_pixmap_pal8_blend(((tb_byte_t*)data)[0], g_pixmap_pal8_palette.colors[pixel & 0xff], alpha);
 }
 static tb_void_t gb_pixmap_pal8_pixel_cpy_o(tb_pointer_t data, tb_cpointer_t source, tb_byte_t alpha)
 {
@@ -61,20 +239,19 @@ static tb_void_t gb_pixmap_pal8_pixel_cpy_o(tb_pointer_t data, tb_cpointer_t sou
 }
 static tb_void_t gb_pixmap_pal8_pixel_cpy_a(tb_pointer_t data, tb_cpointer_t source, tb_byte_t alpha)
 {
-    ((tb_byte_t*)data)[0] = ((tb_byte_t*)source)[0];
+    ((tb_byte_t*)data)[0] = gb_pixmap_pal8_blend(((tb_byte_t*)data)[0], g_pixmap_pal8_palette.colors[((tb_byte_t*)source)[0]], alpha);
 }
 static gb_color_t gb_pixmap_pal8_color_get(tb_cpointer_t data)
 {
-    tb_trace_noimpl();
-    return GB_COLOR_DEFAULT;
+    return g_pixmap_pal8_palette.colors[((tb_byte_t*)data)[0]];
 }
 static tb_void_t gb_pixmap_pal8_color_set_o(tb_pointer_t data, gb_color_t color)
 {
-    tb_trace_noimpl();
+    ((tb_byte_t*)data)[0] = gb_pixmap_pal8_index(color.r, color.g, color.b);
 }
 static tb_void_t gb_pixmap_pal8_color_set_a(tb_pointer_t data, gb_color_t color)
 {
-    tb_trace_noimpl();
+    ((tb_byte_t*)data)[0] = gb_pixmap_pal8_blend(((tb_byte_t*)data)[0], color, color.a);
 }
 static tb_void_t gb_pixmap_pal8_pixels_fill_o(tb_pointer_t data, gb_pixel_t pixel, tb_size_t count, tb_byte_t alpha)
 {
@@ -82,7 +259,23 @@ static tb_void_t gb_pixmap_pal8_pixels_fill_o(tb_pointer_t data, gb_pixel_t pixe
 }
 static tb_void_t gb_pixmap_pal8_pixels_fill_a(tb_pointer_t data, gb_pixel_t pixel, tb_size_t count, tb_byte_t alpha)
 {
-    tb_memset(data, (tb_byte_t)pixel, count);
+    // the source color
+    gb_color_t  color = g_pixmap_pal8_palette.colors[pixel & 0xff];
+
+    // blend them, the neighbouring pixels are the same index usually, so we cache the last result
+    tb_byte_t*  p = (tb_byte_t*)data;
+    tb_byte_t*  e = p + count;
+    tb_size_t   last = 256;
+    tb_byte_t   result = 0;
+    for (; p < e; p++)
+    {
+        if (*p != last)
+        {
+            last = *p;
+            result = gb_pixmap_pal8_blend(last, color, alpha);
+        }
+        *p = result;
+    }
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
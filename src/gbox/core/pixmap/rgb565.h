@@ -30,43 +30,6 @@
 #include "prefix.h"
 #include "rgb16.h"
 
-/* //////////////////////////////////////////////////////////////////////////////////////
- * inlines
- */
-
-/* the alpha blend 
- *
- * c: 
- * 0000 0000 0000 0000 rrrr rggg gggb bbbb
- *
- * c | c << 16:
- * rrrr rggg gggb bbbb rrrr rggg gggb bbbb
- *
- * 0x7e0f81f:
- * 0000 0111 1110 0000 1111 1000 0001 1111
- *
- * d = (c | c << 16) & 0x7e0f81f:
- * 0000 0ggg ggg0 0000 rrrr r000 000b bbbb
- *
- * (d & 0xffff) | (d >> 16):
- * 0000 0000 0000 0000 rrrr rggg gggb bbbb
- *
- * (s * a + d * (32 - a)) >> 5 => ((s - d) * a) >> 5 + d
- */
-static __tb_inline__ tb_uint16_t gb_pixmap_rgb565_blend(tb_uint32_t d, tb_uint32_t s, tb_byte_t a)
-{
-    // FIXME: s - d? overflow?
-    s = (s | (s << 16)) & 0x7e0f81f;
-    d = (d | (d << 16)) & 0x7e0f81f;
-    d = ((((s - d) * a) >> 5) + d) & 0x7e0f81f;
-    return (tb_uint16_t)((d & 0xffff) | (d >> 16));
-}
-static __tb_inline__ tb_uint16_t gb_pixmap_rgb565_blend2(tb_uint32_t d, tb_uint32_t s, tb_byte_t a)
-{
-    d = (d | (d << 16)) & 0x7e0f81f;
-    d = ((((s - d) * a) >> 5) + d) & 0x7e0f81f;
-    return (tb_uint16_t)((d & 0xffff) | (d >> 16));
-}
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
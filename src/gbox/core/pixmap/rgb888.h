@@ -66,7 +66,7 @@ static __tb_inline__ gb_pixel_t gb_pixmap_rgb888_pixel(gb_color_t color)
 }
 static __tb_inline__ gb_color_t gb_pixmap_rgb888_color(gb_pixel_t pixel)
 {
-	return gb_pixmap_rgb32_color(pixel & 0x00ffffff);
+	return gb_pixmap_rgb32_color(pixel | 0xff000000);
 }
 static __tb_inline__ tb_void_t gb_pixmap_rgb888_pixel_set_la(tb_pointer_t data, tb_uint32_t pixel, tb_byte_t alpha)
 {
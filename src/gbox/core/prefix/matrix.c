@@ -171,6 +171,7 @@ tb_bool_t gb_matrix_invert(gb_matrix_ref_t matrix)
             mx.sx = gb_invert(matrix->sx);
             mx.tx = gb_div(-matrix->tx, matrix->sx);
         }
+        else mx.tx = -matrix->tx;
 
         // invert it if sy != 1.0
         if (GB_ONE != matrix->sy)
@@ -182,6 +183,7 @@ tb_bool_t gb_matrix_invert(gb_matrix_ref_t matrix)
             mx.sy = gb_invert(matrix->sy);
             mx.ty = gb_div(-matrix->ty, matrix->sy);
         }
+        else mx.ty = -matrix->ty;
     }
     else
     {
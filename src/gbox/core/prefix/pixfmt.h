@@ -186,6 +186,8 @@ typedef enum __gb_pixfmt_t
 ,   GB_PIXFMT_BGRA8888      = 28    | GB_PIXFMT_ALPHA       //!< 32-bit b g r a: 8 8 8 8
 ,   GB_PIXFMT_BGRX8888      = 29                            //!< 32-bit b g r x: 8 8 8 8
 
+,   GB_PIXFMT_PARGB8888     = 30    | GB_PIXFMT_ALPHA       //!< 32-bit premultiplied a r g b: 8 8 8 8, r, g, b <= a, for the layers with alpha
+
 }gb_pixfmt_t;
 
 
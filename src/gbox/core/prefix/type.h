@@ -256,7 +256,7 @@ typedef struct __gb_arc_t
  * @code
     gb_point_t      points[] = {    {x0, y0}, {x1, y1}, {x2, y2}
                                 ,   {x3, y3}, {x4, y4}, {x5, y5}, {x3, y3}};
-    tb_size_t       counts[] = {3, 4, 0};
+    tb_uint32_t     counts[] = {3, 4, 0};
     gb_polygon_t    polygon = {points, counts}; 
  * @endcode
  */
@@ -266,7 +266,7 @@ typedef struct __gb_polygon_t
     gb_point_ref_t      points;
 
     /// the counts
-    tb_uint16_t*        counts;
+    tb_uint32_t*        counts;
 
     /// is convex?
     tb_bool_t           convex;
@@ -244,8 +244,8 @@ tb_void_t gb_tessellator_done(gb_tessellator_ref_t tessellator, gb_polygon_ref_t
         // done
         tb_size_t       index               = 0;
         gb_point_ref_t  points              = polygon->points;
-        tb_uint16_t*    counts              = polygon->counts;
-        tb_uint16_t     contour_counts[2]   = {0, 0};
+        tb_uint32_t*    counts              = polygon->counts;
+        tb_uint32_t     contour_counts[2]   = {0, 0};
         gb_polygon_t    contour             = {tb_null, contour_counts, tb_true};
         while ((contour_counts[0] = *counts++))
         {
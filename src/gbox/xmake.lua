@@ -61,7 +61,7 @@ target("gbox")
 
     -- add the common source files
     add_files("*.c")
-    add_files("core/**.c|device/**.c")
+    add_files("core/**.c|device/**.c|bitmap/decoder/png.c|bitmap/decoder/jpg.c|bitmap/encoder/png.c")
     add_files("platform/*.c")
     add_files("platform/impl/*.c")
     add_files("utils/**.c|impl/tessellator/profiler.c")
@@ -74,6 +74,10 @@ target("gbox")
     if is_option("bitmap") then add_files("core/device/bitmap.c", "core/device/bitmap/**.c") end
     if is_option("skia") then add_files("core/device/skia.cpp") end
 
+    -- add the source files for the bitmap decoder and encoder
+    if is_option("zlib") then add_files("core/bitmap/decoder/png.c", "core/bitmap/encoder/png.c") end
+    if is_option("jpeg") then add_files("core/bitmap/decoder/jpg.c") end
+
     -- add the source files for window
     if is_os("ios") then add_files("platform/ios/window.c") 
     elseif is_os("android") then add_files("platform/android/window.c") 